@@ -26,6 +26,7 @@
 #include <stdbool.h>
 
 #include "interpreter/function.h"
+#include "interpreter/json.h"
 
 #ifdef CHAOS_COMPILER
 #   include "../Chaos.h"
@@ -87,49 +88,75 @@ int defineFunction(
     return 0;
 }
 
+int defineNativeFunction(
+    char *name,
+    enum Type type,
+    char *params_name[],
+    unsigned params_type[],
+    unsigned short params_length
+) {
+    if (params_length > KAOS_NATIVE_FUNCTION_MAX_PARAMETERS)
+        throw_error(E_INCORRECT_FUNCTION_ARGUMENT_COUNT, name);
+
+    if (type != K_BOOL && type != K_NUMBER && type != K_STRING && type != K_VOID)
+        throw_error(E_ILLEGAL_VARIABLE_TYPE_FOR_FUNCTION, getTypeName(type), name);
+
+    startFunctionParameters();
+
+    for (int i = (int) params_length - 1; i >= 0; i--) {
+        if (params_type[i] != K_BOOL && params_type[i] != K_NUMBER && params_type[i] != K_STRING)
+            throw_error(E_ILLEGAL_VARIABLE_TYPE_FOR_VARIABLE, getTypeName(params_type[i]), params_name[i]);
+        addFunctionParameter(params_name[i], params_type[i], K_ANY);
+    }
+
+#ifdef CHAOS_COMPILER
+    startFunction(name, type, K_ANY, "", "", "", true);
+#else
+    startFunction(name, type, K_ANY);
+#endif
+    function_mode->is_native = true;
+    endFunction();
+    return 0;
+}
+
 bool getVariableBool(char *name) {
-    return getSymbolValueBool(name);
+    return getHandleBool(getVariableHandle(name));
 }
 
 long long getVariableInt(char *name) {
-    return getSymbolValueInt(name);
+    return getHandleInt(getVariableHandle(name));
 }
 
 long double getVariableFloat(char *name) {
-    return getSymbolValueFloat(name);
+    return getHandleFloat(getVariableHandle(name));
 }
 
 char* getVariableString(char *name) {
-    return getSymbolValueString(name);
+    return getHandleString(getVariableHandle(name));
 }
 
 bool getVariableBoolByTypeCasting(char *name) {
-    Symbol* symbol = getSymbol(name);
-    return symbolValueByTypeCastingToBool(symbol);
+    return getHandleBoolByTypeCasting(getVariableHandle(name));
 }
 
 long long getVariableIntByTypeCasting(char *name) {
-    Symbol* symbol = getSymbol(name);
-    return symbolValueByTypeCastingToInt(symbol);
+    return getHandleIntByTypeCasting(getVariableHandle(name));
 }
 
 long double getVariableFloatByTypeCasting(char *name) {
-    Symbol* symbol = getSymbol(name);
-    return symbolValueByTypeCastingToFloat(symbol);
+    return getHandleFloatByTypeCasting(getVariableHandle(name));
 }
 
 char* getVariableStringByTypeCasting(char *name) {
-    Symbol* symbol = getSymbol(name);
-    return symbolValueByTypeCastingToString(symbol);
+    return getHandleStringByTypeCasting(getVariableHandle(name));
 }
 
 unsigned long getListLength(char *name) {
-    Symbol* symbol = getSymbol(name);
-    return symbol->children_count;
+    return getHandleLength(getVariableHandle(name));
 }
 
 bool getListElementBool(char *name, long long i) {
-    Symbol* symbol = getListElement(getSymbol(name), i);
+    Symbol* symbol = getListElementHandle(getVariableHandle(name), i);
     if (symbol->value_type != V_BOOL) {
         throw_error(E_UNEXPECTED_VALUE_TYPE, getValueTypeName(symbol->value_type), symbol->name);
     }
@@ -137,7 +164,7 @@ bool getListElementBool(char *name, long long i) {
 }
 
 long long getListElementInt(char *name, long long i) {
-    Symbol* symbol = getListElement(getSymbol(name), i);
+    Symbol* symbol = getListElementHandle(getVariableHandle(name), i);
     if (symbol->value_type != V_INT && symbol->value_type != V_FLOAT) {
         throw_error(E_UNEXPECTED_VALUE_TYPE, getValueTypeName(symbol->value_type), symbol->name);
     }
@@ -145,7 +172,7 @@ long long getListElementInt(char *name, long long i) {
 }
 
 long double getListElementFloat(char *name, long long i) {
-    Symbol* symbol = getListElement(getSymbol(name), i);
+    Symbol* symbol = getListElementHandle(getVariableHandle(name), i);
     if (symbol->value_type != V_INT && symbol->value_type != V_FLOAT) {
         throw_error(E_UNEXPECTED_VALUE_TYPE, getValueTypeName(symbol->value_type), symbol->name);
     }
@@ -153,7 +180,7 @@ long double getListElementFloat(char *name, long long i) {
 }
 
 char* getListElementString(char *name, long long i) {
-    Symbol* symbol = getListElement(getSymbol(name), i);
+    Symbol* symbol = getListElementHandle(getVariableHandle(name), i);
     if (symbol->value_type != V_STRING) {
         throw_error(E_UNEXPECTED_VALUE_TYPE, getValueTypeName(symbol->value_type), symbol->name);
     }
@@ -161,27 +188,27 @@ char* getListElementString(char *name, long long i) {
 }
 
 bool getListElementBoolByTypeCasting(char *name, long long i) {
-    Symbol* symbol = getListElement(getSymbol(name), i);
+    Symbol* symbol = getListElementHandle(getVariableHandle(name), i);
     return symbolValueByTypeCastingToBool(symbol);
 }
 
 long long getListElementIntByTypeCasting(char *name, long long i) {
-    Symbol* symbol = getListElement(getSymbol(name), i);
+    Symbol* symbol = getListElementHandle(getVariableHandle(name), i);
     return symbolValueByTypeCastingToInt(symbol);
 }
 
 long double getListElementFloatByTypeCasting(char *name, long long i) {
-    Symbol* symbol = getListElement(getSymbol(name), i);
+    Symbol* symbol = getListElementHandle(getVariableHandle(name), i);
     return symbolValueByTypeCastingToFloat(symbol);
 }
 
 char* getListElementStringByTypeCasting(char *name, long long i) {
-    Symbol* symbol = getListElement(getSymbol(name), i);
+    Symbol* symbol = getListElementHandle(getVariableHandle(name), i);
     return symbolValueByTypeCastingToString(symbol);
 }
 
 void copyListElement(char *name, long long i) {
-    Symbol* symbol = getListElement(getSymbol(name), i);
+    Symbol* symbol = getListElementHandle(getVariableHandle(name), i);
     createCloneFromSymbol(
         NULL,
         symbol->type,
@@ -191,31 +218,25 @@ void copyListElement(char *name, long long i) {
 }
 
 enum Type getListElementType(char *name, long long i) {
-    Symbol* symbol = getListElement(getSymbol(name), i);
+    Symbol* symbol = getListElementHandle(getVariableHandle(name), i);
     return symbol->type;
 }
 
 enum ValueType getListElementValueType(char *name, long long i) {
-    Symbol* symbol = getListElement(getSymbol(name), i);
+    Symbol* symbol = getListElementHandle(getVariableHandle(name), i);
     return symbol->value_type;
 }
 
 unsigned long getDictLength(char *name) {
-    Symbol* symbol = getSymbol(name);
-    return symbol->children_count;
+    return getHandleLength(getVariableHandle(name));
 }
 
 char* getDictKeyByIndex(char *name, long long i) {
-    Symbol* symbol = getSymbol(name);
-    Symbol* child = symbol->children[i];
-    char* key;
-    key = malloc(1 + strlen(child->key));
-    strcpy(key, child->key);
-    return key;
+    return getHandleKey(getDictElementHandleByIndex(getVariableHandle(name), i));
 }
 
 bool getDictElementBool(char *name, char *key) {
-    Symbol* symbol = getDictElement(getSymbol(name), key);
+    Symbol* symbol = getDictElementHandle(getVariableHandle(name), key);
     if (symbol->value_type != V_BOOL) {
         throw_error(E_UNEXPECTED_VALUE_TYPE, getValueTypeName(symbol->value_type), symbol->name);
     }
@@ -223,7 +244,7 @@ bool getDictElementBool(char *name, char *key) {
 }
 
 long long getDictElementInt(char *name, char *key) {
-    Symbol* symbol = getDictElement(getSymbol(name), key);
+    Symbol* symbol = getDictElementHandle(getVariableHandle(name), key);
     if (symbol->value_type != V_INT && symbol->value_type != V_FLOAT) {
         throw_error(E_UNEXPECTED_VALUE_TYPE, getValueTypeName(symbol->value_type), symbol->name);
     }
@@ -231,7 +252,7 @@ long long getDictElementInt(char *name, char *key) {
 }
 
 long double getDictElementFloat(char *name, char *key) {
-    Symbol* symbol = getDictElement(getSymbol(name), key);
+    Symbol* symbol = getDictElementHandle(getVariableHandle(name), key);
     if (symbol->value_type != V_INT && symbol->value_type != V_FLOAT) {
         throw_error(E_UNEXPECTED_VALUE_TYPE, getValueTypeName(symbol->value_type), symbol->name);
     }
@@ -239,7 +260,7 @@ long double getDictElementFloat(char *name, char *key) {
 }
 
 char* getDictElementString(char *name, char *key) {
-    Symbol* symbol = getDictElement(getSymbol(name), key);
+    Symbol* symbol = getDictElementHandle(getVariableHandle(name), key);
     if (symbol->value_type != V_STRING) {
         throw_error(E_UNEXPECTED_VALUE_TYPE, getValueTypeName(symbol->value_type), symbol->name);
     }
@@ -247,27 +268,27 @@ char* getDictElementString(char *name, char *key) {
 }
 
 bool getDictElementBoolByTypeCasting(char *name, char *key) {
-    Symbol* symbol = getDictElement(getSymbol(name), key);
+    Symbol* symbol = getDictElementHandle(getVariableHandle(name), key);
     return symbolValueByTypeCastingToBool(symbol);
 }
 
 long long getDictElementIntByTypeCasting(char *name, char *key) {
-    Symbol* symbol = getDictElement(getSymbol(name), key);
+    Symbol* symbol = getDictElementHandle(getVariableHandle(name), key);
     return symbolValueByTypeCastingToInt(symbol);
 }
 
 long double getDictElementFloatByTypeCasting(char *name, char *key) {
-    Symbol* symbol = getDictElement(getSymbol(name), key);
+    Symbol* symbol = getDictElementHandle(getVariableHandle(name), key);
     return symbolValueByTypeCastingToFloat(symbol);
 }
 
 char* getDictElementStringByTypeCasting(char *name, char *key) {
-    Symbol* symbol = getDictElement(getSymbol(name), key);
+    Symbol* symbol = getDictElementHandle(getVariableHandle(name), key);
     return symbolValueByTypeCastingToString(symbol);
 }
 
 void copyDictElement(char *name, char *key) {
-    Symbol* symbol = getDictElement(getSymbol(name), key);
+    Symbol* symbol = getDictElementHandle(getVariableHandle(name), key);
     createCloneFromSymbol(
         key,
         symbol->type,
@@ -277,12 +298,12 @@ void copyDictElement(char *name, char *key) {
 }
 
 enum Type getDictElementType(char *name, char *key) {
-    Symbol* symbol = getDictElement(getSymbol(name), key);
+    Symbol* symbol = getDictElementHandle(getVariableHandle(name), key);
     return symbol->type;
 }
 
 enum ValueType getDictElementValueType(char *name, char *key) {
-    Symbol* symbol = getDictElement(getSymbol(name), key);
+    Symbol* symbol = getDictElementHandle(getVariableHandle(name), key);
     return symbol->value_type;
 }
 
@@ -291,9 +312,10 @@ char* dumpVariableToString(char *name, bool pretty, bool escaped, bool double_qu
     bool is_complex = false;
     if (symbol->type == K_LIST || symbol->type == K_DICT)
         is_complex = true;
-    char *encoded = NULL;
-    encoded = encodeSymbolValueToString(symbol, is_complex, pretty, escaped, 0, encoded, double_quotes);
-    return encoded;
+    string_builder sb;
+    string_builder_init(&sb);
+    encodeSymbolValue(symbol, is_complex, pretty, escaped, 0, &sb, double_quotes);
+    return string_builder_finish(&sb);
 }
 
 void returnVariableBool(bool b) {
@@ -399,6 +421,176 @@ void raiseError(char *msg) {
 }
 
 void parseJson(char *json) {
-    injectCode(json, INIT_JSON_PARSE);
-    phase = PROGRAM;
+    returnVariable(parseJsonToSymbol(json));
+}
+
+KaosHandle getParameterHandle(unsigned short i) {
+    if (i >= dynamic_function_parameter_count)
+        return NULL;
+    return dynamic_function_parameters[i];
+}
+
+KaosHandle getVariableHandle(char *name) {
+    return getSymbol(name);
+}
+
+enum Type getHandleType(KaosHandle handle) {
+    return handle->type;
+}
+
+enum Type getHandleSecondaryType(KaosHandle handle) {
+    return handle->secondary_type;
+}
+
+enum ValueType getHandleValueType(KaosHandle handle) {
+    return handle->value_type;
+}
+
+bool getHandleBool(KaosHandle handle) {
+    return _getSymbolValueBool(handle);
+}
+
+long long getHandleInt(KaosHandle handle) {
+    return _getSymbolValueInt(handle);
+}
+
+long double getHandleFloat(KaosHandle handle) {
+    return _getSymbolValueFloat(handle);
+}
+
+char* getHandleString(KaosHandle handle) {
+    return _getSymbolValueString(handle);
+}
+
+bool getHandleBoolByTypeCasting(KaosHandle handle) {
+    return symbolValueByTypeCastingToBool(handle);
+}
+
+long long getHandleIntByTypeCasting(KaosHandle handle) {
+    return symbolValueByTypeCastingToInt(handle);
+}
+
+long double getHandleFloatByTypeCasting(KaosHandle handle) {
+    return symbolValueByTypeCastingToFloat(handle);
+}
+
+char* getHandleStringByTypeCasting(KaosHandle handle) {
+    return symbolValueByTypeCastingToString(handle);
+}
+
+unsigned long getHandleLength(KaosHandle handle) {
+    return handle->children_count;
+}
+
+KaosHandle getListElementHandle(KaosHandle handle, long long i) {
+    return getListElement(handle, i);
+}
+
+KaosHandle getDictElementHandle(KaosHandle handle, char *key) {
+    return getDictElement(handle, key);
+}
+
+KaosHandle getDictElementHandleByIndex(KaosHandle handle, long long i) {
+    return handle->children[i];
+}
+
+char* getHandleKey(KaosHandle handle) {
+    char* key;
+    key = malloc(1 + strlen(handle->key));
+    strcpy(key, handle->key);
+    return key;
+}
+
+void copyHandle(KaosHandle handle, char *key) {
+    createCloneFromSymbol(
+        key,
+        handle->type,
+        handle,
+        handle->secondary_type
+    );
+}
+
+unsigned long copyListToIntBuffer(KaosHandle handle, long long *buffer, unsigned long length) {
+    if (handle->type != K_LIST)
+        throw_error(E_NOT_A_LIST, handle->name);
+    if (length > handle->children_count)
+        length = handle->children_count;
+
+    for (unsigned long i = 0; i < length; i++) {
+        Symbol* symbol = handle->children[i];
+        if (symbol->value_type == V_INT)
+            buffer[i] = symbol->value.i;
+        else if (symbol->value_type == V_FLOAT)
+            buffer[i] = (long long) symbol->value.f;
+        else
+            throw_error(E_UNEXPECTED_VALUE_TYPE, getValueTypeName(symbol->value_type), symbol->name);
+    }
+    return length;
+}
+
+unsigned long copyListToFloatBuffer(KaosHandle handle, double *buffer, unsigned long length) {
+    if (handle->type != K_LIST)
+        throw_error(E_NOT_A_LIST, handle->name);
+    if (length > handle->children_count)
+        length = handle->children_count;
+
+    for (unsigned long i = 0; i < length; i++) {
+        Symbol* symbol = handle->children[i];
+        if (symbol->value_type == V_FLOAT)
+            buffer[i] = (double) symbol->value.f;
+        else if (symbol->value_type == V_INT)
+            buffer[i] = (double) symbol->value.i;
+        else
+            throw_error(E_UNEXPECTED_VALUE_TYPE, getValueTypeName(symbol->value_type), symbol->name);
+    }
+    return length;
+}
+
+unsigned long copyListToStringBuffer(KaosHandle handle, char **buffer, unsigned long length) {
+    if (handle->type != K_LIST)
+        throw_error(E_NOT_A_LIST, handle->name);
+    if (length > handle->children_count)
+        length = handle->children_count;
+
+    for (unsigned long i = 0; i < length; i++) {
+        Symbol* symbol = handle->children[i];
+        if (symbol->value_type != V_STRING)
+            throw_error(E_UNEXPECTED_VALUE_TYPE, getValueTypeName(symbol->value_type), symbol->name);
+        buffer[i] = symbol->value.s;
+    }
+    return length;
+}
+
+void returnListFromIntBuffer(long long *buffer, unsigned long length, enum Type type) {
+    Symbol* list = addSymbolListWithCapacity(NULL, length);
+    union Value value;
+    for (unsigned long i = 0; i < length; i++) {
+        value.i = buffer[i];
+        appendComplexChild(list, K_NUMBER, value, V_INT);
+    }
+    list->secondary_type = type;
+    returnVariable(list);
+}
+
+void returnListFromFloatBuffer(double *buffer, unsigned long length, enum Type type) {
+    Symbol* list = addSymbolListWithCapacity(NULL, length);
+    union Value value;
+    for (unsigned long i = 0; i < length; i++) {
+        value.f = buffer[i];
+        appendComplexChild(list, K_NUMBER, value, V_FLOAT);
+    }
+    list->secondary_type = type;
+    returnVariable(list);
+}
+
+void returnListFromStringBuffer(char **buffer, unsigned long length, enum Type type) {
+    Symbol* list = addSymbolListWithCapacity(NULL, length);
+    union Value value;
+    for (unsigned long i = 0; i < length; i++) {
+        value.s = malloc(1 + strlen(buffer[i]));
+        strcpy(value.s, buffer[i]);
+        appendComplexChild(list, K_STRING, value, V_STRING);
+    }
+    list->secondary_type = type;
+    returnVariable(list);
 }
@@ -40,6 +40,17 @@ typedef struct KaosValue {
     long double f;
 } KaosValue;
 
+#define KAOS_API_VERSION 2
+
+// Opaque reference to a Chaos value, valid until the spell function returns
+typedef struct Symbol* KaosHandle;
+
+// Native spell functions receive their arguments by position and return their result directly.
+// Numbers fill both `i` and `f`, strings are borrowed for the duration of the call.
+// A returned number is read from `f` and kept as an integer when it is whole. A returned string must be heap allocated, the interpreter takes its ownership.
+#define KAOS_NATIVE_FUNCTION_MAX_PARAMETERS 16
+typedef KaosValue (*KaosNativeFunction)(KaosValue args[], unsigned short args_length);
+
 int defineFunction(
     char *name,
     enum Type type,
@@ -107,6 +118,38 @@ enum ValueType getValueType(char *name);
 enum Role getRole(char *name);
 void raiseError(char *msg);
 void parseJson(char *json);
+KaosHandle getParameterHandle(unsigned short i);
+KaosHandle getVariableHandle(char *name);
+enum Type getHandleType(KaosHandle handle);
+enum Type getHandleSecondaryType(KaosHandle handle);
+enum ValueType getHandleValueType(KaosHandle handle);
+bool getHandleBool(KaosHandle handle);
+long long getHandleInt(KaosHandle handle);
+long double getHandleFloat(KaosHandle handle);
+char* getHandleString(KaosHandle handle);
+bool getHandleBoolByTypeCasting(KaosHandle handle);
+long long getHandleIntByTypeCasting(KaosHandle handle);
+long double getHandleFloatByTypeCasting(KaosHandle handle);
+char* getHandleStringByTypeCasting(KaosHandle handle);
+unsigned long getHandleLength(KaosHandle handle);
+KaosHandle getListElementHandle(KaosHandle handle, long long i);
+KaosHandle getDictElementHandle(KaosHandle handle, char *key);
+KaosHandle getDictElementHandleByIndex(KaosHandle handle, long long i);
+char* getHandleKey(KaosHandle handle);
+void copyHandle(KaosHandle handle, char *key);
+unsigned long copyListToIntBuffer(KaosHandle handle, long long *buffer, unsigned long length);
+unsigned long copyListToFloatBuffer(KaosHandle handle, double *buffer, unsigned long length);
+unsigned long copyListToStringBuffer(KaosHandle handle, char **buffer, unsigned long length);
+void returnListFromIntBuffer(long long *buffer, unsigned long length, enum Type type);
+void returnListFromFloatBuffer(double *buffer, unsigned long length, enum Type type);
+void returnListFromStringBuffer(char **buffer, unsigned long length, enum Type type);
+int defineNativeFunction(
+    char *name,
+    enum Type type,
+    char *params_name[],
+    unsigned params_type[],
+    unsigned short params_length
+);
 
 struct Kaos {
     int (*defineFunction)(
@@ -176,6 +219,45 @@ struct Kaos {
     enum Role (*getRole)(char *name);
     void (*raiseError)(char *msg);
     void (*parseJson)(char *json);
+
+    // Kaos API v2, members are only appended so that spells built against v1 keep loading
+    KaosHandle (*getParameterHandle)(unsigned short i);
+    KaosHandle (*getVariableHandle)(char *name);
+    enum Type (*getHandleType)(KaosHandle handle);
+    enum Type (*getHandleSecondaryType)(KaosHandle handle);
+    enum ValueType (*getHandleValueType)(KaosHandle handle);
+    bool (*getHandleBool)(KaosHandle handle);
+    long long (*getHandleInt)(KaosHandle handle);
+    long double (*getHandleFloat)(KaosHandle handle);
+    char* (*getHandleString)(KaosHandle handle);
+    bool (*getHandleBoolByTypeCasting)(KaosHandle handle);
+    long long (*getHandleIntByTypeCasting)(KaosHandle handle);
+    long double (*getHandleFloatByTypeCasting)(KaosHandle handle);
+    char* (*getHandleStringByTypeCasting)(KaosHandle handle);
+    unsigned long (*getHandleLength)(KaosHandle handle);
+    KaosHandle (*getListElementHandle)(KaosHandle handle, long long i);
+    KaosHandle (*getDictElementHandle)(KaosHandle handle, char *key);
+    KaosHandle (*getDictElementHandleByIndex)(KaosHandle handle, long long i);
+    char* (*getHandleKey)(KaosHandle handle);
+    void (*copyHandle)(KaosHandle handle, char *key);
+
+    // Bulk transfer between lists and C buffers. The strings copied into a buffer are borrowed,
+    // they stay valid until the spell function returns.
+    unsigned long (*copyListToIntBuffer)(KaosHandle handle, long long *buffer, unsigned long length);
+    unsigned long (*copyListToFloatBuffer)(KaosHandle handle, double *buffer, unsigned long length);
+    unsigned long (*copyListToStringBuffer)(KaosHandle handle, char **buffer, unsigned long length);
+    void (*returnListFromIntBuffer)(long long *buffer, unsigned long length, enum Type type);
+    void (*returnListFromFloatBuffer)(double *buffer, unsigned long length, enum Type type);
+    void (*returnListFromStringBuffer)(char **buffer, unsigned long length, enum Type type);
+
+    // Only scalar parameters, no optional parameters
+    int (*defineNativeFunction)(
+        char *name,
+        enum Type type,
+        char *params_name[],
+        unsigned params_type[],
+        unsigned short params_length
+    );
 };
 
 struct Kaos kaos;
@@ -21,6 +21,7 @@
  */
 
 #include "ast.h"
+#include "cache.h"
 
 unsigned long long ast_node_id_counter = 0;
 bool enable_branch_out = false;
@@ -58,6 +59,10 @@ ASTNode* addASTNodeBase(enum ASTNodeType node_type, int lineno, char *strings[],
             ast_node->lineno
         );
 
+#ifndef CHAOS_COMPILER
+    recordASTCacheNode(ast_node);
+#endif
+
     return ast_node;
 }
 
@@ -114,6 +119,8 @@ ASTNode* addASTNodeBranch(enum ASTNodeType node_type, int lineno, ASTNode* l_nod
 ASTNode* addASTNodeAssign(enum ASTNodeType node_type, int lineno, char *strings[], size_t strings_size, ASTNode* node) {
     ASTNode* ast_node = addASTNodeBase(node_type, lineno, strings, strings_size, node->value, V_VOID);
     ast_node->right = node;
+    if (node->value_type == V_STRING)
+        ast_node->value_alias = node;
     return ast_node;
 }
 
@@ -159,30 +166,63 @@ ASTNode* free_node(ASTNode* ast_node) {
         return ast_node;
     }
 
-    free_node(ast_node->depend);
-    free_node(ast_node->right);
-    free_node(ast_node->left);
-    free_node(ast_node->child);
+    // Post-order walk on a heap allocated stack: depend, right, left and child
+    // subtrees are freed before the node itself, then the walk continues with next
+    ast_free_stack_item* stack = NULL;
+    size_t capacity = 0;
+    size_t size = 0;
 
-    if (debug_enabled)
-        printf(
-            "(Free)\t\tASTNode: {id: %llu, node_type: %s, module: %s, string_size: %zu}\n",
-            ast_node->id,
-            getAstNodeTypeName(ast_node->node_type),
-            ast_node->module,
-            ast_node->strings_size
-        );
+    pushASTFreeStack(&stack, &capacity, &size, ast_node, false);
 
-    ASTNode* next_node = ast_node->next;
+    while (size > 0) {
+        ast_free_stack_item item = stack[--size];
+        ast_node = item.ast_node;
 
-    for (size_t i = 0; i < ast_node->strings_size; ++i) {
-        free(ast_node->strings[i]);
+        if (!item.children_freed) {
+            pushASTFreeStack(&stack, &capacity, &size, ast_node->next, false);
+            pushASTFreeStack(&stack, &capacity, &size, ast_node, true);
+            pushASTFreeStack(&stack, &capacity, &size, ast_node->child, false);
+            pushASTFreeStack(&stack, &capacity, &size, ast_node->left, false);
+            pushASTFreeStack(&stack, &capacity, &size, ast_node->right, false);
+            pushASTFreeStack(&stack, &capacity, &size, ast_node->depend, false);
+            continue;
+        }
+
+        if (debug_enabled)
+            printf(
+                "(Free)\t\tASTNode: {id: %llu, node_type: %s, module: %s, string_size: %zu}\n",
+                ast_node->id,
+                getAstNodeTypeName(ast_node->node_type),
+                ast_node->module,
+                ast_node->strings_size
+            );
+
+        for (size_t i = 0; i < ast_node->strings_size; ++i) {
+            free(ast_node->strings[i]);
+        }
+        if (ast_node->value_type == V_STRING) free(ast_node->value.s);
+        free(ast_node->module);
+        free(ast_node->transpiled);
+        free(ast_node);
+    }
+
+    free(stack);
+    return NULL;
+}
+
+void pushASTFreeStack(ast_free_stack_item** stack, size_t* capacity, size_t* size, ASTNode* ast_node, bool children_freed) {
+    if (ast_node == NULL) {
+        return;
     }
-    if (ast_node->value_type == V_STRING) free(ast_node->value.s);
-    free(ast_node->module);
-    free(ast_node->transpiled);
-    free(ast_node);
-    return free_node(next_node);
+
+    if (*capacity == *size) {
+        *capacity = *capacity == 0 ? 64 : *capacity * 2;
+        *stack = (ast_free_stack_item*)realloc(*stack, *capacity * sizeof(ast_free_stack_item));
+    }
+
+    (*stack)[*size].ast_node = ast_node;
+    (*stack)[*size].children_freed = children_freed;
+    (*size)++;
 }
 
 void setASTNodeTranspiled(ASTNode* ast_node, char* transpiled) {
@@ -467,7 +507,6 @@ char *ast_node_type_names[] = {
     "AST_DECISION_MAKE_DEFAULT_BREAK",
     "AST_DECISION_MAKE_DEFAULT_CONTINUE",
     "AST_DECISION_MAKE_DEFAULT_RETURN",
-    "AST_JSON_PARSER",
 };
 
 char* getAstNodeTypeName(unsigned i) {
@@ -310,9 +310,10 @@ enum ASTNodeType {
     AST_DECISION_MAKE_DEFAULT_BREAK,
     AST_DECISION_MAKE_DEFAULT_CONTINUE,
     AST_DECISION_MAKE_DEFAULT_RETURN,
-    AST_JSON_PARSER,
 };
 
+#define __KAOS_AST_NODE_TYPE_COUNT__ (AST_DECISION_MAKE_DEFAULT_RETURN + 1)
+
 typedef struct ASTNode {
     unsigned long long id;
     enum ASTNodeType node_type;
@@ -328,6 +329,8 @@ typedef struct ASTNode {
     bool dont_transpile;
     enum ValueType value_type;
     union Value value;
+    // The string node whose value addASTNodeAssign handed to this node without copying it
+    struct ASTNode* value_alias;
     size_t strings_size;
     char *strings[];
 } ASTNode;
@@ -338,6 +341,11 @@ ASTNode* ast_node_cursor_backup;
 ASTNode* ast_interactive_cursor;
 bool stop_ast_evaluation;
 
+typedef struct ast_free_stack_item {
+    ASTNode* ast_node;
+    bool children_freed;
+} ast_free_stack_item;
+
 ASTNode* addASTNodeBase(enum ASTNodeType node_type, int lineno, char *strings[], size_t strings_size, union Value value, enum ValueType value_type);
 ASTNode* addASTNode(enum ASTNodeType node_type, int lineno, char *strings[], size_t strings_size);
 ASTNode* addASTNodeBool(enum ASTNodeType node_type, int lineno, char *strings[], size_t strings_size, bool b, ASTNode* node);
@@ -351,6 +359,7 @@ void ASTNodeNext(ASTNode* ast_node);
 void ASTBranchOut();
 void ASTMergeBack();
 ASTNode* free_node(ASTNode* ast_node);
+void pushASTFreeStack(ast_free_stack_item** stack, size_t* capacity, size_t* size, ASTNode* ast_node, bool children_freed);
 void setASTNodeTranspiled(ASTNode* ast_node, char* transpiled);
 char* getAstNodeTypeName(unsigned i);
 
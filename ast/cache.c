@@ -0,0 +1,536 @@
+/*
+ * Description: Precompiled AST cache of the Chaos Programming Language's source
+ *
+ * Copyright (c) 2019-2020 Chaos Language Development Authority <info@chaos-lang.org>
+ *
+ * License: GNU General Public License v3.0
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors: M. Mert Yildiran <me@mertyildiran.com>
+ */
+
+#include "cache.h"
+
+#ifndef CHAOS_COMPILER
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+#include <direct.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include "../utilities/language.h"
+
+extern unsigned long long ast_node_id_counter;
+extern bool enable_branch_out;
+extern unsigned long long loops_inside_function_counter;
+
+static ast_node_array ast_cache_nodes;
+static bool ast_cache_recording = false;
+static unsigned long long ast_cache_first_id;
+static ASTNode* ast_cache_previous_cursor;
+static ASTNode* ast_cache_previous_cursor_backup;
+static ASTNode* ast_cache_previous_next;
+
+// FNV-1a, the hash of a sequence of blocks is computed by passing the previous hash as the seed
+static unsigned long long hashASTCache(const void *data, size_t length, unsigned long long hash) {
+    const unsigned char *bytes = (const unsigned char*) data;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static char* getASTCacheDirectory() {
+    char *env = getenv("CHAOS_CACHE_DIR");
+    char *directory = NULL;
+    if (env != NULL && env[0] != '\0')
+        return snprintf_concat_string(directory, "%s", env);
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+    env = getenv("LOCALAPPDATA");
+    if (env != NULL && env[0] != '\0')
+        return snprintf_concat_string(directory, "%s\\" __KAOS_AST_CACHE_DIRECTORY__, env);
+#else
+    env = getenv("XDG_CACHE_HOME");
+    if (env != NULL && env[0] != '\0')
+        return snprintf_concat_string(directory, "%s/" __KAOS_AST_CACHE_DIRECTORY__, env);
+    env = getenv("HOME");
+    if (env != NULL && env[0] != '\0')
+        return snprintf_concat_string(directory, "%s/.cache/" __KAOS_AST_CACHE_DIRECTORY__, env);
+#endif
+    return NULL;
+}
+
+// The cache is keyed by the content alone, the module path of the nodes is set at load time
+static char* getASTCachePath(char *directory, unsigned long long hash) {
+    char name[__KAOS_ITOA_BUFFER_LENGTH__];
+    sprintf(name, "%016llx.%s", hash, __KAOS_AST_CACHE_EXTENSION__);
+    char *path = snprintf_concat_string(NULL, "%s", directory);
+    path = strcat_ext(path, __KAOS_PATH_SEPARATOR__);
+    return strcat_ext(path, name);
+}
+
+static void makeASTCacheDirectory(char *directory) {
+    for (char *c = directory + 1; *c != '\0'; c++) {
+        if (*c != __KAOS_PATH_SEPARATOR_ASCII__)
+            continue;
+        *c = '\0';
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+        _mkdir(directory);
+#else
+        mkdir(directory, 0700);
+#endif
+        *c = __KAOS_PATH_SEPARATOR_ASCII__;
+    }
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+    _mkdir(directory);
+#else
+    mkdir(directory, 0700);
+#endif
+}
+
+static void* mapASTCacheFile(char *path, size_t *size) {
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long length = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    void *map = NULL;
+    if (length > 0) {
+        map = malloc(length);
+        if (fread(map, 1, length, f) != (size_t) length) {
+            free(map);
+            map = NULL;
+        }
+    }
+    fclose(f);
+    *size = (size_t) length;
+    return map;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+    void *map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return NULL;
+    *size = (size_t) st.st_size;
+    return map;
+#endif
+}
+
+static void unmapASTCacheFile(void *map, size_t size) {
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+    (void) size;
+    free(map);
+#else
+    munmap(map, size);
+#endif
+}
+
+static bool isASTCacheLinkValid(unsigned long long link, unsigned long long node_count) {
+    return link <= node_count;
+}
+
+static bool isASTCacheStringValid(unsigned long long offset, unsigned long long strings_length) {
+    return offset == 0 || offset <= strings_length;
+}
+
+// Checks every index and offset before a single node is allocated,
+// a truncated or stale file is simply ignored
+static bool validateASTCache(ASTCacheHeader* header, size_t size, unsigned long long hash, size_t length) {
+    if (size < sizeof(ASTCacheHeader))
+        return false;
+    if (
+        memcmp(header->magic, __KAOS_AST_CACHE_MAGIC__, sizeof(__KAOS_AST_CACHE_MAGIC__)) != 0 ||
+        header->format_version != __KAOS_AST_CACHE_FORMAT_VERSION__ ||
+        header->version_major != __KAOS_VERSION_MAJOR__ ||
+        header->version_minor != __KAOS_VERSION_MINOR__ ||
+        header->version_patchlevel != __KAOS_VERSION_PATCHLEVEL__ ||
+        header->node_type_count != __KAOS_AST_NODE_TYPE_COUNT__ ||
+        header->node_record_size != sizeof(ASTCacheNode) ||
+        header->source_hash != hash ||
+        header->source_length != length
+    )
+        return false;
+
+    unsigned long long node_count = header->node_count;
+    unsigned long long string_count = header->string_count;
+    unsigned long long strings_length = header->strings_length;
+    if (
+        node_count > size / sizeof(ASTCacheNode) ||
+        string_count > size / sizeof(unsigned) ||
+        sizeof(ASTCacheHeader) + node_count * sizeof(ASTCacheNode) + string_count * sizeof(unsigned) + strings_length != size
+    )
+        return false;
+
+    if (hashASTCache(header + 1, size - sizeof(ASTCacheHeader), __KAOS_AST_CACHE_HASH_SEED__) != header->payload_hash)
+        return false;
+
+    ASTCacheNode* records = (ASTCacheNode*) (header + 1);
+    unsigned* offsets = (unsigned*) (records + node_count);
+    char *pool = (char*) (offsets + string_count);
+    if (strings_length > 0 && pool[strings_length - 1] != '\0')
+        return false;
+
+    for (unsigned long long i = 0; i < string_count; i++) {
+        if (!isASTCacheStringValid(offsets[i], strings_length))
+            return false;
+    }
+
+    for (unsigned long long i = 0; i < node_count; i++) {
+        ASTCacheNode* record = &records[i];
+        if (
+            !isASTCacheLinkValid(record->next, node_count) ||
+            !isASTCacheLinkValid(record->left, node_count) ||
+            !isASTCacheLinkValid(record->right, node_count) ||
+            !isASTCacheLinkValid(record->child, node_count) ||
+            !isASTCacheLinkValid(record->depend, node_count) ||
+            !isASTCacheLinkValid(record->value_alias, node_count) ||
+            !isASTCacheStringValid(record->value_string, strings_length) ||
+            record->strings_start > string_count ||
+            record->strings_size > string_count - record->strings_start ||
+            record->node_type < 0 || record->node_type >= __KAOS_AST_NODE_TYPE_COUNT__
+        )
+            return false;
+    }
+
+    unsigned long long states[] = {header->first, header->cursor, header->cursor_backup};
+    for (unsigned i = 0; i < 3; i++) {
+        if (states[i] != __KAOS_AST_CACHE_NONE__ && !isASTCacheLinkValid(states[i], node_count))
+            return false;
+    }
+    return true;
+}
+
+static char* copyASTCacheString(char *pool, unsigned long long offset) {
+    if (offset == 0)
+        return NULL;
+    char *s = pool + offset - 1;
+    char *copy = malloc(strlen(s) + 1);
+    strcpy(copy, s);
+    return copy;
+}
+
+static ASTNode* getASTCacheLink(ASTNode** nodes, unsigned long long link) {
+    return link == 0 ? NULL : nodes[link - 1];
+}
+
+static void buildASTFromCache(ASTCacheHeader* header) {
+    ASTCacheNode* records = (ASTCacheNode*) (header + 1);
+    unsigned* offsets = (unsigned*) (records + header->node_count);
+    char *pool = (char*) (offsets + header->string_count);
+    char *module = module_path_stack.arr[module_path_stack.size - 1];
+
+    ASTNode** nodes = malloc((header->node_count + 1) * sizeof(ASTNode*));
+    for (unsigned long long i = 0; i < header->node_count; i++) {
+        ASTCacheNode* record = &records[i];
+        ASTNode* ast_node = (struct ASTNode*)calloc(1, sizeof(ASTNode) + record->strings_size * sizeof *ast_node->strings);
+        ast_node_id_counter++;
+
+        ast_node->id = ast_node_id_counter;
+        ast_node->node_type = record->node_type;
+        ast_node->lineno = record->lineno;
+        ast_node->value = record->value;
+        ast_node->value_type = record->value_type;
+        ast_node->module = malloc(1 + strlen(module));
+        strcpy(ast_node->module, module);
+
+        ast_node->strings_size = record->strings_size;
+        for (unsigned long long j = 0; j < record->strings_size; j++) {
+            ast_node->strings[j] = copyASTCacheString(pool, offsets[record->strings_start + j]);
+        }
+        if (ast_node->value_type == V_STRING)
+            ast_node->value.s = copyASTCacheString(pool, record->value_string);
+
+        nodes[i] = ast_node;
+    }
+
+    for (unsigned long long i = 0; i < header->node_count; i++) {
+        ASTCacheNode* record = &records[i];
+        ASTNode* ast_node = nodes[i];
+        ast_node->next = getASTCacheLink(nodes, record->next);
+        ast_node->left = getASTCacheLink(nodes, record->left);
+        ast_node->right = getASTCacheLink(nodes, record->right);
+        ast_node->child = getASTCacheLink(nodes, record->child);
+        ast_node->depend = getASTCacheLink(nodes, record->depend);
+        // The parser hands the string of a child node to its parent without copying it
+        if (record->value_alias != 0) {
+            ast_node->value_alias = getASTCacheLink(nodes, record->value_alias);
+            ast_node->value.s = ast_node->value_alias->value.s;
+        }
+    }
+
+    // Splice the nodes in the way ASTNodeNext, ASTBranchOut and ASTMergeBack left them
+    if (header->first != __KAOS_AST_CACHE_NONE__) {
+        if (ast_node_cursor == NULL) {
+            ast_root_node = getASTCacheLink(nodes, header->first);
+        } else {
+            ast_node_cursor->next = getASTCacheLink(nodes, header->first);
+        }
+    }
+    if (header->cursor != __KAOS_AST_CACHE_NONE__)
+        ast_node_cursor = getASTCacheLink(nodes, header->cursor);
+    if (header->cursor_backup != __KAOS_AST_CACHE_NONE__)
+        ast_node_cursor_backup = getASTCacheLink(nodes, header->cursor_backup);
+
+    free(nodes);
+}
+
+bool loadASTCache(char *code, size_t length) {
+    if (ast_cache_disabled || code == NULL)
+        return false;
+
+    char *directory = getASTCacheDirectory();
+    if (directory == NULL)
+        return false;
+
+    unsigned long long hash = hashASTCache(code, length, __KAOS_AST_CACHE_HASH_SEED__);
+    char *path = getASTCachePath(directory, hash);
+    free(directory);
+
+    size_t size = 0;
+    void *map = mapASTCacheFile(path, &size);
+    free(path);
+    if (map == NULL)
+        return false;
+
+    bool loaded = validateASTCache((ASTCacheHeader*) map, size, hash, length);
+    if (loaded) {
+        buildASTFromCache((ASTCacheHeader*) map);
+        phase = PROGRAM;
+    }
+
+    unmapASTCacheFile(map, size);
+    return loaded;
+}
+
+void startASTCacheRecording() {
+    if (ast_cache_disabled || enable_branch_out || loops_inside_function_counter != 0)
+        return;
+
+    ast_cache_recording = true;
+    ast_cache_nodes.size = 0;
+    ast_cache_first_id = ast_node_id_counter + 1;
+    ast_cache_previous_cursor = ast_node_cursor;
+    ast_cache_previous_cursor_backup = ast_node_cursor_backup;
+    ast_cache_previous_next = ast_node_cursor == NULL ? ast_root_node : ast_node_cursor->next;
+}
+
+void recordASTCacheNode(ASTNode* ast_node) {
+    if (!ast_cache_recording)
+        return;
+
+    if (ast_cache_nodes.capacity == ast_cache_nodes.size) {
+        ast_cache_nodes.capacity = ast_cache_nodes.capacity == 0 ? 256 : ast_cache_nodes.capacity * 2;
+        ast_cache_nodes.arr = realloc(ast_cache_nodes.arr, ast_cache_nodes.capacity * sizeof(ASTNode*));
+    }
+    ast_cache_nodes.arr[ast_cache_nodes.size++] = ast_node;
+}
+
+// Returns the link of a recorded node, or NONE if the node is not a part of this parse
+static unsigned long long getASTCacheIndex(ASTNode* ast_node) {
+    if (ast_node == NULL)
+        return 0;
+    unsigned long long i = ast_node->id - ast_cache_first_id;
+    if (ast_node->id < ast_cache_first_id || i >= ast_cache_nodes.size || ast_cache_nodes.arr[i] != ast_node)
+        return __KAOS_AST_CACHE_NONE__;
+    return i + 1;
+}
+
+static bool setASTCacheLink(unsigned *link, ASTNode* ast_node) {
+    unsigned long long index = getASTCacheIndex(ast_node);
+    *link = (unsigned) index;
+    return index != __KAOS_AST_CACHE_NONE__;
+}
+
+static unsigned long long getASTCacheState(ASTNode* current, ASTNode* previous) {
+    if (current == previous)
+        return __KAOS_AST_CACHE_NONE__;
+    unsigned long long link = getASTCacheIndex(current);
+    // A state that points to a node of an earlier parse cannot be replayed
+    return link == __KAOS_AST_CACHE_NONE__ ? __KAOS_AST_CACHE_NONE__ - 1 : link;
+}
+
+static unsigned long long appendASTCacheString(string_builder *pool, char *s) {
+    if (s == NULL)
+        return 0;
+    unsigned long long offset = pool->size + 1;
+    string_builder_append_length(pool, s, strlen(s) + 1);
+    return offset;
+}
+
+static void writeASTCache(char *path, ASTCacheHeader* header, ASTCacheNode* records, unsigned* offsets, string_builder* pool) {
+    char suffix[__KAOS_ITOA_BUFFER_LENGTH__];
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+    sprintf(suffix, ".%d.tmp", _getpid());
+#else
+    sprintf(suffix, ".%d.tmp", (int) getpid());
+#endif
+    char *temp_path = snprintf_concat_string(NULL, "%s", path);
+    temp_path = strcat_ext(temp_path, suffix);
+
+    FILE *f = fopen(temp_path, "wb");
+    if (f == NULL) {
+        free(temp_path);
+        return;
+    }
+    bool written = fwrite(header, sizeof(ASTCacheHeader), 1, f) == 1;
+    if (header->node_count > 0)
+        written = written && fwrite(records, sizeof(ASTCacheNode), header->node_count, f) == header->node_count;
+    if (header->string_count > 0)
+        written = written && fwrite(offsets, sizeof(unsigned), header->string_count, f) == header->string_count;
+    if (header->strings_length > 0)
+        written = written && fwrite(pool->arr, 1, header->strings_length, f) == header->strings_length;
+    written = fclose(f) == 0 && written;
+
+    // Readers only ever see a complete file
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+    if (written)
+        remove(path);
+#endif
+    if (!written || rename(temp_path, path) != 0)
+        remove(temp_path);
+    free(temp_path);
+}
+
+void saveASTCache(char *code, size_t length) {
+    if (!ast_cache_recording)
+        return;
+    ast_cache_recording = false;
+
+    if (
+        code == NULL ||
+        enable_branch_out ||
+        loops_inside_function_counter != 0 ||
+        ast_cache_nodes.size > __KAOS_AST_CACHE_LIMIT__
+    )
+        return;
+
+    ASTCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, __KAOS_AST_CACHE_MAGIC__, sizeof(__KAOS_AST_CACHE_MAGIC__));
+    header.format_version = __KAOS_AST_CACHE_FORMAT_VERSION__;
+    header.version_major = __KAOS_VERSION_MAJOR__;
+    header.version_minor = __KAOS_VERSION_MINOR__;
+    header.version_patchlevel = __KAOS_VERSION_PATCHLEVEL__;
+    header.node_type_count = __KAOS_AST_NODE_TYPE_COUNT__;
+    header.node_record_size = sizeof(ASTCacheNode);
+    header.source_length = length;
+    header.source_hash = hashASTCache(code, header.source_length, __KAOS_AST_CACHE_HASH_SEED__);
+    header.node_count = ast_cache_nodes.size;
+
+    ASTNode* first = ast_cache_previous_cursor == NULL ? ast_root_node : ast_cache_previous_cursor->next;
+    header.first = getASTCacheState(first, ast_cache_previous_next);
+    header.cursor = getASTCacheState(ast_node_cursor, ast_cache_previous_cursor);
+    header.cursor_backup = getASTCacheState(ast_node_cursor_backup, ast_cache_previous_cursor_backup);
+    if (
+        header.first == __KAOS_AST_CACHE_NONE__ - 1 ||
+        header.cursor == __KAOS_AST_CACHE_NONE__ - 1 ||
+        header.cursor_backup == __KAOS_AST_CACHE_NONE__ - 1
+    )
+        return;
+
+    char *directory = getASTCacheDirectory();
+    if (directory == NULL)
+        return;
+
+    ASTCacheNode* records = calloc(ast_cache_nodes.size + 1, sizeof(ASTCacheNode));
+    unsigned* offsets = NULL;
+    unsigned long long string_count = 0;
+    unsigned long long string_capacity = 0;
+    string_builder pool;
+    string_builder_init(&pool);
+
+    bool cacheable = true;
+    for (unsigned long long i = 0; i < ast_cache_nodes.size && cacheable; i++) {
+        ASTNode* ast_node = ast_cache_nodes.arr[i];
+        ASTCacheNode* record = &records[i];
+        cacheable = (
+            setASTCacheLink(&record->next, ast_node->next) &&
+            setASTCacheLink(&record->left, ast_node->left) &&
+            setASTCacheLink(&record->right, ast_node->right) &&
+            setASTCacheLink(&record->child, ast_node->child) &&
+            setASTCacheLink(&record->depend, ast_node->depend) &&
+            setASTCacheLink(&record->value_alias, ast_node->value_alias)
+        );
+
+        record->node_type = ast_node->node_type;
+        record->lineno = ast_node->lineno;
+        record->value_type = ast_node->value_type;
+        record->value = ast_node->value;
+
+        record->strings_start = string_count;
+        record->strings_size = ast_node->strings_size;
+        while (string_capacity < string_count + ast_node->strings_size) {
+            string_capacity = string_capacity == 0 ? 256 : string_capacity * 2;
+            offsets = realloc(offsets, string_capacity * sizeof(unsigned));
+        }
+        for (size_t j = 0; j < ast_node->strings_size; j++) {
+            offsets[string_count++] = appendASTCacheString(&pool, ast_node->strings[j]);
+        }
+
+        if (ast_node->value_type == V_STRING) {
+            record->value_string = appendASTCacheString(&pool, ast_node->value.s);
+            memset(&record->value, 0, sizeof(record->value));
+        } else if (ast_node->value_alias != NULL) {
+            memset(&record->value, 0, sizeof(record->value));
+        }
+    }
+
+    if (string_count > __KAOS_AST_CACHE_LIMIT__ || pool.size > __KAOS_AST_CACHE_LIMIT__)
+        cacheable = false;
+
+    if (cacheable) {
+        header.string_count = string_count;
+        header.strings_length = pool.size;
+        header.payload_hash = hashASTCache(records, header.node_count * sizeof(ASTCacheNode), __KAOS_AST_CACHE_HASH_SEED__);
+        header.payload_hash = hashASTCache(offsets, header.string_count * sizeof(unsigned), header.payload_hash);
+        header.payload_hash = hashASTCache(pool.arr, header.strings_length, header.payload_hash);
+
+        char *path = getASTCachePath(directory, header.source_hash);
+        makeASTCacheDirectory(directory);
+        writeASTCache(path, &header, records, offsets, &pool);
+        free(path);
+    }
+
+    free(records);
+    free(offsets);
+    free(pool.arr);
+    free(directory);
+}
+
+void freeASTCache() {
+    free(ast_cache_nodes.arr);
+    ast_cache_nodes.arr = NULL;
+    ast_cache_nodes.capacity = 0;
+    ast_cache_nodes.size = 0;
+}
+
+#endif
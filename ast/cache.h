@@ -0,0 +1,92 @@
+/*
+ * Description: Precompiled AST cache of the Chaos Programming Language's source
+ *
+ * Copyright (c) 2019-2020 Chaos Language Development Authority <info@chaos-lang.org>
+ *
+ * License: GNU General Public License v3.0
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors: M. Mert Yildiran <me@mertyildiran.com>
+ */
+
+#ifndef KAOS_AST_CACHE_H
+#define KAOS_AST_CACHE_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "ast.h"
+
+#define __KAOS_AST_CACHE_MAGIC__ "KAOSC"
+#define __KAOS_AST_CACHE_FORMAT_VERSION__ 3
+#define __KAOS_AST_CACHE_EXTENSION__ "kaosc"
+#define __KAOS_AST_CACHE_DIRECTORY__ "chaos"
+#define __KAOS_AST_CACHE_HASH_SEED__ 14695981039346656037ULL
+#define __KAOS_AST_CACHE_NONE__ 0xFFFFFFFFFFFFFFFFULL
+#define __KAOS_AST_CACHE_LIMIT__ 0xFFFFFFFEULL
+
+#ifndef CHAOS_COMPILER
+bool ast_cache_disabled;
+
+typedef struct ASTCacheHeader {
+    char magic[8];
+    unsigned format_version;
+    unsigned version_major;
+    unsigned version_minor;
+    unsigned version_patchlevel;
+    unsigned node_type_count;
+    unsigned node_record_size;
+    unsigned long long source_hash;
+    unsigned long long payload_hash;
+    unsigned long long source_length;
+    unsigned long long node_count;
+    unsigned long long string_count;
+    unsigned long long strings_length;
+    unsigned long long first;
+    unsigned long long cursor;
+    unsigned long long cursor_backup;
+    // Pads the header so that the node records that follow it stay aligned for union Value
+    unsigned long long reserved;
+} ASTCacheHeader;
+
+// Links are node indexes plus one, zero stands for NULL
+typedef struct ASTCacheNode {
+    union Value value;
+    unsigned next;
+    unsigned left;
+    unsigned right;
+    unsigned child;
+    unsigned depend;
+    unsigned strings_start;
+    unsigned strings_size;
+    unsigned value_string;
+    unsigned value_alias;
+    int node_type;
+    int lineno;
+    int value_type;
+} ASTCacheNode;
+
+typedef struct ast_node_array {
+    ASTNode** arr;
+    unsigned long long capacity, size;
+} ast_node_array;
+
+bool loadASTCache(char *code, size_t length);
+void startASTCacheRecording();
+void recordASTCacheNode(ASTNode* ast_node);
+void saveASTCache(char *code, size_t length);
+void freeASTCache();
+#endif
+
+#endif
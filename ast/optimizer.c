@@ -0,0 +1,575 @@
+/*
+ * Description: AST optimizer of the Chaos Programming Language's source
+ *
+ * Copyright (c) 2019-2020 Chaos Language Development Authority <info@chaos-lang.org>
+ *
+ * License: GNU General Public License v3.0
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors: M. Mert Yildiran <me@mertyildiran.com>
+ */
+
+#include "optimizer.h"
+
+#ifndef CHAOS_COMPILER
+
+#include "cache.h"
+
+extern bool is_interactive;
+
+// The relational and logical operators of a boolean expression group, in the order of enum ASTNodeType
+enum BooleanOperator {
+    BOOLEAN_REL_EQUAL,
+    BOOLEAN_REL_NOT_EQUAL,
+    BOOLEAN_REL_GREAT,
+    BOOLEAN_REL_SMALL,
+    BOOLEAN_REL_GREAT_EQUAL,
+    BOOLEAN_REL_SMALL_EQUAL,
+    BOOLEAN_LOGIC_AND,
+    BOOLEAN_LOGIC_OR,
+    BOOLEAN_LOGIC_NOT,
+};
+
+// The value fields that eval_node reads from the operands of each boolean expression group
+typedef struct BooleanExpressionGroup {
+    enum ASTNodeType first;
+    enum ASTNodeType last;
+    enum ValueType left;
+    enum ValueType right;
+} BooleanExpressionGroup;
+
+static const BooleanExpressionGroup boolean_expression_groups[] = {
+    {AST_BOOLEAN_EXPRESSION_REL_EQUAL, AST_BOOLEAN_EXPRESSION_LOGIC_NOT, V_BOOL, V_BOOL},
+    {AST_BOOLEAN_EXPRESSION_REL_EQUAL_MIXED, AST_BOOLEAN_EXPRESSION_REL_SMALL_EQUAL_MIXED, V_FLOAT, V_FLOAT},
+    {AST_BOOLEAN_EXPRESSION_LOGIC_AND_MIXED, AST_BOOLEAN_EXPRESSION_LOGIC_OR_MIXED, V_FLOAT, V_BOOL},
+    {AST_BOOLEAN_EXPRESSION_LOGIC_NOT_MIXED, AST_BOOLEAN_EXPRESSION_LOGIC_NOT_MIXED, V_FLOAT, V_FLOAT},
+    // There is no evaluation of AST_BOOLEAN_EXPRESSION_REL_EQUAL_MIXED_BOOLEAN to mirror
+    {AST_BOOLEAN_EXPRESSION_REL_NOT_EQUAL_MIXED_BOOLEAN, AST_BOOLEAN_EXPRESSION_LOGIC_OR_MIXED_BOOLEAN, V_FLOAT, V_BOOL},
+    {AST_BOOLEAN_EXPRESSION_REL_EQUAL_BOOLEAN_MIXED, AST_BOOLEAN_EXPRESSION_LOGIC_OR_BOOLEAN_MIXED, V_BOOL, V_FLOAT},
+    {AST_BOOLEAN_EXPRESSION_REL_EQUAL_EXP, AST_BOOLEAN_EXPRESSION_LOGIC_NOT_EXP, V_INT, V_INT},
+    {AST_BOOLEAN_EXPRESSION_REL_EQUAL_EXP_BOOLEAN, AST_BOOLEAN_EXPRESSION_LOGIC_OR_EXP_BOOLEAN, V_INT, V_BOOL},
+    {AST_BOOLEAN_EXPRESSION_REL_EQUAL_BOOLEAN_EXP, AST_BOOLEAN_EXPRESSION_LOGIC_OR_BOOLEAN_EXP, V_BOOL, V_INT},
+    {AST_BOOLEAN_EXPRESSION_REL_EQUAL_MIXED_EXP, AST_BOOLEAN_EXPRESSION_LOGIC_OR_MIXED_EXP, V_FLOAT, V_INT},
+    {AST_BOOLEAN_EXPRESSION_REL_EQUAL_EXP_MIXED, AST_BOOLEAN_EXPRESSION_LOGIC_OR_EXP_MIXED, V_INT, V_FLOAT},
+};
+
+// The first node type of the group that a boolean expression's operator is counted from
+static const enum ASTNodeType boolean_expression_group_bases[] = {
+    AST_BOOLEAN_EXPRESSION_REL_EQUAL,
+    AST_BOOLEAN_EXPRESSION_REL_EQUAL_MIXED,
+    AST_BOOLEAN_EXPRESSION_REL_EQUAL_MIXED,
+    AST_BOOLEAN_EXPRESSION_REL_EQUAL_MIXED,
+    AST_BOOLEAN_EXPRESSION_REL_EQUAL_MIXED_BOOLEAN,
+    AST_BOOLEAN_EXPRESSION_REL_EQUAL_BOOLEAN_MIXED,
+    AST_BOOLEAN_EXPRESSION_REL_EQUAL_EXP,
+    AST_BOOLEAN_EXPRESSION_REL_EQUAL_EXP_BOOLEAN,
+    AST_BOOLEAN_EXPRESSION_REL_EQUAL_BOOLEAN_EXP,
+    AST_BOOLEAN_EXPRESSION_REL_EQUAL_MIXED_EXP,
+    AST_BOOLEAN_EXPRESSION_REL_EQUAL_EXP_MIXED,
+};
+
+static bool isASTLeaf(ASTNode* ast_node) {
+    return ast_node != NULL &&
+        ast_node->next == NULL &&
+        ast_node->left == NULL &&
+        ast_node->right == NULL &&
+        ast_node->child == NULL &&
+        ast_node->depend == NULL;
+}
+
+// A literal as the parser would create it for a T_INT, T_FLOAT, T_TRUE or T_FALSE token
+static bool isASTConstant(ASTNode* ast_node) {
+    if (!isASTLeaf(ast_node))
+        return false;
+
+    switch (ast_node->node_type)
+    {
+        case AST_EXPRESSION_VALUE:
+            return ast_node->value_type == V_INT;
+        case AST_MIXED_EXPRESSION_VALUE:
+            return ast_node->value_type == V_FLOAT;
+        case AST_BOOLEAN_EXPRESSION_VALUE:
+            return ast_node->value_type == V_BOOL;
+        default:
+            return false;
+    }
+}
+
+static bool isASTConstantOf(ASTNode* ast_node, enum ValueType value_type) {
+    return isASTConstant(ast_node) && ast_node->value_type == value_type;
+}
+
+static void replaceWithConstant(ASTNode* ast_node, enum ASTNodeType node_type, union Value value, enum ValueType value_type) {
+    free_node(ast_node->left);
+    free_node(ast_node->right);
+    ast_node->left = NULL;
+    ast_node->right = NULL;
+    ast_node->node_type = node_type;
+    ast_node->value = value;
+    ast_node->value_type = value_type;
+}
+
+static void foldIntegerExpression(ASTNode* ast_node) {
+    if (!isASTConstantOf(ast_node->right, V_INT))
+        return;
+    if (ast_node->node_type != AST_EXPRESSION_BITWISE_NOT && !isASTConstantOf(ast_node->left, V_INT))
+        return;
+
+    // Wraps around on overflow the same way the evaluation does on every supported platform
+    unsigned long long l_value = ast_node->left != NULL ? (unsigned long long) ast_node->left->value.i : 0;
+    unsigned long long r_value = (unsigned long long) ast_node->right->value.i;
+    union Value value;
+
+    switch (ast_node->node_type)
+    {
+        case AST_EXPRESSION_PLUS:
+            value.i = (long long) (l_value + r_value);
+            break;
+        case AST_EXPRESSION_MINUS:
+            value.i = (long long) (l_value - r_value);
+            break;
+        case AST_EXPRESSION_MULTIPLY:
+            value.i = (long long) (l_value * r_value);
+            break;
+        case AST_EXPRESSION_BITWISE_AND:
+            value.i = (long long) (l_value & r_value);
+            break;
+        case AST_EXPRESSION_BITWISE_OR:
+            value.i = (long long) (l_value | r_value);
+            break;
+        case AST_EXPRESSION_BITWISE_XOR:
+            value.i = (long long) (l_value ^ r_value);
+            break;
+        case AST_EXPRESSION_BITWISE_NOT:
+            value.i = (long long) ~r_value;
+            break;
+        // Out of range shift counts are left to the evaluation
+        case AST_EXPRESSION_BITWISE_LEFT_SHIFT:
+            if (r_value >= 64)
+                return;
+            value.i = (long long) (l_value << r_value);
+            break;
+        case AST_EXPRESSION_BITWISE_RIGHT_SHIFT:
+            if (r_value >= 64)
+                return;
+            value.i = ast_node->left->value.i >> r_value;
+            break;
+        default:
+            return;
+    }
+
+    replaceWithConstant(ast_node, AST_EXPRESSION_VALUE, value, V_INT);
+}
+
+static void foldMixedExpression(ASTNode* ast_node) {
+    if (!isASTConstant(ast_node->left) || !isASTConstant(ast_node->right))
+        return;
+    if (ast_node->left->value_type == V_BOOL || ast_node->right->value_type == V_BOOL)
+        return;
+
+    long double l_value = ast_node->left->value_type == V_INT ? (long double) ast_node->left->value.i : ast_node->left->value.f;
+    long double r_value = ast_node->right->value_type == V_INT ? (long double) ast_node->right->value.i : ast_node->right->value.f;
+    union Value value;
+
+    switch (ast_node->node_type)
+    {
+        case AST_MIXED_EXPRESSION_PLUS:
+            value.f = l_value + r_value;
+            break;
+        case AST_MIXED_EXPRESSION_MINUS:
+            value.f = l_value - r_value;
+            break;
+        case AST_MIXED_EXPRESSION_MULTIPLY:
+            value.f = l_value * r_value;
+            break;
+        case AST_MIXED_EXPRESSION_DIVIDE:
+            value.f = l_value / r_value;
+            break;
+        default:
+            return;
+    }
+
+    replaceWithConstant(ast_node, AST_MIXED_EXPRESSION_VALUE, value, V_FLOAT);
+}
+
+static bool isTruthy(ASTNode* ast_node) {
+    switch (ast_node->value_type)
+    {
+        case V_BOOL:
+            return ast_node->value.b;
+        case V_INT:
+            return ast_node->value.i != 0;
+        default:
+            return ast_node->value.f != 0;
+    }
+}
+
+static void foldBooleanExpression(ASTNode* ast_node) {
+    const BooleanExpressionGroup* group = NULL;
+    enum ASTNodeType base = AST_BOOLEAN_EXPRESSION_REL_EQUAL;
+    for (size_t i = 0; i < sizeof(boolean_expression_groups) / sizeof(boolean_expression_groups[0]); i++) {
+        if (ast_node->node_type >= boolean_expression_groups[i].first && ast_node->node_type <= boolean_expression_groups[i].last) {
+            group = &boolean_expression_groups[i];
+            base = boolean_expression_group_bases[i];
+            break;
+        }
+    }
+    if (group == NULL)
+        return;
+
+    enum BooleanOperator operator = (enum BooleanOperator) (ast_node->node_type - base);
+    if (!isASTConstantOf(ast_node->right, group->right))
+        return;
+    if (operator != BOOLEAN_LOGIC_NOT && !isASTConstantOf(ast_node->left, group->left))
+        return;
+
+    union Value value;
+    if (operator == BOOLEAN_LOGIC_NOT) {
+        value.b = !isTruthy(ast_node->right);
+    } else if (operator == BOOLEAN_LOGIC_AND) {
+        value.b = isTruthy(ast_node->left) && isTruthy(ast_node->right);
+    } else if (operator == BOOLEAN_LOGIC_OR) {
+        value.b = isTruthy(ast_node->left) || isTruthy(ast_node->right);
+    } else if (group->left == V_FLOAT || group->right == V_FLOAT) {
+        // The usual arithmetic conversions of the evaluation: compared as floats if either side is one
+        long double l_value = group->left == V_FLOAT ? ast_node->left->value.f : (group->left == V_INT ? ast_node->left->value.i : ast_node->left->value.b);
+        long double r_value = group->right == V_FLOAT ? ast_node->right->value.f : (group->right == V_INT ? ast_node->right->value.i : ast_node->right->value.b);
+        switch (operator)
+        {
+            case BOOLEAN_REL_EQUAL:
+                value.b = l_value == r_value;
+                break;
+            case BOOLEAN_REL_NOT_EQUAL:
+                value.b = l_value != r_value;
+                break;
+            case BOOLEAN_REL_GREAT:
+                value.b = l_value > r_value;
+                break;
+            case BOOLEAN_REL_SMALL:
+                value.b = l_value < r_value;
+                break;
+            case BOOLEAN_REL_GREAT_EQUAL:
+                value.b = l_value >= r_value;
+                break;
+            default:
+                value.b = l_value <= r_value;
+                break;
+        }
+    } else {
+        long long l_value = group->left == V_INT ? ast_node->left->value.i : ast_node->left->value.b;
+        long long r_value = group->right == V_INT ? ast_node->right->value.i : ast_node->right->value.b;
+        switch (operator)
+        {
+            case BOOLEAN_REL_EQUAL:
+                value.b = l_value == r_value;
+                break;
+            case BOOLEAN_REL_NOT_EQUAL:
+                value.b = l_value != r_value;
+                break;
+            case BOOLEAN_REL_GREAT:
+                value.b = l_value > r_value;
+                break;
+            case BOOLEAN_REL_SMALL:
+                value.b = l_value < r_value;
+                break;
+            case BOOLEAN_REL_GREAT_EQUAL:
+                value.b = l_value >= r_value;
+                break;
+            default:
+                value.b = l_value <= r_value;
+                break;
+        }
+    }
+
+    replaceWithConstant(ast_node, AST_BOOLEAN_EXPRESSION_VALUE, value, V_BOOL);
+}
+
+// Evaluates an operator once at parse time if all of its operands are literals,
+// the node becomes the literal that eval_node would have computed every time
+static void foldASTNode(ASTNode* ast_node) {
+    if (ast_node->child != NULL || ast_node->depend != NULL)
+        return;
+
+    if (ast_node->node_type == AST_PARENTHESIS) {
+        if (ast_node->left == NULL && isASTConstant(ast_node->right))
+            replaceWithConstant(ast_node, ast_node->right->node_type, ast_node->right->value, ast_node->right->value_type);
+    } else if (ast_node->node_type >= AST_EXPRESSION_PLUS && ast_node->node_type <= AST_EXPRESSION_BITWISE_RIGHT_SHIFT) {
+        foldIntegerExpression(ast_node);
+    } else if (ast_node->node_type >= AST_MIXED_EXPRESSION_PLUS && ast_node->node_type <= AST_MIXED_EXPRESSION_DIVIDE) {
+        foldMixedExpression(ast_node);
+    } else if (ast_node->node_type >= AST_BOOLEAN_EXPRESSION_REL_EQUAL && ast_node->node_type <= AST_BOOLEAN_EXPRESSION_LOGIC_OR_EXP_MIXED) {
+        foldBooleanExpression(ast_node);
+    }
+}
+
+static void foldASTChain(ASTNode* ast_node) {
+    for (; ast_node != NULL; ast_node = ast_node->next) {
+        foldASTChain(ast_node->depend);
+        foldASTChain(ast_node->right);
+        foldASTChain(ast_node->left);
+        foldASTChain(ast_node->child);
+        foldASTNode(ast_node);
+    }
+}
+
+static void removeASTNode(ASTNode** slot) {
+    (*slot)->next = NULL;
+    free_node(*slot);
+    *slot = NULL;
+}
+
+// Walks the cases in the order of addDecisionCase, drops the ones that can never be selected:
+// a case with a constant false predicate and every case after one that always matches
+static void pruneDecisionCases(ASTNode** slot, bool *exhausted) {
+    ASTNode* ast_node = *slot;
+    if (ast_node == NULL)
+        return;
+
+    if (ast_node->node_type == AST_FUNCTION_STEP) {
+        pruneDecisionCases(&ast_node->depend, exhausted);
+        pruneDecisionCases(&ast_node->right, exhausted);
+        pruneDecisionCases(&ast_node->left, exhausted);
+        return;
+    }
+
+    if (*exhausted) {
+        removeASTNode(slot);
+        return;
+    }
+
+    bool always = ast_node->node_type >= AST_DECISION_MAKE_DEFAULT;
+    if (!always) {
+        if (!isASTConstantOf(ast_node->right, V_BOOL))
+            return;
+        if (!ast_node->right->value.b) {
+            removeASTNode(slot);
+            return;
+        }
+        always = true;
+    }
+
+    // Break and continue cases are skipped outside of a loop, so they don't end the selection
+    switch (ast_node->node_type)
+    {
+        case AST_DECISION_MAKE_BOOLEAN_BREAK:
+        case AST_DECISION_MAKE_BOOLEAN_CONTINUE:
+        case AST_DECISION_MAKE_DEFAULT_BREAK:
+        case AST_DECISION_MAKE_DEFAULT_CONTINUE:
+            break;
+        default:
+            *exhausted = always;
+            break;
+    }
+}
+
+static void collectASTNodes(ast_node_array* nodes, ASTNode* ast_node);
+
+static void pushASTNode(ast_node_array* nodes, ASTNode* ast_node) {
+    if (nodes->capacity == nodes->size) {
+        nodes->capacity = nodes->capacity == 0 ? 256 : nodes->capacity * 2;
+        nodes->arr = realloc(nodes->arr, nodes->capacity * sizeof(ASTNode*));
+    }
+    nodes->arr[nodes->size++] = ast_node;
+}
+
+static void collectASTNode(ast_node_array* nodes, ASTNode* ast_node) {
+    pushASTNode(nodes, ast_node);
+    collectASTNodes(nodes, ast_node->depend);
+    collectASTNodes(nodes, ast_node->right);
+    collectASTNodes(nodes, ast_node->left);
+    collectASTNodes(nodes, ast_node->child);
+}
+
+static void collectASTNodes(ast_node_array* nodes, ASTNode* ast_node) {
+    for (; ast_node != NULL; ast_node = ast_node->next) {
+        collectASTNode(nodes, ast_node);
+    }
+}
+
+// A variable created from a literal that nothing else in the module mentions by name,
+// neither a statement nor a string that could interpolate it
+static bool isUnusedVariable(ast_node_array* nodes, ASTNode* ast_node) {
+    switch (ast_node->node_type)
+    {
+        case AST_VAR_CREATE_BOOL:
+        case AST_VAR_CREATE_ANY_BOOL:
+            if (!isASTConstantOf(ast_node->right, V_BOOL))
+                return false;
+            break;
+        case AST_VAR_CREATE_NUMBER:
+        case AST_VAR_CREATE_ANY_NUMBER:
+            if (!isASTConstantOf(ast_node->right, V_INT) && !isASTConstantOf(ast_node->right, V_FLOAT))
+                return false;
+            break;
+        case AST_VAR_CREATE_STRING:
+        case AST_VAR_CREATE_ANY_STRING:
+            if (ast_node->right != NULL || ast_node->value_type != V_STRING || strstr(ast_node->value.s, "${") != NULL)
+                return false;
+            break;
+        default:
+            return false;
+    }
+
+    if (ast_node->strings_size != 1 || ast_node->left != NULL || ast_node->child != NULL || ast_node->depend != NULL)
+        return false;
+
+    char *name = ast_node->strings[0];
+    for (unsigned long long i = 0; i < nodes->size; i++) {
+        ASTNode* other = nodes->arr[i];
+        for (size_t j = 0; j < other->strings_size; j++) {
+            if (other == ast_node && j == 0)
+                continue;
+            if (other->strings[j] != NULL && strcmp(other->strings[j], name) == 0)
+                return false;
+        }
+        if (other->value_type == V_STRING && other->value.s != NULL && strstr(other->value.s, name) != NULL)
+            return false;
+    }
+    return true;
+}
+
+// Unlinks the unused variables of a statement chain, loop bodies are left as they are since
+// a variable is created on each iteration. The unlinked nodes are freed by the caller
+static void eliminateUnusedVariables(ast_node_array* nodes, ast_node_array* removed, ASTNode** head, char *module) {
+    unsigned long long loop_depth = 0;
+    ASTNode* previous = NULL;
+    ASTNode* ast_node = *head;
+
+    while (ast_node != NULL) {
+        ASTNode* next = ast_node->next;
+
+        if (strcmp(ast_node->module, module) == 0) {
+            if (ast_node->node_type >= AST_START_TIMES_DO && ast_node->node_type <= AST_START_FOREACH_DICT) {
+                loop_depth++;
+            } else if (ast_node->node_type == AST_END) {
+                if (loop_depth > 0)
+                    loop_depth--;
+            } else if (ast_node->node_type >= AST_DEFINE_FUNCTION_BOOL && ast_node->node_type <= AST_DEFINE_FUNCTION_VOID) {
+                eliminateUnusedVariables(nodes, removed, &ast_node->child, module);
+            } else if (loop_depth == 0 && isUnusedVariable(nodes, ast_node)) {
+                if (previous == NULL) {
+                    *head = next;
+                } else {
+                    previous->next = next;
+                }
+                if (ast_node_cursor == ast_node)
+                    ast_node_cursor = previous;
+                ast_node->next = NULL;
+
+                pushASTNode(removed, ast_node);
+
+                ast_node = next;
+                continue;
+            }
+        }
+
+        previous = ast_node;
+        ast_node = next;
+    }
+}
+
+void optimizeAST(char *module) {
+    ast_node_array nodes = {NULL, 0, 0};
+
+    for (ASTNode* ast_node = ast_root_node; ast_node != NULL; ast_node = ast_node->next) {
+        if (strcmp(ast_node->module, module) != 0)
+            continue;
+
+        foldASTChain(ast_node->depend);
+        foldASTChain(ast_node->right);
+        foldASTChain(ast_node->left);
+        foldASTChain(ast_node->child);
+        foldASTNode(ast_node);
+
+        if (ast_node->node_type == AST_DECISION_DEFINE) {
+            bool exhausted = false;
+            pruneDecisionCases(&ast_node->right, &exhausted);
+        }
+
+        collectASTNode(&nodes, ast_node);
+    }
+
+    // The interactive shell and the symbol table printing can observe any variable
+    bool observed = is_interactive;
+    for (unsigned long long i = 0; i < nodes.size && !observed; i++) {
+        if (nodes.arr[i]->node_type == AST_PRINT_SYMBOL_TABLE)
+            observed = true;
+    }
+
+    if (!observed) {
+        ast_node_array removed = {NULL, 0, 0};
+        eliminateUnusedVariables(&nodes, &removed, &ast_root_node, module);
+        for (unsigned long long i = 0; i < removed.size; i++) {
+            free_node(removed.arr[i]);
+        }
+        free(removed.arr);
+    }
+
+    free(nodes.arr);
+}
+
+static void dumpASTNode(ASTNode* ast_node, char *label, unsigned short indent) {
+    for (; ast_node != NULL; ast_node = ast_node->next) {
+        printf(
+            "%*s%sASTNode: {id: %llu, node_type: %s, module: %s, lineno: %d",
+            indent,
+            "",
+            label,
+            ast_node->id,
+            getAstNodeTypeName(ast_node->node_type),
+            ast_node->module,
+            ast_node->lineno
+        );
+
+        if (ast_node->strings_size > 0) {
+            printf(", strings: [");
+            for (size_t i = 0; i < ast_node->strings_size; i++) {
+                printf(i == 0 ? "'%s'" : ", '%s'", ast_node->strings[i]);
+            }
+            printf("]");
+        }
+
+        switch (ast_node->value_type)
+        {
+            case V_BOOL:
+                printf(", value: %s", ast_node->value.b ? "true" : "false");
+                break;
+            case V_INT:
+                printf(", value: %lld", ast_node->value.i);
+                break;
+            case V_FLOAT:
+                printf(", value: %Lg", ast_node->value.f);
+                break;
+            case V_STRING:
+                printf(", value: '%s'", ast_node->value.s);
+                break;
+            default:
+                break;
+        }
+        printf("}\n");
+
+        dumpASTNode(ast_node->depend, "depend: ", indent + __KAOS_AST_DUMP_INDENT__);
+        dumpASTNode(ast_node->right, "right: ", indent + __KAOS_AST_DUMP_INDENT__);
+        dumpASTNode(ast_node->left, "left: ", indent + __KAOS_AST_DUMP_INDENT__);
+        dumpASTNode(ast_node->child, "child: ", indent + __KAOS_AST_DUMP_INDENT__);
+
+        label = "";
+    }
+}
+
+void dumpAST(ASTNode* ast_node) {
+    dumpASTNode(ast_node, "", 0);
+}
+
+#endif
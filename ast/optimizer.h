@@ -0,0 +1,40 @@
+/*
+ * Description: AST optimizer of the Chaos Programming Language's source
+ *
+ * Copyright (c) 2019-2020 Chaos Language Development Authority <info@chaos-lang.org>
+ *
+ * License: GNU General Public License v3.0
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors: M. Mert Yildiran <me@mertyildiran.com>
+ */
+
+#ifndef KAOS_AST_OPTIMIZER_H
+#define KAOS_AST_OPTIMIZER_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "ast.h"
+
+#define __KAOS_AST_DUMP_INDENT__ 4
+
+#ifndef CHAOS_COMPILER
+bool dump_optimized_ast;
+
+void optimizeAST(char *module);
+void dumpAST(ASTNode* ast_node);
+#endif
+
+#endif
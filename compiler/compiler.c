@@ -48,202 +48,269 @@ int relational_operators_size = 4;
 char* logical_operators[] = {"&&", "||", "!"};
 int logical_operators_size = 3;
 
-void compile(char *module, enum Phase phase_arg, char *bin_file, char *extra_flags, bool keep, bool unsafe) {
-    ASTNode* ast_node = ast_root_node;
-    register_functions(ast_node, module);
-    if (!unsafe)
-        preemptive_check();
-
-    printf("Starting compiling...\n");
-    char *module_orig = malloc(strlen(module) + 1);
-    strcpy(module_orig, module);
-    compiler_escape_module(module);
-
-    if (stat(__KAOS_BUILD_DIRECTORY__, &dir_stat) == -1) {
-        printf("Creating %s directory...\n", __KAOS_BUILD_DIRECTORY__);
 #if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
-        _mkdir(__KAOS_BUILD_DIRECTORY__);
-#else
-        mkdir(__KAOS_BUILD_DIRECTORY__, 0700);
-#endif
+static int run_process(char *path, char *args[], char *env) {
+    (void) env;
+    char cmd[4096] = "";
+    for (unsigned i = 0; args[i] != NULL; i++) {
+        strcat(cmd, i == 0 ? "\"" : " ");
+        strcat(cmd, args[i]);
+        if (i == 0)
+            strcat(cmd, "\"");
     }
 
-    char c_file_path[PATH_MAX];
-    char h_file_path[PATH_MAX];
-    if (bin_file != NULL) {
-        sprintf(c_file_path, "%s%s%s.c", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__, bin_file);
-        sprintf(h_file_path, "%s%s%s.h", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__, bin_file);
+    STARTUPINFO info={sizeof(info)};
+    PROCESS_INFORMATION processInfo;
+    DWORD status = 1;
+
+    if (CreateProcess(path, cmd, NULL, NULL, TRUE, 0, NULL, NULL, &info, &processInfo)) {
+        WaitForSingleObject(processInfo.hProcess, INFINITE);
+        GetExitCodeProcess(processInfo.hProcess, &status);
+        CloseHandle(processInfo.hThread);
+        CloseHandle(processInfo.hProcess);
     } else {
-        sprintf(c_file_path, "%s%smain.c", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__);
-        sprintf(h_file_path, "%s%smain.h", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__);
+        printf("CreateProcess() failed!");
+    }
+    return (int) status;
+}
+
+static void prepare_profile_directory(char *profile_dir_path) {
+    char pattern[PATH_MAX + 4];
+    sprintf(pattern, "%s\\*", profile_dir_path);
+    WIN32_FIND_DATA find_data;
+    HANDLE handle = FindFirstFile(pattern, &find_data);
+    if (handle != INVALID_HANDLE_VALUE) {
+        do {
+            if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                continue;
+            char file_path[PATH_MAX * 2];
+            sprintf(file_path, "%s\\%s", profile_dir_path, find_data.cFileName);
+            remove(file_path);
+        } while (FindNextFile(handle, &find_data));
+        FindClose(handle);
+    }
+    _mkdir(profile_dir_path);
+}
+#else
+// Starts the program without waiting for it, env is an optional NAME=VALUE pair for the child
+static pid_t start_process(char *path, char *args[], char *env) {
+    pid_t pid;
+    if ((pid = fork()) == -1) {
+        perror("fork error");
+        return -1;
+    } else if (pid == 0) {
+        if (env != NULL)
+            putenv(env);
+        execvp(path, args);
+        perror(path);
+        _exit(127);
     }
+    return pid;
+}
 
-    printf("Compiling Chaos code into %s\n", c_file_path);
+// Waits for the child (any child if pid is -1) and returns its exit status
+static int wait_process(pid_t pid, pid_t *finished_pid) {
+    int status;
+    pid_t result = waitpid(pid, &status, 0);
+    if (finished_pid != NULL)
+        *finished_pid = result;
+    if (result == -1)
+        return -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+}
 
-    errno = 0;
+// Runs the program and returns its exit status
+static int run_process(char *path, char *args[], char *env) {
+    pid_t pid = start_process(path, args, env);
+    if (pid == -1)
+        return -1;
+    return wait_process(pid, NULL);
+}
 
-    FILE *c_fp = fopen(c_file_path, "w");
-    if (c_fp == NULL)
-    {
-        fprintf(stderr, "Cannot open file! Error no: %d\n", errno);
-        fprintf(stderr, "C source path: %s\n", c_file_path);
-        exit(1);
+// Profiles of an earlier build would be merged into the new one
+static void prepare_profile_directory(char *profile_dir_path) {
+    DIR *dir = opendir(profile_dir_path);
+    if (dir != NULL) {
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL) {
+            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+                continue;
+            char file_path[PATH_MAX * 2];
+            sprintf(file_path, "%s/%s", profile_dir_path, entry->d_name);
+            remove(file_path);
+        }
+        closedir(dir);
     }
+    mkdir(profile_dir_path, 0700);
+}
+#endif
 
-    FILE *h_fp = fopen(h_file_path, "w");
-    if (h_fp == NULL)
-    {
-        fprintf(stderr, "Cannot open file! Error no: %d\n", errno);
-        fprintf(stderr, "C header path: %s\n", h_file_path);
-        exit(1);
+static void run_pgo_training(char *bin_file_path, char *pgo_args, char *profile_raw_path) {
+    string_array pgo_args_arr;
+    pgo_args_arr.size = 0;
+    char *pgo_args_copy = malloc(strlen(pgo_args) + 1);
+    strcpy(pgo_args_copy, pgo_args);
+    if (strlen(pgo_args_copy) > 0)
+        pgo_args_arr = str_split(pgo_args_copy, ' ');
+    unsigned pgo_args_count = pgo_args_arr.size;
+    if (pgo_args_count > 0)
+        pgo_args_count--;
+
+    char *args[pgo_args_count + 2];
+    args[0] = bin_file_path;
+    for (unsigned i = 0; i < pgo_args_count; i++) {
+        args[i + 1] = pgo_args_arr.arr[i];
     }
+    args[pgo_args_count + 1] = NULL;
 
-    if (keep) {
-        fprintf(
-            h_fp,
-            "/*\n"
-            " * Intermediate C header code generated by Chaos Programming Language\n"
-            " * Language Reference: https://chaos-lang.org\n"
-            " *\n"
-        );
-        fprintf(
-            c_fp,
-            "/*\n"
-            " * Intermediate C source code generated by Chaos Programming Language\n"
-            " * Language Reference: https://chaos-lang.org\n"
-            " *\n"
-        );
-        if (bin_file != NULL) {
-            fprintf(h_fp, " * Filename: %s.h\n", bin_file);
-            fprintf(c_fp, " * Filename: %s.c\n", bin_file);
-        } else {
-            fprintf(h_fp, " * Filename: main.h\n");
-            fprintf(c_fp, " * Filename: main.c\n");
+    char *env = NULL;
+    if (profile_raw_path != NULL)
+        env = snprintf_concat_string(NULL, "LLVM_PROFILE_FILE=%s", profile_raw_path);
+
+    int status = run_process(bin_file_path, args, env);
+    if (status != 0)
+        fprintf(stderr, "The instrumented binary %s exited with status %d, the profile may be incomplete.\n", bin_file_path, status);
+
+    if (pgo_args_arr.size > 0) {
+        for (unsigned i = 0; i < pgo_args_count; i++) {
+            free(pgo_args_arr.arr[i]);
         }
-        fprintf(h_fp, " */\n\n");
-        fprintf(c_fp, " */\n\n");
+        free(pgo_args_arr.arr);
     }
+    free(pgo_args_copy);
+}
 
-    if (bin_file != NULL) {
-        char *bin_file_upper = malloc(1 + strlen(bin_file));
-        strcpy(bin_file_upper, bin_file);
-        string_uppercase(bin_file_upper);
-        fprintf(h_fp, "#ifndef %s_H\n", bin_file_upper);
-        fprintf(h_fp, "#define %s_H\n\n", bin_file_upper);
-        free(bin_file_upper);
-    } else {
-        fprintf(h_fp, "#ifndef MAIN_H\n");
-        fprintf(h_fp, "#define MAIN_H\n\n");
+// FNV-1a, only used to tell whether an object file is still up to date
+static unsigned long long hash_bytes(unsigned long long hash, const void *data, size_t size) {
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= __KAOS_HASH_PRIME__;
     }
+    return hash;
+}
 
-    fprintf(c_fp, "#include <math.h>\n\n");
-
-    if (bin_file != NULL) {
-        fprintf(c_fp, "#include \"%s.h\"\n\n", bin_file);
-    } else {
-        fprintf(c_fp, "#include \"main.h\"\n\n");
-    }
+static unsigned long long hash_string(unsigned long long hash, char *str) {
+    return hash_bytes(hash, str, strlen(str) + 1);
+}
 
-    unsigned short indent = indent_length;
+static unsigned long long hash_file(unsigned long long hash, char *file_path) {
+    hash = hash_string(hash, file_path);
+    FILE *fp = fopen(file_path, "rb");
+    if (fp == NULL)
+        return hash;
 
-    const char *c_file_base =
-        "extern bool disable_complex_mode;\n\n"
-        "int kaos_lineno;\n"
-        "unsigned long long nested_loop_counter = 0;\n\n";
+    char buffer[BUFSIZ];
+    size_t size;
+    while ((size = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+        hash = hash_bytes(hash, buffer, size);
+    }
+    fclose(fp);
+    return hash;
+}
 
-    const char *h_file_base =
-        "#include <stdio.h>\n"
-        "#include <stdbool.h>\n\n"
-        "#include \"interpreter/function.h\"\n"
-        "#include \"interpreter/symbol.h\"\n\n"
-        "jmp_buf LoopBreak;\n"
-        "jmp_buf LoopContinue;\n\n";
+static unsigned long long hash_file_mtime(unsigned long long hash, char *file_path) {
+    struct stat file_stat;
+    hash = hash_string(hash, file_path);
+    if (stat(file_path, &file_stat) == 0)
+        hash = hash_bytes(hash, &file_stat.st_mtime, sizeof(file_stat.st_mtime));
+    return hash;
+}
 
-    fprintf(c_fp, "%s", c_file_base);
-    fprintf(h_fp, "%s", h_file_base);
+// Follows the headers that the translation unit includes through the headers of the modules
+static unsigned long long hash_translation_unit_headers(unsigned long long hash, TranslationUnit* unit, string_array *visited) {
+    append_to_array(visited, unit->name);
+    hash = hash_file(hash, unit->h_file_path);
+    for (unsigned i = 0; i < unit->dependencies.size; i++) {
+        TranslationUnit* dependency = compiler_get_translation_unit(unit->dependencies.arr[i]);
+        if (dependency != NULL && !is_in_array(visited, dependency->name))
+            hash = hash_translation_unit_headers(hash, dependency, visited);
+    }
+    return hash;
+}
 
-    transpile_functions(ast_node, module, c_fp, indent, h_fp);
-    free_transpiled_functions();
-    free_transpiled_decisions();
+static unsigned long long hash_translation_unit(TranslationUnit* unit, char *args[]) {
+    unsigned long long hash = __KAOS_HASH_OFFSET_BASIS__;
+    hash = hash_file(hash, unit->c_file_path);
 
-    fprintf(c_fp, "int main(int argc, char** argv) {\n");
+    string_array visited;
+    visited.capacity = 0;
+    visited.size = 0;
+    hash = hash_translation_unit_headers(hash, unit, &visited);
+    for (unsigned i = 0; i < visited.size; i++) {
+        free(visited.arr[i]);
+    }
+    if (visited.size > 0) free(visited.arr);
 
-    char *fixed_module_orig = fix_bs(module_orig);
-    free(module_orig);
-    fprintf(
-        c_fp,
-        "%*cprogram_file_path = malloc(strlen(\"%s\") + 1);\n"
-        "%*cstrcpy(program_file_path, \"%s\");\n",
-        indent,
-        ' ',
-        fixed_module_orig,
-        indent,
-        ' ',
-        fixed_module_orig
-    );
-    free(fixed_module_orig);
+    for (unsigned i = 0; args[i] != NULL; i++) {
+        hash = hash_string(hash, args[i]);
+    }
 
-    fprintf(
-        c_fp,
-        "%*cchar *argv0 = malloc(1 + strlen(argv[0]));\n"
-        "%*cstrcpy(argv0, argv[0]);\n",
-        indent,
-        ' ',
-        indent,
-        ' '
-    );
+    // A new install of the runtime changes what the same C code compiles into
+    char version[__KAOS_MSG_LINE_LENGTH__];
+    sprintf(version, "%d.%d.%d", __KAOS_VERSION_MAJOR__, __KAOS_VERSION_MINOR__, __KAOS_VERSION_PATCHLEVEL__);
+    hash = hash_string(hash, version);
+    hash = hash_file_mtime(hash, "/usr/local/include/chaos/interpreter/function.h");
+    hash = hash_file_mtime(hash, "/usr/local/include/chaos/interpreter/symbol.h");
+    hash = hash_file_mtime(hash, __KAOS_RUNTIME_LIBRARY__);
+    return hash;
+}
 
-    fprintf(c_fp, "%*cinitMainFunction();\n", indent, ' ');
+static bool is_object_up_to_date(char *object_path, char *hash_path, unsigned long long hash) {
+    if (!is_file_exists(object_path))
+        return false;
 
-    fprintf(c_fp, "%*cphase = PREPARSE;\n", indent, ' ');
-    compiler_register_functions(ast_node, module, c_fp, indent);
-    fprintf(c_fp, "%*cphase = PROGRAM;\n", indent, ' ');
-    transpile_node(ast_node, module, c_fp, indent);
+    FILE *fp = fopen(hash_path, "r");
+    if (fp == NULL)
+        return false;
 
-    fprintf(
-        c_fp,
-        "%*cfree(argv0);\n"
-        "%*cfreeEverything();\n"
-        "%*creturn 0;\n",
-        indent,
-        ' ',
-        indent,
-        ' ',
-        indent,
-        ' '
-    );
+    unsigned long long stored_hash;
+    bool is_up_to_date = fscanf(fp, "%llx", &stored_hash) == 1 && stored_hash == hash;
+    fclose(fp);
+    return is_up_to_date;
+}
 
-    fprintf(c_fp, "}\n");
-    fprintf(h_fp, "\n#endif\n");
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
+// Waits for one of the running compilations and stamps its object file with the hash it was compiled from
+static bool wait_translation_unit(pid_t pids[], unsigned long long hashes[], char *hash_paths[]) {
+    pid_t finished_pid;
+    int status = wait_process(-1, &finished_pid);
+    if (finished_pid == -1)
+        return false;
 
-    fclose(c_fp);
-    fclose(h_fp);
+    for (unsigned i = 0; i < translation_units_size; i++) {
+        if (pids[i] != finished_pid)
+            continue;
+        pids[i] = 0;
 
-    printf("Compiling the C code into machine code...\n");
+        if (status != 0) {
+            fprintf(stderr, "Compilation of %s is failed!\n", translation_units[i]->c_file_path);
+            return false;
+        }
 
-    char bin_file_path[PATH_MAX];
-    if (bin_file != NULL) {
-#if defined(__clang__) && (defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__))
-        sprintf(bin_file_path, "%s%s%s.exe", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__, bin_file);
-#else
-        sprintf(bin_file_path, "%s%s%s", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__, bin_file);
-#endif
-    } else {
-#if defined(__clang__) && (defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__))
-        sprintf(bin_file_path, "%s%smain.exe", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__);
-#else
-        sprintf(bin_file_path, "%s%smain", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__);
-#endif
+        FILE *fp = fopen(hash_paths[i], "w");
+        if (fp != NULL) {
+            fprintf(fp, "%016llx\n", hashes[i]);
+            fclose(fp);
+        }
     }
-
-    char c_compiler_path[PATH_MAX];
-#if defined(__clang__)
-    sprintf(c_compiler_path, "clang");
-#elif defined(__GNUC__) || defined(__GNUG__)
-    sprintf(c_compiler_path, "gcc");
+    return true;
+}
 #endif
 
+static void compile_c_code(char *c_compiler_path, char *bin_file_path, char *extra_flags, char *flags[], unsigned flags_count, bool use_runtime_library, unsigned jobs, bool reuse_objects) {
 #if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+    (void) use_runtime_library;
+    (void) jobs;
+    (void) reuse_objects;
+
+    char c_file_path[2048] = "";
+    for (unsigned i = 0; i < translation_units_size; i++) {
+        if (i > 0)
+            strcat(c_file_path, " ");
+        strcat(c_file_path, translation_units[i]->c_file_path);
+    }
+
     char include_path[PATH_MAX];
     PWSTR szPath = NULL;
 #   if defined(__clang__)
@@ -277,14 +344,16 @@ void compile(char *module, enum Phase phase_arg, char *bin_file, char *extra_fla
     sprintf(include_path_module, "\"%s/interpreter/module.c\"", include_path);
     char include_path_symbol[PATH_MAX];
     sprintf(include_path_symbol, "\"%s/interpreter/symbol.c\"", include_path);
+    char include_path_json[PATH_MAX];
+    sprintf(include_path_json, "\"%s/interpreter/json.c\"", include_path);
+    char include_path_output[PATH_MAX];
+    sprintf(include_path_output, "\"%s/interpreter/output.c\"", include_path);
+    char include_path_profiler[PATH_MAX];
+    sprintf(include_path_profiler, "\"%s/interpreter/profiler.c\"", include_path);
     char include_path_alternative[PATH_MAX];
     sprintf(include_path_alternative, "\"%s/compiler/lib/alternative.c\"", include_path);
     char include_path_parser[PATH_MAX];
     sprintf(include_path_parser, "\"%s/parser/parser.c\"", include_path);
-    char include_path_parser_tab[PATH_MAX];
-    sprintf(include_path_parser_tab, "\"%s/parser.tab.c\"", include_path);
-    char include_path_lex_yy[PATH_MAX];
-    sprintf(include_path_lex_yy, "\"%s/lex.yy.c\"", include_path);
     char include_path_chaos[PATH_MAX];
     sprintf(include_path_chaos, "\"%s/Chaos.c\"", include_path);
     char include_path_include[PATH_MAX];
@@ -300,7 +369,7 @@ void compile(char *module, enum Phase phase_arg, char *bin_file, char *extra_fla
 #   if !defined(__clang__)
         "/c %s %s %s %s %s %s %s %s %s -o %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s",
 #   else
-        "/c %s %s %s %s -o %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s",
+        "/c %s %s %s %s -o %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s %s",
 #   endif
         c_compiler_path,
         "-fcommon",
@@ -328,14 +397,20 @@ void compile(char *module, enum Phase phase_arg, char *bin_file, char *extra_fla
         include_path_function,
         include_path_module,
         include_path_symbol,
+        include_path_json,
+        include_path_output,
+        include_path_profiler,
         include_path_alternative,
         include_path_parser,
-        include_path_parser_tab,
-        include_path_lex_yy,
         include_path_chaos,
         include_path_include
     );
 
+    for (unsigned i = 0; i < flags_count; i++) {
+        strcat(cmd, " ");
+        strcat(cmd, flags[i]);
+    }
+
     if (extra_flags != NULL)
         sprintf(cmd, "%s %s", cmd, extra_flags);
 
@@ -356,8 +431,6 @@ void compile(char *module, enum Phase phase_arg, char *bin_file, char *extra_fla
         printf("CreateProcess() failed!");
     }
 #else
-    pid_t pid;
-
     string_array extra_flags_arr;
     extra_flags_arr.size = 0;
     if (extra_flags != NULL)
@@ -366,132 +439,394 @@ void compile(char *module, enum Phase phase_arg, char *bin_file, char *extra_fla
     if (extra_flags_count > 0)
         extra_flags_count--;
 
-    unsigned arg_count = 29 + extra_flags_count;
+    // The flags that both compiling the translation units and linking them get
+    char *common_args[__KAOS_COMPILER_ARGS_BASE__ + flags_count + extra_flags_count];
+    unsigned common_args_count = 0;
+    common_args[common_args_count++] = "-Werror";
+    common_args[common_args_count++] = "-Wall";
+    common_args[common_args_count++] = "-pedantic";
+    common_args[common_args_count++] = "-fcommon";
+    common_args[common_args_count++] = "-DCHAOS_COMPILER";
+    common_args[common_args_count++] = "-I/usr/local/include/chaos/";
+
+    // The optimization flags come first so that the extra flags can override them
+    for (unsigned i = 0; i < flags_count; i++) {
+        common_args[common_args_count++] = flags[i];
+    }
+
+    for (unsigned i = 0; i < extra_flags_count; i++) {
+        common_args[common_args_count++] = extra_flags_arr.arr[i];
+    }
+
 #   if !defined(__clang__)
-    arg_count++;
+    common_args[common_args_count++] = "-fcompare-debug-second";
 #   endif
 
-#   if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
-    arg_count++;
-#   endif
+    char objects_dir_path[PATH_MAX];
+    sprintf(objects_dir_path, "%s%s%s", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__, __KAOS_OBJECTS_DIRECTORY__);
+    if (stat(objects_dir_path, &dir_stat) == -1) {
+        printf("Creating %s directory...\n", objects_dir_path);
+        mkdir(objects_dir_path, 0700);
+    }
 
-    char *c_compiler_args[arg_count];
-    int arg_i = 0;
-    c_compiler_args[arg_i++] = c_compiler_path;
-    c_compiler_args[arg_i++] = "-Werror";
-    c_compiler_args[arg_i++] = "-Wall";
-    c_compiler_args[arg_i++] = "-pedantic";
-    c_compiler_args[arg_i++] = "-fcommon";
-    c_compiler_args[arg_i++] = "-DCHAOS_COMPILER";
-    c_compiler_args[arg_i++] = "-o";
-    c_compiler_args[arg_i++] = bin_file_path;
-    c_compiler_args[arg_i++] = c_file_path;
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/utilities/helpers.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/utilities/language.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/utilities/cwalk.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/ast/ast.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/interpreter.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/errors.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/extension.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/function.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/module.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/symbol.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/compiler/lib/alternative.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/parser/parser.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/parser.tab.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/lex.yy.c";
-    c_compiler_args[arg_i++] = "/usr/local/include/chaos/Chaos.c";
-    c_compiler_args[arg_i++] = "-lreadline";
-    c_compiler_args[arg_i++] = "-L/usr/local/opt/readline/lib";
-    c_compiler_args[arg_i++] = "-ldl";
-    c_compiler_args[arg_i++] = "-I/usr/local/include/chaos/";
+    if (jobs == 0) {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        jobs = processors > 0 ? (unsigned) processors : 1;
+    }
 
-    for (unsigned i = 0; i < (extra_flags_count); i++) {
-        c_compiler_args[arg_i + i] = extra_flags_arr.arr[i];
-        arg_i++;
+    char *object_paths[translation_units_size];
+    char *hash_paths[translation_units_size];
+    pid_t pids[translation_units_size];
+    unsigned long long hashes[translation_units_size];
+    unsigned running = 0;
+    bool failed = false;
+
+    for (unsigned i = 0; i < translation_units_size; i++) {
+        TranslationUnit* unit = translation_units[i];
+        object_paths[i] = NULL;
+        object_paths[i] = snprintf_concat_string(object_paths[i], "%s", objects_dir_path);
+        object_paths[i] = snprintf_concat_string(object_paths[i], "%s", __KAOS_PATH_SEPARATOR__);
+        object_paths[i] = snprintf_concat_string(object_paths[i], "%s.o", unit->name);
+        hash_paths[i] = NULL;
+        hash_paths[i] = snprintf_concat_string(hash_paths[i], "%s", objects_dir_path);
+        hash_paths[i] = snprintf_concat_string(hash_paths[i], "%s", __KAOS_PATH_SEPARATOR__);
+        hash_paths[i] = snprintf_concat_string(hash_paths[i], "%s.hash", unit->name);
+        pids[i] = 0;
     }
 
-#   if !defined(__clang__)
-    c_compiler_args[arg_i + extra_flags_count] = "-fcompare-debug-second",
-#   endif
+    for (unsigned i = 0; i < translation_units_size && !failed; i++) {
+        TranslationUnit* unit = translation_units[i];
 
-#   if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
-    c_compiler_args[arg_i + extra_flags_count] = "-Wl,-stack_size,0x100000000",
-    arg_i++;
-#   endif
+        char *c_compiler_args[common_args_count + 6];
+        unsigned arg_i = 0;
+        c_compiler_args[arg_i++] = c_compiler_path;
+        for (unsigned j = 0; j < common_args_count; j++) {
+            c_compiler_args[arg_i++] = common_args[j];
+        }
+        c_compiler_args[arg_i++] = "-c";
+        c_compiler_args[arg_i++] = unit->c_file_path;
+        c_compiler_args[arg_i++] = "-o";
+        c_compiler_args[arg_i++] = object_paths[i];
+        c_compiler_args[arg_i++] = NULL;
+
+        hashes[i] = hash_translation_unit(unit, c_compiler_args);
+        if (reuse_objects && is_object_up_to_date(object_paths[i], hash_paths[i], hashes[i])) {
+            printf("Reusing %s\n", object_paths[i]);
+            continue;
+        }
+        remove(hash_paths[i]);
 
-    c_compiler_args[arg_count - 1] = NULL;
+        if (running == jobs) {
+            failed = !wait_translation_unit(pids, hashes, hash_paths);
+            running--;
+            if (failed)
+                break;
+        }
 
-    if ((pid = fork()) == -1)
-        perror("fork error");
-    else if (pid == 0)
-        execvp(c_compiler_path, c_compiler_args);
+        pids[i] = start_process(c_compiler_path, c_compiler_args, NULL);
+        if (pids[i] == -1) {
+            pids[i] = 0;
+            fprintf(stderr, "Compilation of %s is failed!\n", unit->c_file_path);
+            failed = true;
+            break;
+        }
+        running++;
+    }
 
-    int status;
-    pid_t wait_result;
+    for (; running > 0; running--) {
+        if (!wait_translation_unit(pids, hashes, hash_paths))
+            failed = true;
+    }
 
-    while ((wait_result = wait(&status)) != -1)
-    {
-        // printf("Process %lu returned result: %d\n", (unsigned long) wait_result, status);
-        if (status != 0) {
-            fprintf(stderr, "Compilation of %s is failed!\n", c_file_path);
-            exit(1);
-        }
+    for (unsigned i = 0; i < translation_units_size; i++) {
+        free(hash_paths[i]);
     }
-#endif
 
-    if (!keep) {
-        printf("Cleaning up the temporary files...\n\n");
-        remove(c_file_path);
-        remove(h_file_path);
+    if (failed)
+        exit(1);
+
+    char *c_compiler_args[__KAOS_COMPILER_ARGS_BASE__ + common_args_count + translation_units_size];
+    unsigned arg_i = 0;
+    c_compiler_args[arg_i++] = c_compiler_path;
+    c_compiler_args[arg_i++] = "-o";
+    c_compiler_args[arg_i++] = bin_file_path;
+    for (unsigned i = 0; i < translation_units_size; i++) {
+        c_compiler_args[arg_i++] = object_paths[i];
+    }
+    if (use_runtime_library) {
+        c_compiler_args[arg_i++] = __KAOS_RUNTIME_LIBRARY__;
     } else {
-        printf("\n");
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/utilities/helpers.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/utilities/language.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/utilities/cwalk.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/ast/ast.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/interpreter.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/errors.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/extension.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/function.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/module.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/symbol.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/json.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/output.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/interpreter/profiler.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/compiler/lib/alternative.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/parser/parser.c";
+        c_compiler_args[arg_i++] = "/usr/local/include/chaos/Chaos.c";
+    }
+    c_compiler_args[arg_i++] = "-ldl";
+    for (unsigned i = 0; i < common_args_count; i++) {
+        c_compiler_args[arg_i++] = common_args[i];
     }
+    c_compiler_args[arg_i++] = NULL;
 
-    printf("Finished compiling.\n\n");
+    int status = run_process(c_compiler_path, c_compiler_args, NULL);
 
-    char bin_file_path_final[PATH_MAX + 4];
-#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
-    if (!string_ends_with(bin_file_path, __KAOS_WINDOWS_EXE_EXT__)) {
-        sprintf(bin_file_path_final, "%s%s", bin_file_path, __KAOS_WINDOWS_EXE_EXT__);
-    } else {
-        sprintf(bin_file_path_final, "%s", bin_file_path);
+    for (unsigned i = 0; i < translation_units_size; i++) {
+        free(object_paths[i]);
     }
-#else
-    sprintf(bin_file_path_final, "%s", bin_file_path);
-#endif
 
-    printf("Binary is ready on: %s\n", bin_file_path_final);
+    if (status != 0) {
+        fprintf(stderr, "Linking of %s is failed!\n", bin_file_path);
+        exit(1);
+    }
+#endif
 }
 
-char* last_function_name;
+void compile(char *module, enum Phase phase_arg, char *bin_file, char *extra_flags, bool keep, bool unsafe, unsigned short optimization_level, bool lto, char *pgo_args, unsigned jobs, bool instrument) {
+    ASTNode* ast_node = ast_root_node;
+    register_functions(ast_node, module);
+    if (!unsafe)
+        preemptive_check();
 
-ASTNode* transpile_functions(ASTNode* ast_node, char *module, FILE *c_fp, unsigned short indent, FILE *h_fp) {
-transpile_functions_label:
-    if (ast_node == NULL) {
-        return ast_node;
-    }
-    char *ast_node_module = malloc(1 + strlen(ast_node->module));
-    strcpy(ast_node_module, ast_node->module);
-    compiler_escape_module(ast_node_module);
+    printf("Starting compiling...\n");
+    char *module_orig = malloc(strlen(module) + 1);
+    strcpy(module_orig, module);
+    compiler_escape_module(module);
 
-    if (strcmp(ast_node_module, module) != 0) {
-        free(ast_node_module);
-        ast_node = ast_node->next;
-        goto transpile_functions_label;
+    if (stat(__KAOS_BUILD_DIRECTORY__, &dir_stat) == -1) {
+        printf("Creating %s directory...\n", __KAOS_BUILD_DIRECTORY__);
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+        _mkdir(__KAOS_BUILD_DIRECTORY__);
+#else
+        mkdir(__KAOS_BUILD_DIRECTORY__, 0700);
+#endif
     }
-    free(ast_node_module);
 
-    if (is_node_function_related(ast_node)) {
-        if (ast_node->depend != NULL) {
-            transpile_functions(ast_node->depend, module, c_fp, indent, h_fp);
-        }
+    keep_translation_units = keep;
+    instrument_functions = instrument;
+    TranslationUnit* main_unit = compiler_open_translation_unit(bin_file != NULL ? bin_file : "main");
+    FILE *c_fp = main_unit->c_fp;
+    FILE *h_fp = main_unit->h_fp;
 
-        if (ast_node->right != NULL) {
-            transpile_functions(ast_node->right, module, c_fp, indent, h_fp);
-        }
+    unsigned short indent = indent_length;
 
-        if (ast_node->left != NULL) {
+    const char *c_file_base =
+        "int kaos_lineno;\n"
+        "extern _Function kaos_static_functions[];\n"
+        "extern const StaticParameter kaos_static_parameters[];\n\n";
+
+    fprintf(c_fp, "%s", c_file_base);
+
+    // The symbol table is printed with the ids of its symbols, so no variable can move out of it
+    native_variables_disabled = compiler_has_node_type(ast_node, AST_PRINT_SYMBOL_TABLE);
+    compiler_find_typed_functions(module);
+
+    transpile_functions(ast_node, module, c_fp, indent, h_fp);
+    free_transpiled_functions();
+    free_transpiled_decisions();
+
+    fprintf(c_fp, "int main(int argc, char** argv) {\n");
+
+    char *fixed_module_orig = fix_bs(module_orig);
+    free(module_orig);
+    fprintf(
+        c_fp,
+        "%*cprogram_file_path = malloc(strlen(\"%s\") + 1);\n"
+        "%*cstrcpy(program_file_path, \"%s\");\n",
+        indent,
+        ' ',
+        fixed_module_orig,
+        indent,
+        ' ',
+        fixed_module_orig
+    );
+    free(fixed_module_orig);
+
+    fprintf(
+        c_fp,
+        "%*cchar *argv0 = malloc(1 + strlen(argv[0]));\n"
+        "%*cstrcpy(argv0, argv[0]);\n",
+        indent,
+        ' ',
+        indent,
+        ' '
+    );
+
+    fprintf(c_fp, "%*cinitOutput(false);\n", indent, ' ');
+    fprintf(c_fp, "%*cinitMainFunction();\n", indent, ' ');
+    if (instrument_functions)
+        fprintf(c_fp, "%*cstartInstrumentation();\n", indent, ' ');
+
+    fprintf(c_fp, "%*cphase = PREPARSE;\n", indent, ' ');
+    compiler_register_functions(ast_node, module, c_fp, indent);
+    compiler_register_static_functions(c_fp, indent);
+    fprintf(c_fp, "%*cphase = PROGRAM;\n", indent, ' ');
+    compiler_analyze_native_variables(ast_node, module, false);
+    compiler_declare_native_variables(c_fp, indent);
+    transpile_node(ast_node, module, c_fp, indent);
+    compiler_free_native_variables();
+    compiler_free_typed_functions();
+
+    fprintf(
+        c_fp,
+        "%*cfree(argv0);\n"
+        "%*cfreeEverything();\n"
+        "%*creturn 0;\n",
+        indent,
+        ' ',
+        indent,
+        ' ',
+        indent,
+        ' '
+    );
+
+    fprintf(c_fp, "}\n");
+    compiler_transpile_static_functions(c_fp);
+    compiler_free_static_functions();
+    compiler_close_translation_units();
+
+    printf("Compiling the C code into machine code...\n");
+
+    char bin_file_path[PATH_MAX];
+    if (bin_file != NULL) {
+#if defined(__clang__) && (defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__))
+        sprintf(bin_file_path, "%s%s%s.exe", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__, bin_file);
+#else
+        sprintf(bin_file_path, "%s%s%s", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__, bin_file);
+#endif
+    } else {
+#if defined(__clang__) && (defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__))
+        sprintf(bin_file_path, "%s%smain.exe", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__);
+#else
+        sprintf(bin_file_path, "%s%smain", __KAOS_BUILD_DIRECTORY__, __KAOS_PATH_SEPARATOR__);
+#endif
+    }
+
+    char c_compiler_path[PATH_MAX];
+#if defined(__clang__)
+    sprintf(c_compiler_path, "clang");
+#elif defined(__GNUC__) || defined(__GNUG__)
+    sprintf(c_compiler_path, "gcc");
+#endif
+
+    char optimization_flag[__KAOS_ITOA_BUFFER_LENGTH__];
+    sprintf(optimization_flag, "-O%u", optimization_level);
+    char *flags[__KAOS_COMPILER_FLAGS_MAX__];
+    unsigned flags_count = 0;
+    flags[flags_count++] = optimization_flag;
+    if (lto)
+        flags[flags_count++] = "-flto";
+
+    // Link-time and profile-guided optimizations only pay off when they see the runtime too
+    bool use_runtime_library = extra_flags == NULL && !lto && pgo_args == NULL && is_file_exists(__KAOS_RUNTIME_LIBRARY__);
+
+    if (pgo_args == NULL) {
+        compile_c_code(c_compiler_path, bin_file_path, extra_flags, flags, flags_count, use_runtime_library, jobs, true);
+    } else {
+        char profile_dir_path[PATH_MAX + 8];
+        sprintf(profile_dir_path, "%s.profile", bin_file_path);
+        prepare_profile_directory(profile_dir_path);
+
+        char profile_generate_flag[PATH_MAX + 64];
+        char profile_use_flag[PATH_MAX + 64];
+        sprintf(profile_generate_flag, "-fprofile-generate=%s", profile_dir_path);
+#if defined(__clang__)
+        char profile_raw_path[PATH_MAX + 32];
+        char profile_data_path[PATH_MAX + 32];
+        sprintf(profile_raw_path, "%s%sdefault.profraw", profile_dir_path, __KAOS_PATH_SEPARATOR__);
+        sprintf(profile_data_path, "%s%sdefault.profdata", profile_dir_path, __KAOS_PATH_SEPARATOR__);
+        sprintf(profile_use_flag, "-fprofile-use=%s", profile_data_path);
+#else
+        sprintf(profile_use_flag, "-fprofile-use=%s", profile_dir_path);
+#endif
+
+        printf("Building the instrumented binary for profile-guided optimization...\n");
+        flags[flags_count] = profile_generate_flag;
+        compile_c_code(c_compiler_path, bin_file_path, extra_flags, flags, flags_count + 1, use_runtime_library, jobs, false);
+
+        printf("Running the instrumented binary to collect a profile...\n");
+#if defined(__clang__)
+        run_pgo_training(bin_file_path, pgo_args, profile_raw_path);
+        char *merge_args[] = {"llvm-profdata", "merge", "-output", profile_data_path, profile_raw_path, NULL};
+        if (run_process(merge_args[0], merge_args, NULL) != 0) {
+            fprintf(stderr, "Merging the profile %s is failed!\n", profile_raw_path);
+            exit(1);
+        }
+#else
+        run_pgo_training(bin_file_path, pgo_args, NULL);
+#endif
+
+        printf("Rebuilding the binary with the collected profile...\n");
+        flags[flags_count++] = profile_use_flag;
+#if !defined(__clang__)
+        flags[flags_count++] = "-fprofile-correction";
+        flags[flags_count++] = "-Wno-missing-profile";
+#endif
+        compile_c_code(c_compiler_path, bin_file_path, extra_flags, flags, flags_count, use_runtime_library, jobs, false);
+    }
+
+    if (!keep) {
+        printf("Cleaning up the temporary files...\n\n");
+    } else {
+        printf("\n");
+    }
+    compiler_free_translation_units();
+
+    printf("Finished compiling.\n\n");
+
+    char bin_file_path_final[PATH_MAX + 4];
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+    if (!string_ends_with(bin_file_path, __KAOS_WINDOWS_EXE_EXT__)) {
+        sprintf(bin_file_path_final, "%s%s", bin_file_path, __KAOS_WINDOWS_EXE_EXT__);
+    } else {
+        sprintf(bin_file_path_final, "%s", bin_file_path);
+    }
+#else
+    sprintf(bin_file_path_final, "%s", bin_file_path);
+#endif
+
+    printf("Binary is ready on: %s\n", bin_file_path_final);
+}
+
+char* last_function_name;
+bool last_function_is_typed;
+
+ASTNode* transpile_functions(ASTNode* ast_node, char *module, FILE *c_fp, unsigned short indent, FILE *h_fp) {
+transpile_functions_label:
+    if (ast_node == NULL) {
+        return ast_node;
+    }
+    char *ast_node_module = malloc(1 + strlen(ast_node->module));
+    strcpy(ast_node_module, ast_node->module);
+    compiler_escape_module(ast_node_module);
+
+    if (strcmp(ast_node_module, module) != 0) {
+        free(ast_node_module);
+        ast_node = ast_node->next;
+        goto transpile_functions_label;
+    }
+    free(ast_node_module);
+
+    if (is_node_function_related(ast_node)) {
+        if (ast_node->depend != NULL) {
+            transpile_functions(ast_node->depend, module, c_fp, indent, h_fp);
+        }
+
+        if (ast_node->right != NULL) {
+            transpile_functions(ast_node->right, module, c_fp, indent, h_fp);
+        }
+
+        if (ast_node->left != NULL) {
             transpile_functions(ast_node->left, module, c_fp, indent, h_fp);
         }
     }
@@ -511,16 +846,38 @@ transpile_functions_label:
         char *function_name = NULL;
         function_name = snprintf_concat_string(function_name, "kaos_function_%s", module);
         function_name = snprintf_concat_string(function_name, "_%s", ast_node->strings[0]);
-        if (!ast_node->dont_transpile && !is_in_array(&transpiled_functions, function_name)) {
+        TypedFunction* typed_function = compiler_get_typed_function_by_node(ast_node);
+        if (typed_function != NULL && !is_in_array(&transpiled_functions, function_name)) {
+            append_to_array(&transpiled_functions, function_name);
+            append_to_array(&transpiled_modules, ast_node->module);
+            compiler_transpile_typed_function(c_fp, h_fp, typed_function, module, indent);
+        } else if (!ast_node->dont_transpile && !is_in_array(&transpiled_functions, function_name)) {
             append_to_array(&transpiled_functions, function_name);
             append_to_array(&transpiled_modules, ast_node->module);
             fprintf(h_fp, "void %s();\n", function_name);
+            bool has_decision = ast_node->next != NULL && ast_node->next->node_type == AST_DECISION_DEFINE;
+            if (instrument_functions)
+                compiler_transpile_instrument_site(c_fp, module, ast_node->strings[0], ast_node);
             fprintf(c_fp, "void %s() {\n", function_name);
+            compiler_transpile_instrument_hook(c_fp, "instrumentEnter", indent);
+            compiler_escape_native_variables(ast_node->right);
+            if (has_decision)
+                compiler_escape_native_variables(ast_node->next->right);
+            compiler_analyze_native_variables(ast_node->child, module, true);
+            compiler_declare_native_variables(c_fp, indent);
+            loop_jump_returns = true;
             transpile_node(ast_node->child, module, c_fp, indent);
+            loop_jump_returns = false;
+            compiler_free_native_variables();
+            // The decision function runs in the same call, so the function is exited from there
+            if (!has_decision)
+                compiler_transpile_instrument_hook(c_fp, "instrumentExit", indent);
             fprintf(c_fp, "}\n\n");
+            compiler_free_instrument_site();
         }
         free(function_name);
         last_function_name = ast_node->strings[0];
+        last_function_is_typed = typed_function != NULL;
     }
 
     char *decision_name;
@@ -548,12 +905,19 @@ transpile_functions_label:
             decision_name = NULL;
             decision_name = snprintf_concat_string(decision_name, "kaos_decision_%s", module);
             decision_name = snprintf_concat_string(decision_name, "_%s", last_function_name);
-            if (!ast_node->dont_transpile && !is_in_array(&transpiled_decisions, decision_name)) {
+            // The decisions of a typed function are part of its C function
+            if (!last_function_is_typed && !ast_node->dont_transpile && !is_in_array(&transpiled_decisions, decision_name)) {
                 append_to_array(&transpiled_decisions, decision_name);
                 fprintf(h_fp, "void %s();\n", decision_name);
                 fprintf(c_fp, "void %s() {\n", decision_name);
+                if (instrument_functions)
+                    instrument_site = compiler_get_instrument_site(module, last_function_name);
+                loop_jump_returns = true;
                 transpile_decisions(ast_node->right, module, c_fp, indent);
+                loop_jump_returns = false;
+                compiler_transpile_instrument_hook(c_fp, "instrumentExit", indent);
                 fprintf(c_fp, "}\n\n");
+                compiler_free_instrument_site();
             }
             free(decision_name);
             break;
@@ -682,9 +1046,10 @@ transpile_decisions_label:
                 default:
                     break;
             }
+            compiler_transpile_instrument_hook(c_fp, "instrumentExit", indent + indent_length);
             fprintf(
                 c_fp,
-                "%*cfreeFunctionReturn(function_call_%llu);\n"
+                "%*cchainFunctionReturn(function_call_%llu);\n"
                 "%*cupdateDecisionSymbolChainScope();\n"
                 "%*cfree(function_call_%llu);\n"
                 "%*creturn;\n"
@@ -713,7 +1078,7 @@ transpile_decisions_label:
             if (ast_node->right->is_transpiled) {
                 fprintf(
                     c_fp,
-                    "%*cif (nested_loop_counter > 0 && %s)\n"
+                    "%*cif (function_call_stack.arr[function_call_stack.size - 1]->is_in_loop && %s)\n"
                     "%*c{\n",
                     indent,
                     ' ',
@@ -724,7 +1089,7 @@ transpile_decisions_label:
             } else {
                 fprintf(
                     c_fp,
-                    "%*cif (nested_loop_counter > 0 && %s)\n"
+                    "%*cif (function_call_stack.arr[function_call_stack.size - 1]->is_in_loop && %s)\n"
                     "%*c{\n",
                     indent,
                     ' ',
@@ -733,12 +1098,16 @@ transpile_decisions_label:
                     ' '
                 );
             }
+            compiler_transpile_instrument_hook(c_fp, "instrumentExit", indent + indent_length);
             fprintf(
                 c_fp,
                 "%*cdecisionBreakLoop();\n"
+                "%*creturn;\n"
                 "%*c}\n",
                 indent + indent_length,
                 ' ',
+                indent + indent_length,
+                ' ',
                 indent,
                 ' '
             );
@@ -747,7 +1116,7 @@ transpile_decisions_label:
             if (ast_node->right->is_transpiled) {
                 fprintf(
                     c_fp,
-                    "%*cif (nested_loop_counter > 0 && %s)\n"
+                    "%*cif (function_call_stack.arr[function_call_stack.size - 1]->is_in_loop && %s)\n"
                     "%*c{\n",
                     indent,
                     ' ',
@@ -758,7 +1127,7 @@ transpile_decisions_label:
             } else {
                 fprintf(
                     c_fp,
-                    "%*cif (nested_loop_counter > 0 && %s)\n"
+                    "%*cif (function_call_stack.arr[function_call_stack.size - 1]->is_in_loop && %s)\n"
                     "%*c{\n",
                     indent,
                     ' ',
@@ -767,12 +1136,16 @@ transpile_decisions_label:
                     ' '
                 );
             }
+            compiler_transpile_instrument_hook(c_fp, "instrumentExit", indent + indent_length);
             fprintf(
                 c_fp,
                 "%*cdecisionContinueLoop();\n"
+                "%*creturn;\n"
                 "%*c}\n",
                 indent + indent_length,
                 ' ',
+                indent + indent_length,
+                ' ',
                 indent,
                 ' '
             );
@@ -801,6 +1174,7 @@ transpile_decisions_label:
                     ' '
                 );
             }
+            compiler_transpile_instrument_hook(c_fp, "instrumentExit", indent + indent_length);
             fprintf(
                 c_fp,
                 "%*creturnSymbol(\"%s\");\n"
@@ -867,7 +1241,7 @@ transpile_decisions_label:
             }
             fprintf(
                 c_fp,
-                "%*cfreeFunctionReturn(function_call_%llu);\n"
+                "%*cchainFunctionReturn(function_call_%llu);\n"
                 "%*cupdateDecisionSymbolChainScope();\n"
                 "%*cfree(function_call_%llu);\n"
                 "%*c} else {\n"
@@ -892,13 +1266,20 @@ transpile_decisions_label:
         case AST_DECISION_MAKE_DEFAULT_BREAK:
             fprintf(
                 c_fp,
-                "%*cif (nested_loop_counter > 0 && function_call_stack.arr[function_call_stack.size - 1] != NULL)\n"
-                "%*c{\n"
-                "%*cdecisionBreakLoop();\n"
-                "%*c}\n",
+                "%*cif (function_call_stack.arr[function_call_stack.size - 1] != NULL && function_call_stack.arr[function_call_stack.size - 1]->is_in_loop)\n"
+                "%*c{\n",
                 indent,
                 ' ',
                 indent,
+                ' '
+            );
+            compiler_transpile_instrument_hook(c_fp, "instrumentExit", indent + indent_length);
+            fprintf(
+                c_fp,
+                "%*cdecisionBreakLoop();\n"
+                "%*creturn;\n"
+                "%*c}\n",
+                indent + indent_length,
                 ' ',
                 indent + indent_length,
                 ' ',
@@ -909,13 +1290,20 @@ transpile_decisions_label:
         case AST_DECISION_MAKE_DEFAULT_CONTINUE:
             fprintf(
                 c_fp,
-                "%*cif (nested_loop_counter > 0 && function_call_stack.arr[function_call_stack.size - 1] != NULL)\n"
-                "%*c{\n"
-                "%*cdecisionContinueLoop();\n"
-                "%*c}\n",
+                "%*cif (function_call_stack.arr[function_call_stack.size - 1] != NULL && function_call_stack.arr[function_call_stack.size - 1]->is_in_loop)\n"
+                "%*c{\n",
                 indent,
                 ' ',
                 indent,
+                ' '
+            );
+            compiler_transpile_instrument_hook(c_fp, "instrumentExit", indent + indent_length);
+            fprintf(
+                c_fp,
+                "%*cdecisionContinueLoop();\n"
+                "%*creturn;\n"
+                "%*c}\n",
+                indent + indent_length,
                 ' ',
                 indent + indent_length,
                 ' ',
@@ -968,6 +1356,15 @@ compiler_register_functions_label:
     }
     free(ast_node_module);
 
+    if (ast_node->node_type >= AST_DEFINE_FUNCTION_BOOL && ast_node->node_type <= AST_DEFINE_FUNCTION_VOID) {
+        if (compiler_add_static_function(ast_node, c_fp, indent)) {
+            ast_node = ast_node->next;
+            goto compiler_register_functions_label;
+        }
+        // The functions of the table so far are registered before this one
+        compiler_register_static_functions(c_fp, indent);
+    }
+
     if (is_node_function_related(ast_node)) {
         if (ast_node->depend != NULL) {
             transpile_node(ast_node->depend, module, c_fp, indent);
@@ -1401,7 +1798,13 @@ transpile_node_label:
     }
 
     if (ast_node->right != NULL) {
+        // The arguments of a direct call are passed to the typed function in C
+        bool is_typed_call = compiler_get_typed_call(ast_node) != NULL;
+        if (is_typed_call)
+            typed_call_arguments_mode = true;
         transpile_node(ast_node->right, module, c_fp, indent);
+        if (is_typed_call)
+            typed_call_arguments_mode = false;
     }
 
     if (ast_node->left != NULL) {
@@ -1422,13 +1825,11 @@ transpile_node_label:
         ||
         (ast_node->node_type == AST_PRINT_FUNCTION_TABLE)
         ||
-        (ast_node->node_type >= AST_FUNCTION_CALL_PARAMETER_BOOL && ast_node->node_type <= AST_FUNCTION_CALL_PARAMETER_DICT)
+        (ast_node->node_type >= AST_FUNCTION_CALL_PARAMETER_BOOL && ast_node->node_type <= AST_FUNCTION_CALL_PARAMETER_DICT && !typed_call_arguments_mode)
         ||
         (ast_node->node_type >= AST_PRINT_FUNCTION_RETURN && ast_node->node_type <= AST_FUNCTION_RETURN)
         ||
         (ast_node->node_type == AST_NESTED_COMPLEX_TRANSITION)
-        ||
-        (ast_node->node_type == AST_JSON_PARSER)
     ) {
         fprintf(c_fp, "%*ckaos_lineno = %d;\n", indent, ' ', ast_node->lineno);
     }
@@ -1443,45 +1844,53 @@ transpile_node_label:
         );
 
     unsigned long long current_loop_counter = 0;
+    NativeVariable* native_variable;
+    char *native_read;
+    ASTNode* next_node;
     switch (ast_node->node_type)
     {
         case AST_START_TIMES_DO:
             compiler_loop_counter++;
-            fprintf(c_fp, "%*cnested_loop_counter++;\n", indent, ' ');
+            current_loop_counter = compiler_loop_counter;
             if (ast_node->right->is_transpiled) {
                 fprintf(
                     c_fp,
-                    "%*cfor (int i = 0; i < %s; i++)\n"
+                    "%*cfor (long long loop_%llu_i = 0, loop_%llu_times = %s; loop_%llu_i < loop_%llu_times; loop_%llu_i++)\n"
                     "%*c{\n",
                     indent,
                     ' ',
+                    current_loop_counter,
+                    current_loop_counter,
                     ast_node->right->transpiled,
+                    current_loop_counter,
+                    current_loop_counter,
+                    current_loop_counter,
                     indent,
                     ' '
                 );
             } else {
                 fprintf(
                     c_fp,
-                    "%*cfor (int i = 0; i < %lld; i++)\n"
+                    "%*cfor (long long loop_%llu_i = 0; loop_%llu_i < %lld; loop_%llu_i++)\n"
                     "%*c{\n",
                     indent,
                     ' ',
+                    current_loop_counter,
+                    current_loop_counter,
                     ast_node->right->value.i,
+                    current_loop_counter,
                     indent,
                     ' '
                 );
             }
-            indent += indent_length;
-            fprintf(c_fp, "%*cif (setjmp(LoopBreak)) break;\n", indent, ' ');
-            fprintf(c_fp, "%*cif (setjmp(LoopContinue)) continue;\n", indent, ' ');
-            ast_node = transpile_node(ast_node->next, module, c_fp, indent);
-            indent -= indent_length;
+            compiler_push_transpiled_loop(ast_node, current_loop_counter, false);
+            ast_node = transpile_node(ast_node->next, module, c_fp, indent + indent_length);
+            compiler_pop_transpiled_loop();
             fprintf(c_fp, "%*c}\n", indent, ' ');
-            fprintf(c_fp, "%*cnested_loop_counter--;\n", indent, ' ');
             break;
         case AST_START_TIMES_DO_INFINITE:
             compiler_loop_counter++;
-            fprintf(c_fp, "%*cnested_loop_counter++;\n", indent, ' ');
+            current_loop_counter = compiler_loop_counter;
             fprintf(
                 c_fp,
                 "%*cwhile (true)\n"
@@ -1491,212 +1900,158 @@ transpile_node_label:
                 indent,
                 ' '
             );
-            indent += indent_length;
-            fprintf(c_fp, "%*cif (setjmp(LoopBreak)) break;\n", indent, ' ');
-            fprintf(c_fp, "%*cif (setjmp(LoopContinue)) continue;\n", indent, ' ');
-            ast_node = transpile_node(ast_node->next, module, c_fp, indent);
-            indent -= indent_length;
+            compiler_push_transpiled_loop(ast_node, current_loop_counter, false);
+            ast_node = transpile_node(ast_node->next, module, c_fp, indent + indent_length);
+            compiler_pop_transpiled_loop();
             fprintf(c_fp, "%*c}\n", indent, ' ');
-            fprintf(c_fp, "%*cnested_loop_counter--;\n", indent, ' ');
             break;
         case AST_START_TIMES_DO_VAR:
             compiler_loop_counter++;
-            fprintf(c_fp, "%*cnested_loop_counter++;\n", indent, ' ');
+            current_loop_counter = compiler_loop_counter;
+            native_variable = compiler_get_native_variable(ast_node->strings[0]);
+            if (native_variable != NULL) {
+                native_read = compiler_read_native_variable(native_variable, V_INT);
+            } else {
+                native_read = snprintf_concat_string(NULL, "getSymbolValueInt(\"%s\")", ast_node->strings[0]);
+            }
             fprintf(
                 c_fp,
-                "%*cfor (int i = 0; i < getSymbolValueInt(\"%s\"); i++)\n"
+                "%*cfor (long long loop_%llu_i = 0, loop_%llu_times = %s; loop_%llu_i < loop_%llu_times; loop_%llu_i++)\n"
                 "%*c{\n",
                 indent,
                 ' ',
-                ast_node->strings[0],
+                current_loop_counter,
+                current_loop_counter,
+                native_read,
+                current_loop_counter,
+                current_loop_counter,
+                current_loop_counter,
                 indent,
                 ' '
             );
-            indent += indent_length;
-            fprintf(c_fp, "%*cif (setjmp(LoopBreak)) break;\n", indent, ' ');
-            fprintf(c_fp, "%*cif (setjmp(LoopContinue)) continue;\n", indent, ' ');
-            ast_node = transpile_node(ast_node->next, module, c_fp, indent);
-            indent -= indent_length;
+            free(native_read);
+            compiler_push_transpiled_loop(ast_node, current_loop_counter, false);
+            ast_node = transpile_node(ast_node->next, module, c_fp, indent + indent_length);
+            compiler_pop_transpiled_loop();
             fprintf(c_fp, "%*c}\n", indent, ' ');
-            fprintf(c_fp, "%*cnested_loop_counter--;\n", indent, ' ');
             break;
         case AST_START_FOREACH:
             compiler_loop_counter++;
             current_loop_counter = compiler_loop_counter;
-            fprintf(c_fp, "%*cnested_loop_counter++;\n", indent, ' ');
             fprintf(
                 c_fp,
                 "%*cSymbol* loop_%llu_list = getSymbol(\"%s\");\n"
                 "%*cif (loop_%llu_list->type != K_LIST) throw_error(E_NOT_A_LIST, \"%s\");\n"
-                "%*cfor (unsigned long i = 0; i < loop_%llu_list->children_count; i++)\n"
-                "%*c{\n"
-                "%*cSymbol* loop_%llu_child = loop_%llu_list->children[i];\n"
-                "%*cSymbol* loop_%llu_clone_symbol = createCloneFromSymbol(\"%s\", loop_%llu_child->type, loop_%llu_child, loop_%llu_child->secondary_type);\n",
+                "%*cfor (unsigned long long loop_%llu_i = 0; loop_%llu_i < loop_%llu_list->children_count; loop_%llu_i++)\n"
+                "%*c{\n",
                 indent,
                 ' ',
-                compiler_loop_counter,
+                current_loop_counter,
                 ast_node->strings[0],
                 indent,
                 ' ',
-                compiler_loop_counter,
+                current_loop_counter,
                 ast_node->strings[0],
                 indent,
                 ' ',
-                compiler_loop_counter,
-                indent,
-                ' ',
-                indent + indent_length,
-                ' ',
-                compiler_loop_counter,
-                compiler_loop_counter,
-                indent + indent_length,
-                ' ',
-                compiler_loop_counter,
-                ast_node->strings[1],
-                compiler_loop_counter,
-                compiler_loop_counter,
-                compiler_loop_counter
-            );
-            indent += indent_length;
-            fprintf(
-                c_fp,
-                "%*cif (setjmp(LoopBreak))\n"
-                "%*c{\n"
-                "%*cremoveSymbol(loop_%llu_clone_symbol);\n"
-                "%*cbreak;\n"
-                "%*c}\n",
-                indent,
-                ' ',
-                indent,
-                ' ',
-                indent + indent_length,
-                ' ',
-                compiler_loop_counter,
-                indent + indent_length,
-                ' ',
-                indent,
-                ' '
-            );
-            fprintf(
-                c_fp,
-                "%*cif (setjmp(LoopContinue))\n"
-                "%*c{\n"
-                "%*cremoveSymbol(loop_%llu_clone_symbol);\n"
-                "%*ccontinue;\n"
-                "%*c}\n",
-                indent,
-                ' ',
-                indent,
-                ' ',
-                indent + indent_length,
-                ' ',
-                compiler_loop_counter,
-                indent + indent_length,
-                ' ',
+                current_loop_counter,
+                current_loop_counter,
+                current_loop_counter,
+                current_loop_counter,
                 indent,
                 ' '
             );
-            ast_node = transpile_node(ast_node->next, module, c_fp, indent);
-            indent -= indent_length;
-            fprintf(c_fp, "%*cremoveSymbol(loop_%llu_clone_symbol);\n", indent + indent_length, ' ', current_loop_counter);
+            // The element of a typed list is read by index into its C local, the rest are cloned into the symbol table
+            native_variable = compiler_get_native_variable(ast_node->strings[1]);
+            if (native_variable != NULL) {
+                fprintf(
+                    c_fp,
+                    "%*ckaos_var_%s = %s(loop_%llu_list->children[loop_%llu_i]);\n",
+                    indent + indent_length,
+                    ' ',
+                    native_variable->name,
+                    native_variable->type == K_BOOL ? "_getSymbolValueBool" : "_getSymbolValueNumber",
+                    current_loop_counter,
+                    current_loop_counter
+                );
+            } else {
+                fprintf(
+                    c_fp,
+                    "%*cSymbol* loop_%llu_child = loop_%llu_list->children[loop_%llu_i];\n"
+                    "%*cSymbol* loop_%llu_clone_symbol = createCloneFromSymbol(\"%s\", loop_%llu_child->type, loop_%llu_child, loop_%llu_child->secondary_type);\n",
+                    indent + indent_length,
+                    ' ',
+                    current_loop_counter,
+                    current_loop_counter,
+                    current_loop_counter,
+                    indent + indent_length,
+                    ' ',
+                    current_loop_counter,
+                    ast_node->strings[1],
+                    current_loop_counter,
+                    current_loop_counter,
+                    current_loop_counter
+                );
+            }
+            compiler_push_transpiled_loop(ast_node, current_loop_counter, native_variable == NULL);
+            next_node = transpile_node(ast_node->next, module, c_fp, indent + indent_length);
+            compiler_pop_transpiled_loop();
+            if (native_variable == NULL)
+                fprintf(c_fp, "%*cremoveSymbol(loop_%llu_clone_symbol);\n", indent + indent_length, ' ', current_loop_counter);
             fprintf(c_fp, "%*c}\n", indent, ' ');
-            fprintf(c_fp, "%*cnested_loop_counter--;\n", indent, ' ');
+            ast_node = next_node;
             break;
         case AST_START_FOREACH_DICT:
             compiler_loop_counter++;
             current_loop_counter = compiler_loop_counter;
-            fprintf(c_fp, "%*cnested_loop_counter++;\n", indent, ' ');
             fprintf(
                 c_fp,
                 "%*cSymbol* loop_%llu_dict = getSymbol(\"%s\");\n"
                 "%*cif (loop_%llu_dict->type != K_DICT) throw_error(E_NOT_A_DICT, \"%s\");\n"
-                "%*cfor (unsigned long i = 0; i < loop_%llu_dict->children_count; i++)\n"
+                "%*cfor (unsigned long long loop_%llu_i = 0; loop_%llu_i < loop_%llu_dict->children_count; loop_%llu_i++)\n"
                 "%*c{\n"
-                "%*cSymbol* loop_%llu_child = loop_%llu_dict->children[i];\n"
+                "%*cSymbol* loop_%llu_child = loop_%llu_dict->children[loop_%llu_i];\n"
                 "%*caddSymbolString(\"%s\", loop_%llu_child->key);\n"
                 "%*cSymbol* loop_%llu_clone_symbol = createCloneFromSymbol(\"%s\", loop_%llu_child->type, loop_%llu_child, loop_%llu_child->secondary_type);\n",
                 indent,
                 ' ',
-                compiler_loop_counter,
+                current_loop_counter,
                 ast_node->strings[0],
                 indent,
                 ' ',
-                compiler_loop_counter,
+                current_loop_counter,
                 ast_node->strings[0],
                 indent,
                 ' ',
-                compiler_loop_counter,
+                current_loop_counter,
+                current_loop_counter,
+                current_loop_counter,
+                current_loop_counter,
                 indent,
                 ' ',
                 indent + indent_length,
                 ' ',
-                compiler_loop_counter,
-                compiler_loop_counter,
+                current_loop_counter,
+                current_loop_counter,
+                current_loop_counter,
                 indent + indent_length,
                 ' ',
                 ast_node->strings[1],
-                compiler_loop_counter,
+                current_loop_counter,
                 indent + indent_length,
                 ' ',
-                compiler_loop_counter,
+                current_loop_counter,
                 ast_node->strings[2],
-                compiler_loop_counter,
-                compiler_loop_counter,
-                compiler_loop_counter
+                current_loop_counter,
+                current_loop_counter,
+                current_loop_counter
             );
-            indent += indent_length;
-            fprintf(
-                c_fp,
-                "%*cif (setjmp(LoopBreak))\n"
-                "%*c{\n"
-                "%*cremoveSymbol(loop_%llu_clone_symbol);\n"
-                "%*cremoveSymbolByName(\"%s\");\n"
-                "%*cbreak;\n"
-                "%*c}\n",
-                indent,
-                ' ',
-                indent,
-                ' ',
-                indent + indent_length,
-                ' ',
-                compiler_loop_counter,
-                indent + indent_length,
-                ' ',
-                ast_node->strings[1],
-                indent + indent_length,
-                ' ',
-                indent,
-                ' '
-            );
-            fprintf(
-                c_fp,
-                "%*cif (setjmp(LoopContinue))\n"
-                "%*c{\n"
-                "%*cremoveSymbol(loop_%llu_clone_symbol);\n"
-                "%*cremoveSymbolByName(\"%s\");\n"
-                "%*ccontinue;\n"
-                "%*c}\n",
-                indent,
-                ' ',
-                indent,
-                ' ',
-                indent + indent_length,
-                ' ',
-                compiler_loop_counter,
-                indent + indent_length,
-                ' ',
-                ast_node->strings[1],
-                indent + indent_length,
-                ' ',
-                indent,
-                ' '
-            );
-            ASTNode* next_node = transpile_node(ast_node->next, module, c_fp, indent);
-            indent -= indent_length;
+            compiler_push_transpiled_loop(ast_node, current_loop_counter, true);
+            next_node = transpile_node(ast_node->next, module, c_fp, indent + indent_length);
+            compiler_pop_transpiled_loop();
             fprintf(c_fp, "%*cremoveSymbol(loop_%llu_clone_symbol);\n", indent + indent_length, ' ', current_loop_counter);
             fprintf(c_fp, "%*cremoveSymbolByName(\"%s\");\n", indent + indent_length, ' ', ast_node->strings[1]);
             fprintf(c_fp, "%*c}\n", indent, ' ');
-            fprintf(c_fp, "%*cnested_loop_counter--;\n", indent, ' ');
             ast_node = next_node;
             break;
         default:
@@ -1710,6 +2065,8 @@ transpile_node_label:
     switch (ast_node->node_type)
     {
         case AST_VAR_CREATE_BOOL:
+            if (compiler_transpile_native_assignment(c_fp, ast_node, indent))
+                break;
             if (ast_node->strings[0] == NULL) {
                 if (ast_node->right->is_transpiled) {
                     fprintf(c_fp, "%*caddSymbolBool(NULL, %s);\n", indent, ' ', ast_node->right->transpiled);
@@ -1725,15 +2082,21 @@ transpile_node_label:
             }
             break;
         case AST_VAR_CREATE_BOOL_VAR:
+            if (compiler_transpile_native_copy(c_fp, ast_node, indent))
+                break;
             fprintf(c_fp, "%*ccreateCloneFromSymbolByName(\"%s\", K_BOOL, \"%s\", K_ANY);\n", indent, ' ', ast_node->strings[0], ast_node->strings[1]);
             break;
         case AST_VAR_CREATE_BOOL_VAR_EL:
             fprintf(c_fp, "%*ccreateCloneFromComplexElement(\"%s\", K_BOOL, \"%s\", K_ANY);\n", indent, ' ', ast_node->strings[0], ast_node->strings[1]);
             break;
         case AST_VAR_CREATE_BOOL_FUNC_RETURN:
+            if (compiler_transpile_typed_call(c_fp, ast_node, indent))
+                break;
             transpile_function_call_create_var(c_fp, ast_node, module, K_BOOL, K_ANY, indent);
             break;
         case AST_VAR_CREATE_NUMBER:
+            if (compiler_transpile_native_assignment(c_fp, ast_node, indent))
+                break;
             if (ast_node->right->is_transpiled) {
                 if (ast_node->right->value_type == V_INT) {
                     if (ast_node->strings[0] == NULL) {
@@ -1765,15 +2128,21 @@ transpile_node_label:
             }
             break;
         case AST_VAR_CREATE_NUMBER_VAR:
+            if (compiler_transpile_native_copy(c_fp, ast_node, indent))
+                break;
             fprintf(c_fp, "%*ccreateCloneFromSymbolByName(\"%s\", K_NUMBER, \"%s\", K_ANY);\n", indent, ' ', ast_node->strings[0], ast_node->strings[1]);
             break;
         case AST_VAR_CREATE_NUMBER_VAR_EL:
             fprintf(c_fp, "%*ccreateCloneFromComplexElement(\"%s\", K_NUMBER, \"%s\", K_ANY);\n", indent, ' ', ast_node->strings[0], ast_node->strings[1]);
             break;
         case AST_VAR_CREATE_NUMBER_FUNC_RETURN:
+            if (compiler_transpile_typed_call(c_fp, ast_node, indent))
+                break;
             transpile_function_call_create_var(c_fp, ast_node, module, K_NUMBER, K_ANY, indent);
             break;
         case AST_VAR_CREATE_STRING:
+            if (compiler_transpile_native_assignment(c_fp, ast_node, indent))
+                break;
             value_s = escape_string_literal_for_transpiler(ast_node->value.s);
             if (ast_node->strings[0] == NULL) {
                 fprintf(c_fp, "%*caddSymbolString(NULL, \"%s\");\n", indent, ' ', value_s);
@@ -1783,12 +2152,16 @@ transpile_node_label:
             free(value_s);
             break;
         case AST_VAR_CREATE_STRING_VAR:
+            if (compiler_transpile_native_copy(c_fp, ast_node, indent))
+                break;
             fprintf(c_fp, "%*ccreateCloneFromSymbolByName(\"%s\", K_STRING, \"%s\", K_ANY);\n", indent, ' ', ast_node->strings[0], ast_node->strings[1]);
             break;
         case AST_VAR_CREATE_STRING_VAR_EL:
             fprintf(c_fp, "%*ccreateCloneFromComplexElement(\"%s\", K_STRING, \"%s\", K_ANY);\n", indent, ' ', ast_node->strings[0], ast_node->strings[1]);
             break;
         case AST_VAR_CREATE_STRING_FUNC_RETURN:
+            if (compiler_transpile_typed_call(c_fp, ast_node, indent))
+                break;
             transpile_function_call_create_var(c_fp, ast_node, module, K_STRING, K_ANY, indent);
             break;
         case AST_VAR_CREATE_ANY_BOOL:
@@ -1976,6 +2349,8 @@ transpile_node_label:
             transpile_function_call_create_var(c_fp, ast_node, module, K_DICT, K_STRING, indent);
             break;
         case AST_VAR_UPDATE_BOOL:
+            if (compiler_transpile_native_assignment(c_fp, ast_node, indent))
+                break;
             if (ast_node->right->is_transpiled) {
                 fprintf(c_fp, "%*cupdateSymbolBool(\"%s\", %s);\n", indent, ' ', ast_node->strings[0], ast_node->right->transpiled);
             } else {
@@ -1983,6 +2358,8 @@ transpile_node_label:
             }
             break;
         case AST_VAR_UPDATE_NUMBER:
+            if (compiler_transpile_native_assignment(c_fp, ast_node, indent))
+                break;
             if (ast_node->right->value_type == V_INT) {
                 if (ast_node->right->is_transpiled) {
                     fprintf(c_fp, "%*cupdateSymbolInt(\"%s\", %s);\n", indent, ' ', ast_node->strings[0], ast_node->right->transpiled);
@@ -1998,6 +2375,8 @@ transpile_node_label:
             }
             break;
         case AST_VAR_UPDATE_STRING:
+            if (compiler_transpile_native_assignment(c_fp, ast_node, indent))
+                break;
             value_s = escape_string_literal_for_transpiler(ast_node->value.s);
             fprintf(c_fp, "%*cupdateSymbolString(\"%s\", \"%s\");\n", indent, ' ', ast_node->strings[0], value_s);
             free(value_s);
@@ -2027,12 +2406,16 @@ transpile_node_label:
             );
             break;
         case AST_VAR_UPDATE_VAR:
+            if (compiler_transpile_native_copy(c_fp, ast_node, indent))
+                break;
             fprintf(c_fp, "%*cupdateSymbolByClonningName(\"%s\", \"%s\");\n", indent, ' ', ast_node->strings[0], ast_node->strings[1]);
             break;
         case AST_VAR_UPDATE_VAR_EL:
             fprintf(c_fp, "%*cupdateSymbolByClonningComplexElement(\"%s\", \"%s\");\n", indent, ' ', ast_node->strings[0], ast_node->strings[1]);
             break;
         case AST_VAR_UPDATE_FUNC_RETURN:
+            if (compiler_transpile_typed_call(c_fp, ast_node, indent))
+                break;
             compiler_function_counter++;
             switch (ast_node->strings_size)
             {
@@ -2079,6 +2462,8 @@ transpile_node_label:
             );
             break;
         case AST_RETURN_VAR:
+            if (compiler_transpile_native_return(c_fp, ast_node, indent))
+                break;
             fprintf(c_fp, "%*creturnSymbol(\"%s\");\n", indent, ' ', ast_node->strings[0]);
             break;
         case AST_PRINT_COMPLEX_EL:
@@ -2218,6 +2603,8 @@ transpile_node_label:
             );
             break;
         case AST_PRINT_VAR:
+            if (compiler_transpile_native_print(c_fp, ast_node, "\\n", indent))
+                break;
             fprintf(c_fp, "%*cprintSymbolValueEndWithNewLine(getSymbol(\"%s\"), false, true);\n", indent, ' ', ast_node->strings[0]);
             break;
         case AST_PRINT_VAR_EL:
@@ -2261,10 +2648,17 @@ transpile_node_label:
             free(value_s);
             break;
         case AST_PRINT_INTERACTIVE_EXPRESSION:
-            if (ast_node->right->node_type >= AST_VAR_EXPRESSION_INCREMENT && ast_node->right->node_type <= AST_VAR_EXPRESSION_ASSIGN_INCREMENT)
-                fprintf(c_fp, "%*c%s;\n", indent, ' ', ast_node->right->transpiled);
+            if (ast_node->right->node_type >= AST_VAR_EXPRESSION_INCREMENT && ast_node->right->node_type <= AST_VAR_EXPRESSION_ASSIGN_INCREMENT) {
+                // A native increment is an expression, not a call
+                if (ast_node->right->strings_size > 0 && compiler_get_native_variable(ast_node->right->strings[0]) != NULL)
+                    fprintf(c_fp, "%*c(void) %s;\n", indent, ' ', ast_node->right->transpiled);
+                else
+                    fprintf(c_fp, "%*c%s;\n", indent, ' ', ast_node->right->transpiled);
+            }
             break;
         case AST_ECHO_VAR:
+            if (compiler_transpile_native_print(c_fp, ast_node, "", indent))
+                break;
             fprintf(c_fp, "%*cprintSymbolValueEndWith(getSymbol(\"%s\"), \"\", false, true);\n", indent, ' ', ast_node->strings[0]);
             break;
         case AST_ECHO_VAR_EL:
@@ -2303,6 +2697,8 @@ transpile_node_label:
             free(value_s);
             break;
         case AST_PRETTY_PRINT_VAR:
+            if (compiler_transpile_native_print(c_fp, ast_node, "\\n", indent))
+                break;
             fprintf(c_fp, "%*cprintSymbolValueEndWithNewLine(getSymbol(\"%s\"), true, true);\n", indent, ' ', ast_node->strings[0]);
             break;
         case AST_PRETTY_PRINT_VAR_EL:
@@ -2327,6 +2723,8 @@ transpile_node_label:
             );
             break;
         case AST_PRETTY_ECHO_VAR:
+            if (compiler_transpile_native_print(c_fp, ast_node, "", indent))
+                break;
             fprintf(c_fp, "%*cprintSymbolValueEndWith(getSymbol(\"%s\"), \"\", true, true);\n", indent, ' ', ast_node->strings[0]);
             break;
         case AST_PRETTY_ECHO_VAR_EL:
@@ -2410,7 +2808,8 @@ transpile_node_label:
             ast_node->value_type = V_INT;
             break;
         case AST_VAR_EXPRESSION_VALUE:
-            setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "getSymbolValueInt(\"%s\")", ast_node->strings[0]));
+            if (!compiler_transpile_native_read(ast_node, V_INT))
+                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "getSymbolValueInt(\"%s\")", ast_node->strings[0]));
             ast_node->value_type = V_INT;
             break;
         case AST_VAR_EXPRESSION_INCREMENT:
@@ -2430,13 +2829,17 @@ transpile_node_label:
             ast_node->value_type = V_INT;
             break;
         case AST_VAR_EXPRESSION_INCREMENT_ASSIGN:
-            setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "incrementThenAssign(\"%s\"", ast_node->strings[0]));
-            setASTNodeTranspiled(ast_node, snprintf_concat_int(ast_node->transpiled, ", %lld)", ast_node->right->value.i));
+            if (!compiler_transpile_native_increment(ast_node, false)) {
+                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "incrementThenAssign(\"%s\"", ast_node->strings[0]));
+                setASTNodeTranspiled(ast_node, snprintf_concat_int(ast_node->transpiled, ", %lld)", ast_node->right->value.i));
+            }
             ast_node->value_type = V_INT;
             break;
         case AST_VAR_EXPRESSION_ASSIGN_INCREMENT:
-            setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "assignThenIncrement(\"%s\"", ast_node->strings[0]));
-            setASTNodeTranspiled(ast_node, snprintf_concat_int(ast_node->transpiled, ", %lld)", ast_node->right->value.i));
+            if (!compiler_transpile_native_increment(ast_node, true)) {
+                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "assignThenIncrement(\"%s\"", ast_node->strings[0]));
+                setASTNodeTranspiled(ast_node, snprintf_concat_int(ast_node->transpiled, ", %lld)", ast_node->right->value.i));
+            }
             ast_node->value_type = V_INT;
             break;
         case AST_MIXED_EXPRESSION_PLUS:
@@ -2508,7 +2911,8 @@ transpile_node_label:
             ast_node->value_type = V_FLOAT;
             break;
         case AST_VAR_MIXED_EXPRESSION_VALUE:
-            setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "getSymbolValueFloat(\"%s\")", ast_node->strings[0]));
+            if (!compiler_transpile_native_read(ast_node, V_FLOAT))
+                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "getSymbolValueFloat(\"%s\")", ast_node->strings[0]));
             ast_node->value_type = V_FLOAT;
             break;
         case AST_BOOLEAN_EXPRESSION_REL_EQUAL:
@@ -2817,6 +3221,8 @@ transpile_node_label:
                 ast_node->value.b = ast_node->left->value.i || ast_node->right->value.f;
             break;
         case AST_BOOLEAN_EXPRESSION_REL_EQUAL_UNKNOWN:
+            if (compiler_transpile_native_comparison(ast_node, "=="))
+                break;
             setASTNodeTranspiled(
                 ast_node,
                 snprintf_concat_string(
@@ -2835,6 +3241,8 @@ transpile_node_label:
             );
             break;
         case AST_BOOLEAN_EXPRESSION_REL_NOT_EQUAL_UNKNOWN:
+            if (compiler_transpile_native_comparison(ast_node, "!="))
+                break;
             setASTNodeTranspiled(
                 ast_node,
                 snprintf_concat_string(
@@ -2853,6 +3261,8 @@ transpile_node_label:
             );
             break;
         case AST_BOOLEAN_EXPRESSION_REL_GREAT_UNKNOWN:
+            if (compiler_transpile_native_comparison(ast_node, ">"))
+                break;
             setASTNodeTranspiled(
                 ast_node,
                 snprintf_concat_string(
@@ -2871,6 +3281,8 @@ transpile_node_label:
             );
             break;
         case AST_BOOLEAN_EXPRESSION_REL_SMALL_UNKNOWN:
+            if (compiler_transpile_native_comparison(ast_node, "<"))
+                break;
             setASTNodeTranspiled(
                 ast_node,
                 snprintf_concat_string(
@@ -2889,6 +3301,8 @@ transpile_node_label:
             );
             break;
         case AST_BOOLEAN_EXPRESSION_REL_GREAT_EQUAL_UNKNOWN:
+            if (compiler_transpile_native_comparison(ast_node, ">="))
+                break;
             setASTNodeTranspiled(
                 ast_node,
                 snprintf_concat_string(
@@ -2907,6 +3321,8 @@ transpile_node_label:
             );
             break;
         case AST_BOOLEAN_EXPRESSION_REL_SMALL_EQUAL_UNKNOWN:
+            if (compiler_transpile_native_comparison(ast_node, "<="))
+                break;
             setASTNodeTranspiled(
                 ast_node,
                 snprintf_concat_string(
@@ -2925,7 +3341,8 @@ transpile_node_label:
             );
             break;
         case AST_VAR_BOOLEAN_EXPRESSION_VALUE:
-            setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "getSymbolValueBool(\"%s\")", ast_node->strings[0]));
+            if (!compiler_transpile_native_read(ast_node, V_BOOL))
+                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "getSymbolValueBool(\"%s\")", ast_node->strings[0]));
             break;
         case AST_DELETE_VAR:
             fprintf(c_fp, "%*cremoveSymbolByName(\"%s\");\n", indent, ' ', ast_node->strings[0]);
@@ -3268,9 +3685,13 @@ transpile_node_label:
         case AST_FUNCTION_CALL_PARAMETERS_START:
             break;
         case AST_FUNCTION_CALL_PARAMETER_BOOL:
+            if (typed_call_arguments_mode)
+                break;
             fprintf(c_fp, "%*caddFunctionCallParameterBool(%s);\n", indent, ' ', ast_node->right->value.b ? "true" : "false");
             break;
         case AST_FUNCTION_CALL_PARAMETER_NUMBER:
+            if (typed_call_arguments_mode)
+                break;
             if (ast_node->right->is_transpiled) {
                 if (ast_node->right->value_type == V_INT) {
                     fprintf(c_fp, "%*caddFunctionCallParameterInt(%s);\n", indent, ' ', ast_node->right->transpiled);
@@ -3286,9 +3707,15 @@ transpile_node_label:
             }
             break;
         case AST_FUNCTION_CALL_PARAMETER_STRING:
+            if (typed_call_arguments_mode)
+                break;
             fprintf(c_fp, "%*caddFunctionCallParameterString(\"%s\");\n", indent, ' ', ast_node->value.s);
             break;
         case AST_FUNCTION_CALL_PARAMETER_VAR:
+            if (typed_call_arguments_mode)
+                break;
+            if (compiler_transpile_native_parameter(c_fp, ast_node, indent))
+                break;
             fprintf(c_fp, "%*caddFunctionCallParameterSymbol(\"%s\");\n", indent, ' ', ast_node->strings[0]);
             break;
         case AST_FUNCTION_CALL_PARAMETER_LIST:
@@ -3314,6 +3741,8 @@ transpile_node_label:
             );
             break;
         case AST_PRINT_FUNCTION_RETURN:
+            if (compiler_transpile_typed_call(c_fp, ast_node, indent))
+                break;
             if (ast_node->strings_size > 1) {
                 _module = ast_node->strings[1];
             }
@@ -3340,6 +3769,8 @@ transpile_node_label:
             );
             break;
         case AST_ECHO_FUNCTION_RETURN:
+            if (compiler_transpile_typed_call(c_fp, ast_node, indent))
+                break;
             if (ast_node->strings_size > 1) {
                 _module = ast_node->strings[1];
             }
@@ -3366,6 +3797,8 @@ transpile_node_label:
             );
             break;
         case AST_PRETTY_PRINT_FUNCTION_RETURN:
+            if (compiler_transpile_typed_call(c_fp, ast_node, indent))
+                break;
             if (ast_node->strings_size > 1) {
                 _module = ast_node->strings[1];
             }
@@ -3392,6 +3825,8 @@ transpile_node_label:
             );
             break;
         case AST_PRETTY_ECHO_FUNCTION_RETURN:
+            if (compiler_transpile_typed_call(c_fp, ast_node, indent))
+                break;
             if (ast_node->strings_size > 1) {
                 _module = ast_node->strings[1];
             }
@@ -3418,6 +3853,8 @@ transpile_node_label:
             );
             break;
         case AST_FUNCTION_RETURN:
+            if (compiler_transpile_typed_call(c_fp, ast_node, indent))
+                break;
             if (ast_node->strings_size > 1) {
                 _module = ast_node->strings[1];
             }
@@ -3446,22 +3883,6 @@ transpile_node_label:
         case AST_NESTED_COMPLEX_TRANSITION:
             fprintf(c_fp, "%*creverseComplexMode();\n", indent, ' ');
             break;
-        case AST_JSON_PARSER:
-            compiler_symbol_counter++;
-            fprintf(
-                c_fp,
-                "%*creverseComplexMode();\n"
-                "%*cSymbol* symbol_%llu = finishComplexMode(NULL, K_ANY);\n"
-                "%*creturnVariable(symbol);\n",
-                indent,
-                ' ',
-                indent,
-                ' ',
-                compiler_symbol_counter,
-                indent,
-                ' '
-            );
-            break;
         default:
             break;
     }
@@ -3545,154 +3966,2025 @@ bool transpile_common_operator(ASTNode* ast_node, char *operator, enum ValueType
         }
         return true;
     }
-    return false;
+    return false;
+}
+
+bool transpile_common_mixed_operator(ASTNode* ast_node, char *operator) {
+    if ((ast_node->left != NULL && ast_node->left->is_transpiled) || (ast_node->right != NULL && ast_node->right->is_transpiled)) {
+        if (ast_node->left != NULL && ast_node->left->is_transpiled) {
+            if (ast_node->left->value_type == V_INT) {
+                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "(long double) %s", ast_node->left->transpiled));
+            } else {
+                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "%s", ast_node->left->transpiled));
+            }
+        } else {
+            if (ast_node->left->value_type == V_INT) {
+                setASTNodeTranspiled(ast_node, snprintf_concat_int(ast_node->transpiled, "%lld", (long double) ast_node->left->value.i));
+            } else {
+                setASTNodeTranspiled(ast_node, snprintf_concat_float(ast_node->transpiled, "%Lf", ast_node->left->value.f));
+            }
+        }
+        setASTNodeTranspiled(ast_node, strcat_ext(ast_node->transpiled, " "));
+        setASTNodeTranspiled(ast_node, strcat_ext(ast_node->transpiled, operator));
+        setASTNodeTranspiled(ast_node, strcat_ext(ast_node->transpiled, " "));
+        if (ast_node->right != NULL && ast_node->right->is_transpiled) {
+            if (ast_node->right->value_type == V_INT) {
+                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "(long double) %s", ast_node->right->transpiled));
+            } else {
+                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "%s", ast_node->right->transpiled));
+            }
+        } else {
+            if (ast_node->right->value_type == V_INT) {
+                setASTNodeTranspiled(ast_node, snprintf_concat_int(ast_node->transpiled, "%lld", (long double) ast_node->right->value.i));
+            } else {
+                setASTNodeTranspiled(ast_node, snprintf_concat_float(ast_node->transpiled, "%Lf", ast_node->right->value.f));
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+void transpile_function_call(FILE *c_fp, char *module, char *name, unsigned short indent) {
+    fprintf(
+        c_fp,
+        "%*cfunction_call_%llu->lineno = kaos_lineno;\n",
+        indent,
+        ' ',
+        compiler_function_counter
+    );
+    if (transpiled_loops_size > 0)
+        fprintf(c_fp, "%*cfunction_call_%llu->is_in_loop = true;\n", indent, ' ', compiler_function_counter);
+    char *module_context = compiler_getFunctionModuleContext(name, module);
+    if (!isFunctionFromDynamicLibrary(name, module))
+        fprintf(c_fp, "%*ckaos_function_%s_%s();\n", indent, ' ', module_context, name);
+
+    _Function* function = NULL;
+    if (
+        module == NULL
+        &&
+        transpiled_modules.size > 0
+        &&
+        strcmp(transpiled_modules.arr[transpiled_modules.size - 1], "") != 0
+    ) {
+        function = getFunctionByModuleContext(name, transpiled_modules.arr[transpiled_modules.size - 1]);
+    } else {
+        function = getFunction(name, module);
+    }
+    bool has_decision = function->decision_node != NULL && compiler_get_typed_function(function) == NULL;
+    if (has_decision) {
+        fprintf(c_fp, "%*cif (loop_jump == LOOP_JUMP_NONE) kaos_decision_%s_%s();\n", indent, ' ', module_context, name);
+    }
+    free(module_context);
+    fprintf(
+        c_fp,
+        "%*ccallFunctionCleanUp(function_call_%llu, %s);\n",
+        indent,
+        ' ',
+        compiler_function_counter,
+        has_decision ? "true" : "false"
+    );
+    transpile_loop_jump(c_fp, indent);
+}
+
+void transpile_function_call_decision(FILE *c_fp, char *module_context, char* module, char *name, unsigned short indent) {
+    fprintf(
+        c_fp,
+        "%*cfunction_call_%llu->lineno = kaos_lineno;\n",
+        indent,
+        ' ',
+        compiler_function_counter
+    );
+    if (!isFunctionFromDynamicLibraryByModuleContext(name, module_context))
+        fprintf(c_fp, "%*ckaos_function_%s_%s();\n", indent, ' ', module, name);
+    _Function* function = getFunctionByModuleContext(name, module_context);
+    bool has_decision = function->decision_node != NULL && compiler_get_typed_function(function) == NULL;
+    if (has_decision) {
+        fprintf(c_fp, "%*cif (loop_jump == LOOP_JUMP_NONE) kaos_decision_%s_%s();\n", indent, ' ', module, name);
+    }
+    fprintf(
+        c_fp,
+        "%*ccallFunctionCleanUp(function_call_%llu, %s);\n",
+        indent,
+        ' ',
+        compiler_function_counter,
+        has_decision ? "true" : "false"
+    );
+    transpile_loop_jump(c_fp, indent);
+}
+
+void compiler_push_transpiled_loop(ASTNode* ast_node, unsigned long long id, bool has_element_symbol) {
+    transpiled_loops = realloc(transpiled_loops, sizeof(TranspiledLoop) * ++transpiled_loops_size);
+    transpiled_loops[transpiled_loops_size - 1].id = id;
+    transpiled_loops[transpiled_loops_size - 1].ast_node = ast_node;
+    transpiled_loops[transpiled_loops_size - 1].has_element_symbol = has_element_symbol;
+}
+
+void compiler_pop_transpiled_loop() {
+    if (--transpiled_loops_size > 0)
+        return;
+    free(transpiled_loops);
+    transpiled_loops = NULL;
+}
+
+// A break or continue decision of the called function, or of a function
+// called by it, comes back to the call site as loop_jump. The innermost
+// loop of the C function acts on it, otherwise the C function returns to
+// its own call site, until the loop that the call is in is reached.
+void transpile_loop_jump(FILE *c_fp, unsigned short indent) {
+    if (transpiled_loops_size == 0) {
+        if (!loop_jump_returns)
+            return;
+        fprintf(c_fp, "%*cif (loop_jump != LOOP_JUMP_NONE)\n", indent, ' ');
+        fprintf(c_fp, "%*c{\n", indent, ' ');
+        compiler_transpile_instrument_hook(c_fp, "instrumentExit", indent + indent_length);
+        fprintf(c_fp, "%*creturn;\n", indent + indent_length, ' ');
+        fprintf(c_fp, "%*c}\n", indent, ' ');
+        return;
+    }
+
+    TranspiledLoop* loop = &transpiled_loops[transpiled_loops_size - 1];
+    fprintf(c_fp, "%*cif (loop_jump != LOOP_JUMP_NONE)\n", indent, ' ');
+    fprintf(c_fp, "%*c{\n", indent, ' ');
+    if (loop->has_element_symbol)
+        fprintf(c_fp, "%*cremoveSymbol(loop_%llu_clone_symbol);\n", indent + indent_length, ' ', loop->id);
+    if (loop->ast_node->node_type == AST_START_FOREACH_DICT)
+        fprintf(c_fp, "%*cremoveSymbolByName(\"%s\");\n", indent + indent_length, ' ', loop->ast_node->strings[1]);
+    fprintf(
+        c_fp,
+        "%*cif (loop_jump == LOOP_JUMP_BREAK)\n"
+        "%*c{\n"
+        "%*cloop_jump = LOOP_JUMP_NONE;\n"
+        "%*cbreak;\n"
+        "%*c}\n"
+        "%*cloop_jump = LOOP_JUMP_NONE;\n"
+        "%*ccontinue;\n"
+        "%*c}\n",
+        indent + indent_length,
+        ' ',
+        indent + indent_length,
+        ' ',
+        indent + indent_length * 2,
+        ' ',
+        indent + indent_length * 2,
+        ' ',
+        indent + indent_length,
+        ' ',
+        indent + indent_length,
+        ' ',
+        indent + indent_length,
+        ' ',
+        indent,
+        ' '
+    );
+}
+
+void transpile_function_call_create_var(FILE *c_fp, ASTNode* ast_node, char *module, enum Type type1, enum Type type2, unsigned short indent) {
+    compiler_function_counter++;
+    switch (ast_node->strings_size)
+    {
+        case 2:
+            fprintf(
+                c_fp,
+                "%*cFunctionCall* function_call_%llu = callFunction(\"%s\", NULL);\n",
+                indent,
+                ' ',
+                compiler_function_counter,
+                ast_node->strings[1]
+            );
+            transpile_function_call(c_fp, NULL, ast_node->strings[1], indent);
+            break;
+        case 3:
+            fprintf(
+                c_fp,
+                "%*cFunctionCall* function_call_%llu = callFunction(\"%s\", \"%s\");\n",
+                indent,
+                ' ',
+                compiler_function_counter,
+                ast_node->strings[2],
+                ast_node->strings[1]
+            );
+            transpile_function_call(c_fp, ast_node->strings[1], ast_node->strings[2], indent);
+            break;
+        default:
+            break;
+    }
+    fprintf(
+        c_fp,
+        "%*ccreateCloneFromFunctionReturn(\"%s\", %s, function_call_%llu, %s);\n"
+        "%*cupdateDecisionSymbolChainScope();\n"
+        "%*cfree(function_call_%llu);\n",
+        indent,
+        ' ',
+        ast_node->strings[0],
+        type_strings[type1],
+        compiler_function_counter,
+        type_strings[type2],
+        indent,
+        ' ',
+        indent,
+        ' ',
+        compiler_function_counter
+    );
+}
+
+bool compiler_has_node_type(ASTNode* ast_node, enum ASTNodeType node_type) {
+    while (ast_node != NULL) {
+        if (ast_node->node_type == node_type)
+            return true;
+        if (
+            compiler_has_node_type(ast_node->depend, node_type) ||
+            compiler_has_node_type(ast_node->right, node_type) ||
+            compiler_has_node_type(ast_node->left, node_type) ||
+            compiler_has_node_type(ast_node->child, node_type)
+        )
+            return true;
+        ast_node = ast_node->next;
+    }
+    return false;
+}
+
+static bool is_node_function_call(ASTNode* ast_node) {
+    switch (ast_node->node_type)
+    {
+        case AST_VAR_CREATE_BOOL_FUNC_RETURN:
+        case AST_VAR_CREATE_NUMBER_FUNC_RETURN:
+        case AST_VAR_CREATE_STRING_FUNC_RETURN:
+        case AST_VAR_CREATE_ANY_FUNC_RETURN:
+        case AST_VAR_CREATE_LIST_FUNC_RETURN:
+        case AST_VAR_CREATE_DICT_FUNC_RETURN:
+        case AST_VAR_CREATE_BOOL_LIST_FUNC_RETURN:
+        case AST_VAR_CREATE_BOOL_DICT_FUNC_RETURN:
+        case AST_VAR_CREATE_NUMBER_LIST_FUNC_RETURN:
+        case AST_VAR_CREATE_NUMBER_DICT_FUNC_RETURN:
+        case AST_VAR_CREATE_STRING_LIST_FUNC_RETURN:
+        case AST_VAR_CREATE_STRING_DICT_FUNC_RETURN:
+        case AST_VAR_UPDATE_FUNC_RETURN:
+        case AST_COMPLEX_EL_UPDATE_FUNC_RETURN:
+            return true;
+        default:
+            return ast_node->node_type >= AST_PRINT_FUNCTION_RETURN && ast_node->node_type <= AST_FUNCTION_RETURN;
+    }
+}
+
+static NativeVariable* find_native_variable(char *name) {
+    for (unsigned i = 0; i < native_variables_size; i++) {
+        if (strcmp(native_variables[i].name, name) == 0)
+            return &native_variables[i];
+    }
+    return NULL;
+}
+
+static NativeVariable* add_native_variable(char *name, enum Type type, bool is_escaped) {
+    native_variables = realloc(native_variables, sizeof(NativeVariable) * ++native_variables_size);
+    NativeVariable* variable = &native_variables[native_variables_size - 1];
+    variable->name = name;
+    variable->type = type;
+    variable->is_int = false;
+    variable->is_float = false;
+    variable->is_read = false;
+    variable->is_escaped = is_escaped;
+    variable->is_parameter = false;
+    variable->is_loop_element = false;
+    variable->is_out_of_scope = false;
+    return variable;
+}
+
+static void escape_native_variable(char *name) {
+    NativeVariable* variable = find_native_variable(name);
+    if (variable == NULL) {
+        add_native_variable(name, K_ANY, true);
+        return;
+    }
+    variable->is_escaped = true;
+}
+
+// Only the first creation, outside of any loop, can become a C local. The
+// rest keep the runtime errors of a redefinition to the symbol table.
+static void declare_native_variable(char *name, enum Type type, unsigned depth) {
+    if (depth > 0 || find_native_variable(name) != NULL) {
+        escape_native_variable(name);
+        return;
+    }
+    add_native_variable(name, type, false);
+}
+
+static void read_native_variable(char *name, bool is_numeric) {
+    NativeVariable* variable = find_native_variable(name);
+    if (variable == NULL) {
+        add_native_variable(name, K_ANY, true);
+        return;
+    }
+    // The element of a foreach is undefined after the loop
+    if (variable->is_out_of_scope)
+        variable->is_escaped = true;
+    variable->is_read = true;
+    if (is_numeric && variable->type == K_STRING)
+        variable->is_escaped = true;
+}
+
+static void assign_native_variable(char *name, enum Type type, enum ValueType value_type) {
+    NativeVariable* variable = find_native_variable(name);
+    if (variable == NULL) {
+        add_native_variable(name, K_ANY, true);
+        return;
+    }
+    if (variable->type != type || variable->is_out_of_scope) {
+        variable->is_escaped = true;
+        return;
+    }
+    if (type != K_NUMBER)
+        return;
+    // V_VOID stands for a number that is not known to be an integer or a float until run time
+    if (value_type != V_FLOAT)
+        variable->is_int = true;
+    if (value_type != V_INT)
+        variable->is_float = true;
+}
+
+static void copy_native_variable(char *target, char *source) {
+    NativeVariable* target_variable = find_native_variable(target);
+    NativeVariable* source_variable = find_native_variable(source);
+    if (target_variable == NULL || source_variable == NULL)
+        return;
+    native_variable_copies = realloc(native_variable_copies, sizeof(NativeVariableCopy) * ++native_variable_copies_size);
+    native_variable_copies[native_variable_copies_size - 1].target = target_variable - native_variables;
+    native_variable_copies[native_variable_copies_size - 1].source = source_variable - native_variables;
+}
+
+static void add_native_list(char *name, enum Type type) {
+    for (unsigned i = 0; i < native_lists_size; i++) {
+        if (strcmp(native_lists[i].name, name) != 0)
+            continue;
+        if (native_lists[i].type != type)
+            native_lists[i].type = K_ANY;
+        return;
+    }
+    native_lists = realloc(native_lists, sizeof(NativeList) * ++native_lists_size);
+    native_lists[native_lists_size - 1].name = name;
+    native_lists[native_lists_size - 1].type = type;
+}
+
+static enum Type get_native_list_type(char *name) {
+    for (unsigned i = 0; i < native_lists_size; i++) {
+        if (strcmp(native_lists[i].name, name) == 0)
+            return native_lists[i].type;
+    }
+    return K_ANY;
+}
+
+// A typed list keeps the type of its elements at run time, so a creation of
+// it is enough to know the type of the element of a foreach over it
+static void scan_native_list(ASTNode* ast_node) {
+    switch (ast_node->node_type)
+    {
+        case AST_VAR_CREATE_BOOL_LIST:
+        case AST_VAR_CREATE_BOOL_LIST_VAR:
+        case AST_VAR_CREATE_BOOL_LIST_FUNC_RETURN:
+            add_native_list(ast_node->strings[0], K_BOOL);
+            break;
+        case AST_VAR_CREATE_NUMBER_LIST:
+        case AST_VAR_CREATE_NUMBER_LIST_VAR:
+        case AST_VAR_CREATE_NUMBER_LIST_FUNC_RETURN:
+            add_native_list(ast_node->strings[0], K_NUMBER);
+            break;
+        default:
+            if (ast_node->node_type >= AST_VAR_CREATE_BOOL && ast_node->node_type <= AST_VAR_CREATE_STRING_DICT_FUNC_RETURN)
+                add_native_list(ast_node->strings[0], K_ANY);
+            break;
+    }
+}
+
+// The element of a foreach is created on each iteration, so unlike the other
+// variables it can become a C local inside a loop, as long as all of its
+// creations are the elements of the lists of the same type
+static void declare_native_loop_element(char *name, char *list) {
+    enum Type type = get_native_list_type(list);
+    NativeVariable* variable = find_native_variable(name);
+    if (type != K_BOOL && type != K_NUMBER) {
+        escape_native_variable(name);
+        return;
+    }
+    if (variable == NULL) {
+        variable = add_native_variable(name, type, false);
+        variable->is_loop_element = true;
+    } else if (!variable->is_loop_element || !variable->is_out_of_scope || variable->type != type) {
+        variable->is_escaped = true;
+        return;
+    }
+    variable->is_out_of_scope = false;
+    if (type == K_NUMBER)
+        assign_native_variable(name, K_NUMBER, V_VOID);
+
+    native_loop_elements = realloc(native_loop_elements, sizeof(NativeLoopElement) * ++native_loop_elements_size);
+    native_loop_elements[native_loop_elements_size - 1].variable = variable - native_variables;
+    native_loop_elements[native_loop_elements_size - 1].list = list;
+    native_loop_elements[native_loop_elements_size - 1].type = type;
+}
+
+static void end_native_loop_element(char *name) {
+    NativeVariable* variable = find_native_variable(name);
+    if (variable != NULL && variable->is_loop_element)
+        variable->is_out_of_scope = true;
+}
+
+// Mirrors the value type transpile_node gives to the right hand side of a number assignment
+static enum ValueType predict_number_value_type(ASTNode* ast_node) {
+    switch (ast_node->node_type)
+    {
+        case AST_EXPRESSION_VALUE:
+        case AST_MIXED_EXPRESSION_VALUE:
+            return ast_node->value_type == V_INT || ast_node->value_type == V_FLOAT ? ast_node->value_type : V_VOID;
+        case AST_EXPRESSION_PLUS:
+        case AST_EXPRESSION_MINUS:
+        case AST_EXPRESSION_MULTIPLY:
+        case AST_EXPRESSION_BITWISE_AND:
+        case AST_EXPRESSION_BITWISE_OR:
+        case AST_EXPRESSION_BITWISE_XOR:
+        case AST_EXPRESSION_BITWISE_NOT:
+        case AST_EXPRESSION_BITWISE_LEFT_SHIFT:
+        case AST_EXPRESSION_BITWISE_RIGHT_SHIFT:
+        case AST_VAR_EXPRESSION_VALUE:
+        case AST_VAR_EXPRESSION_INCREMENT:
+        case AST_VAR_EXPRESSION_DECREMENT:
+        case AST_VAR_EXPRESSION_INCREMENT_ASSIGN:
+        case AST_VAR_EXPRESSION_ASSIGN_INCREMENT:
+            return V_INT;
+        case AST_MIXED_EXPRESSION_PLUS:
+        case AST_MIXED_EXPRESSION_MINUS:
+        case AST_MIXED_EXPRESSION_MULTIPLY:
+        case AST_VAR_MIXED_EXPRESSION_VALUE:
+            return V_FLOAT;
+        default:
+            return V_VOID;
+    }
+}
+
+static bool has_increment(ASTNode* ast_node) {
+    if (ast_node == NULL)
+        return false;
+    if (ast_node->node_type >= AST_VAR_EXPRESSION_INCREMENT && ast_node->node_type <= AST_VAR_EXPRESSION_ASSIGN_INCREMENT)
+        return true;
+    return has_increment(ast_node->right) || has_increment(ast_node->left);
+}
+
+// Flattens the parameters of a function definition or the arguments of a call into source order
+static void flatten_parameters(ASTNode* ast_node, ASTNode*** parameters, unsigned short *parameter_count) {
+    if (ast_node == NULL)
+        return;
+    switch (ast_node->node_type)
+    {
+        case AST_FUNCTION_PARAMETERS_START:
+        case AST_FUNCTION_CALL_PARAMETERS_START:
+            flatten_parameters(ast_node->right, parameters, parameter_count);
+            break;
+        case AST_FUNCTION_STEP:
+            flatten_parameters(ast_node->left, parameters, parameter_count);
+            flatten_parameters(ast_node->right, parameters, parameter_count);
+            break;
+        default:
+            *parameters = realloc(*parameters, sizeof(ASTNode*) * ++*parameter_count);
+            (*parameters)[*parameter_count - 1] = ast_node;
+            break;
+    }
+}
+
+static enum Type get_parameter_type(ASTNode* ast_node) {
+    switch (ast_node->node_type)
+    {
+        case AST_FUNCTION_PARAMETER_BOOL:
+        case AST_FUNCTION_CALL_PARAMETER_BOOL:
+            return K_BOOL;
+        case AST_FUNCTION_PARAMETER_NUMBER:
+        case AST_FUNCTION_CALL_PARAMETER_NUMBER:
+            return K_NUMBER;
+        case AST_FUNCTION_PARAMETER_STRING:
+        case AST_FUNCTION_CALL_PARAMETER_STRING:
+            return K_STRING;
+        default:
+            return K_ANY;
+    }
+}
+
+// The types and the secondary types of the functions by their definition nodes, from AST_DEFINE_FUNCTION_BOOL
+static enum Type function_types[][2] = {
+    {K_BOOL, K_ANY},
+    {K_NUMBER, K_ANY},
+    {K_STRING, K_ANY},
+    {K_ANY, K_ANY},
+    {K_LIST, K_ANY},
+    {K_DICT, K_ANY},
+    {K_LIST, K_BOOL},
+    {K_DICT, K_BOOL},
+    {K_LIST, K_NUMBER},
+    {K_DICT, K_NUMBER},
+    {K_LIST, K_STRING},
+    {K_DICT, K_STRING},
+    {K_VOID, K_ANY}
+};
+
+// The types and the secondary types of the required parameters, from AST_FUNCTION_PARAMETER_BOOL
+static enum Type function_parameter_types[][2] = {
+    {K_BOOL, K_ANY},
+    {K_NUMBER, K_ANY},
+    {K_STRING, K_ANY},
+    {K_LIST, K_ANY},
+    {K_LIST, K_BOOL},
+    {K_LIST, K_NUMBER},
+    {K_LIST, K_STRING},
+    {K_DICT, K_ANY},
+    {K_DICT, K_BOOL},
+    {K_DICT, K_NUMBER},
+    {K_DICT, K_STRING}
+};
+
+static bool is_literal_node(ASTNode* ast_node, enum ASTNodeType node_type) {
+    return ast_node != NULL && ast_node->node_type == node_type &&
+        ast_node->depend == NULL && ast_node->right == NULL && ast_node->left == NULL && ast_node->child == NULL;
+}
+
+// A default value that is computed or complex is only known after the code before it runs
+static bool is_static_parameter(ASTNode* ast_node) {
+    if (ast_node->depend != NULL || ast_node->left != NULL)
+        return false;
+    if (ast_node->node_type >= AST_FUNCTION_PARAMETER_BOOL && ast_node->node_type <= AST_FUNCTION_PARAMETER_STRING_DICT)
+        return ast_node->right == NULL;
+
+    switch (ast_node->node_type)
+    {
+        case AST_OPTIONAL_FUNCTION_PARAMETER_BOOL:
+            return is_literal_node(ast_node->right, AST_BOOLEAN_EXPRESSION_VALUE);
+        case AST_OPTIONAL_FUNCTION_PARAMETER_NUMBER:
+            return is_literal_node(ast_node->right, AST_EXPRESSION_VALUE) || is_literal_node(ast_node->right, AST_MIXED_EXPRESSION_VALUE);
+        case AST_OPTIONAL_FUNCTION_PARAMETER_STRING:
+            return ast_node->right == NULL;
+        default:
+            return false;
+    }
+}
+
+bool compiler_add_static_function(ASTNode* ast_node, FILE *c_fp, unsigned short indent) {
+    char *name = ast_node->strings[0];
+    char *context = compiler_getCurrentContext();
+    char *module_context = compiler_getCurrentModuleContext();
+    char *module = compiler_getCurrentModule();
+    char *main_context = fix_bs(module_path_stack.arr[0]);
+
+    // Registering a function at run time removes the function of the same name
+    // that is defined in the main program, see removeFunctionIfDefined()
+    bool is_redefinition = false;
+    for (unsigned i = 0; i < main_function_names.size; i++) {
+        if (strcmp(main_function_names.arr[i], name) == 0) {
+            free(main_function_names.arr[i]);
+            main_function_names.arr[i] = main_function_names.arr[--main_function_names.size];
+            is_redefinition = true;
+            break;
+        }
+    }
+    if (strcmp(context, main_context) == 0 && strcmp(module_context, main_context) == 0 && strcmp(module, "") == 0)
+        append_to_array(&main_function_names, name);
+    free(main_context);
+
+    ASTNode** parameters = NULL;
+    unsigned short parameter_count = 0;
+    flatten_parameters(ast_node->right, &parameters, &parameter_count);
+
+    bool is_static = ast_node->depend == NULL && ast_node->left == NULL &&
+        strcmp(get_filename_ext(module_context), __KAOS_DYNAMIC_LIBRARY_EXTENSION__) != 0;
+    unsigned short optional_parameter_count = 0;
+    for (unsigned short i = 0; i < parameter_count && is_static; i++) {
+        is_static = is_static_parameter(parameters[i]);
+        if (parameters[i]->node_type >= AST_OPTIONAL_FUNCTION_PARAMETER_BOOL)
+            optional_parameter_count++;
+    }
+
+    if (!is_static) {
+        free(parameters);
+        free(context);
+        free(module_context);
+        free(module);
+        return false;
+    }
+
+    if (is_redefinition) {
+        compiler_register_static_functions(c_fp, indent);
+        fprintf(c_fp, "%*cremoveFunctionIfDefined(\"%s\");\n", indent, ' ', name);
+    }
+
+    static_functions = realloc(static_functions, sizeof(StaticFunction) * ++static_functions_size);
+    StaticFunction* static_function = &static_functions[static_functions_size - 1];
+    static_function->ast_node = ast_node;
+    static_function->context = context;
+    static_function->module_context = module_context;
+    static_function->module = module;
+    static_function->parameters = parameters;
+    static_function->parameter_count = parameter_count;
+    static_function->optional_parameter_count = optional_parameter_count;
+    static_parameters_size += parameter_count;
+    return true;
+}
+
+void compiler_register_static_functions(FILE *c_fp, unsigned short indent) {
+    if (static_functions_registered == static_functions_size)
+        return;
+
+    if (static_parameters_registered == static_parameters_size) {
+        fprintf(
+            c_fp,
+            "%*cregisterStaticFunctions(kaos_static_functions + %u, %u, NULL);\n",
+            indent,
+            ' ',
+            static_functions_registered,
+            static_functions_size - static_functions_registered
+        );
+    } else {
+        fprintf(
+            c_fp,
+            "%*cregisterStaticFunctions(kaos_static_functions + %u, %u, kaos_static_parameters + %u);\n",
+            indent,
+            ' ',
+            static_functions_registered,
+            static_functions_size - static_functions_registered,
+            static_parameters_registered
+        );
+    }
+
+    static_functions_registered = static_functions_size;
+    static_parameters_registered = static_parameters_size;
+}
+
+static void transpile_static_parameter(FILE *c_fp, ASTNode* ast_node) {
+    fprintf(c_fp, "%*c{.name = \"%s\", ", indent_length, ' ', ast_node->strings[0]);
+    switch (ast_node->node_type)
+    {
+        case AST_OPTIONAL_FUNCTION_PARAMETER_BOOL:
+            fprintf(
+                c_fp,
+                ".type = K_BOOL, .secondary_type = K_ANY, .value_type = V_BOOL, .b = %s},\n",
+                ast_node->right->value.b ? "true" : "false"
+            );
+            break;
+        case AST_OPTIONAL_FUNCTION_PARAMETER_NUMBER:
+            if (ast_node->right->value_type == V_INT) {
+                fprintf(c_fp, ".type = K_NUMBER, .secondary_type = K_ANY, .value_type = V_INT, .i = %lld},\n", ast_node->right->value.i);
+            } else {
+                fprintf(c_fp, ".type = K_NUMBER, .secondary_type = K_ANY, .value_type = V_FLOAT, .f = %Lf},\n", ast_node->right->value.f);
+            }
+            break;
+        case AST_OPTIONAL_FUNCTION_PARAMETER_STRING:
+            fprintf(c_fp, ".type = K_STRING, .secondary_type = K_ANY, .value_type = V_STRING, .s = \"%s\"},\n", ast_node->value.s);
+            break;
+        default:
+            fprintf(
+                c_fp,
+                ".type = %s, .secondary_type = %s, .value_type = V_VOID},\n",
+                type_strings[function_parameter_types[ast_node->node_type - AST_FUNCTION_PARAMETER_BOOL][0]],
+                type_strings[function_parameter_types[ast_node->node_type - AST_FUNCTION_PARAMETER_BOOL][1]]
+            );
+            break;
+    }
+}
+
+// The parameters of a function are listed in the order the registration creates their symbols
+void compiler_transpile_static_functions(FILE *c_fp) {
+    if (static_functions_size == 0)
+        return;
+
+    fprintf(c_fp, "\n_Function kaos_static_functions[] = {\n");
+    for (unsigned i = 0; i < static_functions_size; i++) {
+        StaticFunction* static_function = &static_functions[i];
+        enum Type *types = function_types[static_function->ast_node->node_type - AST_DEFINE_FUNCTION_BOOL];
+        fprintf(
+            c_fp,
+            "%*c{.name = \"%s\", .line_no = %d, .parameter_count = %hu, .optional_parameter_count = %hu, "
+            ".type = %s, .secondary_type = %s, .context = \"%s\", .module_context = \"%s\", .module = \"%s\", .is_static = true},\n",
+            indent_length,
+            ' ',
+            static_function->ast_node->strings[0],
+            static_function->ast_node->lineno,
+            static_function->parameter_count,
+            static_function->optional_parameter_count,
+            type_strings[types[0]],
+            type_strings[types[1]],
+            static_function->context,
+            static_function->module_context,
+            static_function->module
+        );
+    }
+    fprintf(c_fp, "};\n");
+
+    if (static_parameters_size == 0)
+        return;
+
+    fprintf(c_fp, "\nconst StaticParameter kaos_static_parameters[] = {\n");
+    for (unsigned i = 0; i < static_functions_size; i++) {
+        StaticFunction* static_function = &static_functions[i];
+        for (unsigned short j = static_function->parameter_count; j > 0; j--) {
+            transpile_static_parameter(c_fp, static_function->parameters[j - 1]);
+        }
+    }
+    fprintf(c_fp, "};\n");
+}
+
+void compiler_free_static_functions() {
+    for (unsigned i = 0; i < static_functions_size; i++) {
+        free(static_functions[i].context);
+        free(static_functions[i].module_context);
+        free(static_functions[i].module);
+        free(static_functions[i].parameters);
+    }
+    free(static_functions);
+    static_functions = NULL;
+    static_functions_size = 0;
+    for (unsigned i = 0; i < main_function_names.size; i++) {
+        free(main_function_names.arr[i]);
+    }
+    free(main_function_names.arr);
+}
+
+// Only the calls without a module prefix, in the module of the typed functions, can refer to one
+static TypedFunction* find_typed_callee(ASTNode* ast_node) {
+    if (!typed_calls_enabled)
+        return NULL;
+    char *name = NULL;
+    switch (ast_node->node_type)
+    {
+        case AST_VAR_CREATE_BOOL_FUNC_RETURN:
+        case AST_VAR_CREATE_NUMBER_FUNC_RETURN:
+        case AST_VAR_CREATE_STRING_FUNC_RETURN:
+        case AST_VAR_UPDATE_FUNC_RETURN:
+            if (ast_node->strings_size == 2)
+                name = ast_node->strings[1];
+            break;
+        case AST_PRINT_FUNCTION_RETURN:
+        case AST_ECHO_FUNCTION_RETURN:
+        case AST_PRETTY_PRINT_FUNCTION_RETURN:
+        case AST_PRETTY_ECHO_FUNCTION_RETURN:
+        case AST_FUNCTION_RETURN:
+        case AST_DECISION_MAKE_BOOLEAN:
+        case AST_DECISION_MAKE_DEFAULT:
+            if (ast_node->strings_size == 1)
+                name = ast_node->strings[0];
+            break;
+        default:
+            break;
+    }
+    if (name == NULL)
+        return NULL;
+    for (unsigned i = 0; i < typed_functions_size; i++) {
+        if (typed_functions[i].is_typed && strcmp(typed_functions[i].function->name, name) == 0)
+            return &typed_functions[i];
+    }
+    return NULL;
+}
+
+// Records the call as a direct one if its arguments can be passed in C. The
+// arguments that are variables are checked once the variables are settled.
+static bool add_typed_call(ASTNode* ast_node) {
+    TypedFunction* callee = find_typed_callee(ast_node);
+    if (callee == NULL)
+        return false;
+
+    ASTNode* arguments_node = ast_node->node_type == AST_DECISION_MAKE_BOOLEAN ? ast_node->left : ast_node->right;
+    ASTNode** arguments = NULL;
+    unsigned short argument_count = 0;
+    flatten_parameters(arguments_node, &arguments, &argument_count);
+    bool is_direct = argument_count == callee->parameter_count;
+    for (unsigned short i = 0; is_direct && i < argument_count; i++) {
+        if (arguments[i]->node_type == AST_FUNCTION_CALL_PARAMETER_VAR)
+            continue;
+        is_direct = get_parameter_type(arguments[i]) == get_parameter_type(callee->parameters[i]) && !has_increment(arguments[i]->right);
+    }
+    free(arguments);
+    if (!is_direct)
+        return false;
+
+    typed_calls = realloc(typed_calls, sizeof(TypedCall) * ++typed_calls_size);
+    typed_calls[typed_calls_size - 1].ast_node = ast_node;
+    typed_calls[typed_calls_size - 1].callee = callee;
+    typed_calls[typed_calls_size - 1].is_direct = true;
+    return true;
+}
+
+static void scan_native_variables_node(ASTNode* ast_node) {
+    switch (ast_node->node_type)
+    {
+        case AST_VAR_EXPRESSION_VALUE:
+        case AST_VAR_MIXED_EXPRESSION_VALUE:
+            read_native_variable(ast_node->strings[0], true);
+            return;
+        case AST_VAR_BOOLEAN_EXPRESSION_VALUE:
+        case AST_FUNCTION_CALL_PARAMETER_VAR:
+            read_native_variable(ast_node->strings[0], false);
+            return;
+        case AST_VAR_EXPRESSION_INCREMENT_ASSIGN:
+        case AST_VAR_EXPRESSION_ASSIGN_INCREMENT:
+            read_native_variable(ast_node->strings[0], true);
+            assign_native_variable(ast_node->strings[0], K_NUMBER, V_INT);
+            return;
+        case AST_BOOLEAN_EXPRESSION_REL_EQUAL_UNKNOWN:
+        case AST_BOOLEAN_EXPRESSION_REL_NOT_EQUAL_UNKNOWN:
+        case AST_BOOLEAN_EXPRESSION_REL_GREAT_UNKNOWN:
+        case AST_BOOLEAN_EXPRESSION_REL_SMALL_UNKNOWN:
+        case AST_BOOLEAN_EXPRESSION_REL_GREAT_EQUAL_UNKNOWN:
+        case AST_BOOLEAN_EXPRESSION_REL_SMALL_EQUAL_UNKNOWN:
+            // Both sides stay in C or in the symbol table together, with the same type
+            read_native_variable(ast_node->strings[0], true);
+            read_native_variable(ast_node->strings[1], true);
+            copy_native_variable(ast_node->strings[1], ast_node->strings[0]);
+            return;
+        case AST_PRINT_SYMBOL_TABLE:
+            native_variables_disabled = true;
+            return;
+        default:
+            break;
+    }
+
+    for (size_t i = 0; i < ast_node->strings_size; i++) {
+        if (ast_node->strings[i] != NULL)
+            escape_native_variable(ast_node->strings[i]);
+    }
+}
+
+static void scan_native_variables_subtree(ASTNode* ast_node) {
+    if (ast_node == NULL)
+        return;
+    scan_native_variables_subtree(ast_node->depend);
+    scan_native_variables_subtree(ast_node->right);
+    scan_native_variables_subtree(ast_node->left);
+    scan_native_variables_node(ast_node);
+}
+
+static void scan_native_variables_statement(ASTNode* ast_node, unsigned depth) {
+    enum Type type;
+    scan_native_variables_subtree(ast_node->depend);
+    scan_native_variables_subtree(ast_node->right);
+    scan_native_variables_subtree(ast_node->left);
+    scan_native_list(ast_node);
+
+    switch (ast_node->node_type)
+    {
+        case AST_VAR_CREATE_BOOL:
+            declare_native_variable(ast_node->strings[0], K_BOOL, depth);
+            break;
+        case AST_VAR_CREATE_NUMBER:
+            declare_native_variable(ast_node->strings[0], K_NUMBER, depth);
+            assign_native_variable(ast_node->strings[0], K_NUMBER, predict_number_value_type(ast_node->right));
+            break;
+        case AST_VAR_CREATE_STRING:
+            declare_native_variable(ast_node->strings[0], K_STRING, depth);
+            break;
+        case AST_VAR_CREATE_BOOL_VAR:
+        case AST_VAR_CREATE_NUMBER_VAR:
+        case AST_VAR_CREATE_STRING_VAR:
+            read_native_variable(ast_node->strings[1], false);
+            declare_native_variable(
+                ast_node->strings[0],
+                ast_node->node_type == AST_VAR_CREATE_BOOL_VAR ? K_BOOL : ast_node->node_type == AST_VAR_CREATE_NUMBER_VAR ? K_NUMBER : K_STRING,
+                depth
+            );
+            copy_native_variable(ast_node->strings[0], ast_node->strings[1]);
+            break;
+        case AST_VAR_UPDATE_BOOL:
+            assign_native_variable(ast_node->strings[0], K_BOOL, V_BOOL);
+            break;
+        case AST_VAR_UPDATE_NUMBER:
+            assign_native_variable(ast_node->strings[0], K_NUMBER, predict_number_value_type(ast_node->right));
+            break;
+        case AST_VAR_UPDATE_STRING:
+            assign_native_variable(ast_node->strings[0], K_STRING, V_STRING);
+            break;
+        case AST_VAR_UPDATE_VAR:
+            read_native_variable(ast_node->strings[1], false);
+            if (find_native_variable(ast_node->strings[0]) == NULL)
+                escape_native_variable(ast_node->strings[0]);
+            copy_native_variable(ast_node->strings[0], ast_node->strings[1]);
+            break;
+        case AST_RETURN_VAR:
+        case AST_PRINT_VAR:
+        case AST_ECHO_VAR:
+        case AST_PRETTY_PRINT_VAR:
+        case AST_PRETTY_ECHO_VAR:
+            read_native_variable(ast_node->strings[0], false);
+            break;
+        case AST_START_TIMES_DO_VAR:
+            read_native_variable(ast_node->strings[0], true);
+            break;
+        case AST_START_FOREACH:
+            escape_native_variable(ast_node->strings[0]);
+            declare_native_loop_element(ast_node->strings[1], ast_node->strings[0]);
+            break;
+        case AST_VAR_CREATE_BOOL_FUNC_RETURN:
+        case AST_VAR_CREATE_NUMBER_FUNC_RETURN:
+        case AST_VAR_CREATE_STRING_FUNC_RETURN:
+            if (!add_typed_call(ast_node)) {
+                scan_native_variables_node(ast_node);
+                break;
+            }
+            type = ast_node->node_type == AST_VAR_CREATE_BOOL_FUNC_RETURN ? K_BOOL : ast_node->node_type == AST_VAR_CREATE_NUMBER_FUNC_RETURN ? K_NUMBER : K_STRING;
+            declare_native_variable(ast_node->strings[0], type, depth);
+            assign_native_variable(ast_node->strings[0], type, V_VOID);
+            break;
+        case AST_VAR_UPDATE_FUNC_RETURN:
+            if (!add_typed_call(ast_node)) {
+                scan_native_variables_node(ast_node);
+                break;
+            }
+            if (find_native_variable(ast_node->strings[0]) == NULL)
+                escape_native_variable(ast_node->strings[0]);
+            assign_native_variable(ast_node->strings[0], typed_calls[typed_calls_size - 1].callee->function->type, V_VOID);
+            break;
+        case AST_PRINT_FUNCTION_RETURN:
+        case AST_ECHO_FUNCTION_RETURN:
+        case AST_PRETTY_PRINT_FUNCTION_RETURN:
+        case AST_PRETTY_ECHO_FUNCTION_RETURN:
+        case AST_FUNCTION_RETURN:
+            if (!add_typed_call(ast_node))
+                scan_native_variables_node(ast_node);
+            break;
+        default:
+            scan_native_variables_node(ast_node);
+            break;
+    }
+}
+
+static void scan_native_variables_decisions(ASTNode* ast_node) {
+    while (ast_node != NULL) {
+        switch (ast_node->node_type)
+        {
+            case AST_FUNCTION_STEP:
+                scan_native_variables_decisions(ast_node->depend);
+                scan_native_variables_decisions(ast_node->right);
+                scan_native_variables_decisions(ast_node->left);
+                break;
+            case AST_DECISION_MAKE_BOOLEAN:
+            case AST_DECISION_MAKE_DEFAULT:
+                scan_native_variables_subtree(ast_node->right);
+                scan_native_variables_subtree(ast_node->left);
+                add_typed_call(ast_node);
+                break;
+            case AST_DECISION_MAKE_BOOLEAN_RETURN:
+            case AST_DECISION_MAKE_DEFAULT_RETURN:
+                scan_native_variables_subtree(ast_node->right);
+                read_native_variable(ast_node->strings[0], false);
+                break;
+            default:
+                scan_native_variables_subtree(ast_node->right);
+                scan_native_variables_subtree(ast_node->left);
+                break;
+        }
+        ast_node = ast_node->next;
+    }
+}
+
+// Keeps the variables referred by a subtree that is not transpiled along
+// with the region (function parameters, decisions) in the symbol table
+void compiler_escape_native_variables(ASTNode* ast_node) {
+    if (ast_node == NULL)
+        return;
+    compiler_escape_native_variables(ast_node->depend);
+    compiler_escape_native_variables(ast_node->right);
+    compiler_escape_native_variables(ast_node->left);
+    for (size_t i = 0; i < ast_node->strings_size; i++) {
+        if (ast_node->strings[i] != NULL)
+            escape_native_variable(ast_node->strings[i]);
+    }
+}
+
+static void scan_native_variables_region(ASTNode* ast_node, char *module, bool is_function_body) {
+    unsigned depth = 0;
+    // The element of each loop around the statement, NULL for the loops other than foreach
+    char **loop_elements = NULL;
+    while (ast_node != NULL) {
+        char *ast_node_module = malloc(1 + strlen(ast_node->module));
+        strcpy(ast_node_module, ast_node->module);
+        compiler_escape_module(ast_node_module);
+        bool is_other_module = strcmp(ast_node_module, module) != 0;
+        free(ast_node_module);
+
+        if (
+            is_other_module ||
+            (ast_node->node_type != AST_FUNCTION_STEP && is_node_function_related(ast_node)) ||
+            (ast_node->node_type >= AST_DECISION_DEFINE && ast_node->node_type <= AST_DECISION_MAKE_DEFAULT_RETURN)
+        ) {
+            ast_node = ast_node->next;
+            continue;
+        }
+
+        if (ast_node->node_type == AST_END) {
+            if (depth == 0 && is_function_body)
+                break;
+            if (depth > 0 && loop_elements[--depth] != NULL)
+                end_native_loop_element(loop_elements[depth]);
+            ast_node = ast_node->next;
+            continue;
+        }
+
+        scan_native_variables_statement(ast_node, depth);
+        if (ast_node->node_type >= AST_START_TIMES_DO && ast_node->node_type <= AST_START_FOREACH_DICT) {
+            loop_elements = realloc(loop_elements, sizeof(char *) * ++depth);
+            loop_elements[depth - 1] = ast_node->node_type == AST_START_FOREACH ? ast_node->strings[1] : NULL;
+        }
+        ast_node = ast_node->next;
+    }
+    free(loop_elements);
+}
+
+static bool propagate_native_variable_copies() {
+    bool propagated = false;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (unsigned i = 0; i < native_variable_copies_size; i++) {
+            NativeVariable* target = &native_variables[native_variable_copies[i].target];
+            NativeVariable* source = &native_variables[native_variable_copies[i].source];
+            if (target->is_escaped && source->is_escaped)
+                continue;
+            if (target->is_escaped || source->is_escaped || target->type != source->type) {
+                target->is_escaped = true;
+                source->is_escaped = true;
+                changed = true;
+                continue;
+            }
+            if (source->is_int && !target->is_int) {
+                target->is_int = true;
+                changed = true;
+            }
+            if (source->is_float && !target->is_float) {
+                target->is_float = true;
+                changed = true;
+            }
+        }
+        propagated = propagated || changed;
+    }
+    return propagated;
+}
+
+static bool is_typed_call_valid(TypedCall* call) {
+    ASTNode* ast_node = call->ast_node;
+    NativeVariable* variable;
+    switch (ast_node->node_type)
+    {
+        case AST_VAR_CREATE_BOOL_FUNC_RETURN:
+        case AST_VAR_CREATE_NUMBER_FUNC_RETURN:
+        case AST_VAR_CREATE_STRING_FUNC_RETURN:
+        case AST_VAR_UPDATE_FUNC_RETURN:
+            variable = compiler_get_native_variable(ast_node->strings[0]);
+            if (variable == NULL || variable->type != call->callee->function->type)
+                return false;
+            break;
+        case AST_PRINT_FUNCTION_RETURN:
+        case AST_ECHO_FUNCTION_RETURN:
+        case AST_PRETTY_PRINT_FUNCTION_RETURN:
+        case AST_PRETTY_ECHO_FUNCTION_RETURN:
+            if (call->callee->function->type == K_VOID)
+                return false;
+            break;
+        default:
+            break;
+    }
+
+    ASTNode** arguments = NULL;
+    unsigned short argument_count = 0;
+    flatten_parameters(ast_node->node_type == AST_DECISION_MAKE_BOOLEAN ? ast_node->left : ast_node->right, &arguments, &argument_count);
+    bool is_valid = true;
+    for (unsigned short i = 0; is_valid && i < argument_count; i++) {
+        if (arguments[i]->node_type != AST_FUNCTION_CALL_PARAMETER_VAR)
+            continue;
+        variable = compiler_get_native_variable(arguments[i]->strings[0]);
+        is_valid = variable != NULL && variable->type == get_parameter_type(call->callee->parameters[i]);
+    }
+    free(arguments);
+    return is_valid;
+}
+
+static void settle_native_variables() {
+    for (unsigned i = 0; i < native_variables_size; i++) {
+        if (native_variables_disabled || !native_variables[i].is_read)
+            native_variables[i].is_escaped = true;
+    }
+
+    // A list that is created again with another type after the loop, or in a later iteration of an outer one
+    for (unsigned i = 0; i < native_loop_elements_size; i++) {
+        if (get_native_list_type(native_loop_elements[i].list) != native_loop_elements[i].type)
+            native_variables[native_loop_elements[i].variable].is_escaped = true;
+    }
+
+    // A call whose result or arguments end up in the symbol table goes through callFunction
+    bool changed = true;
+    while (changed) {
+        changed = propagate_native_variable_copies();
+        for (unsigned i = 0; i < typed_calls_size; i++) {
+            TypedCall* call = &typed_calls[i];
+            if (!call->is_direct || is_typed_call_valid(call))
+                continue;
+            call->is_direct = false;
+            if (call->ast_node->node_type >= AST_VAR_CREATE_BOOL && call->ast_node->node_type <= AST_VAR_UPDATE_FUNC_RETURN)
+                escape_native_variable(call->ast_node->strings[0]);
+            changed = true;
+        }
+    }
+}
+
+// Decides which scalar variables of a region can be C locals. A variable
+// escapes to the symbol table if it's created more than once or inside a
+// loop, used by anything other than plain reads, assignments and prints,
+// copied from or into an escaped variable or never read at all.
+void compiler_analyze_native_variables(ASTNode* ast_node, char *module, bool is_function_body) {
+    typed_calls_enabled = typed_functions_module != NULL && strcmp(module, typed_functions_module) == 0;
+    scan_native_variables_region(ast_node, module, is_function_body);
+    settle_native_variables();
+}
+
+void compiler_declare_native_variables(FILE *c_fp, unsigned short indent) {
+    for (unsigned i = 0; i < native_variables_size; i++) {
+        NativeVariable* variable = &native_variables[i];
+        if (variable->is_escaped || variable->is_parameter)
+            continue;
+        switch (variable->type)
+        {
+            case K_BOOL:
+                fprintf(c_fp, "%*cbool kaos_var_%s = false;\n", indent, ' ', variable->name);
+                break;
+            case K_NUMBER:
+                if (variable->is_int && variable->is_float) {
+                    fprintf(c_fp, "%*cKaosNumber kaos_var_%s = {0, 0.0, false};\n", indent, ' ', variable->name);
+                } else if (variable->is_float) {
+                    fprintf(c_fp, "%*clong double kaos_var_%s = 0.0;\n", indent, ' ', variable->name);
+                } else {
+                    fprintf(c_fp, "%*clong long kaos_var_%s = 0;\n", indent, ' ', variable->name);
+                }
+                break;
+            case K_STRING:
+                fprintf(c_fp, "%*cchar * kaos_var_%s = NULL;\n", indent, ' ', variable->name);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void compiler_free_native_variables() {
+    free(native_variables);
+    native_variables = NULL;
+    native_variables_size = 0;
+    free(native_variable_copies);
+    native_variable_copies = NULL;
+    native_variable_copies_size = 0;
+    free(native_loop_elements);
+    native_loop_elements = NULL;
+    native_loop_elements_size = 0;
+    free(native_lists);
+    native_lists = NULL;
+    native_lists_size = 0;
+    free(typed_calls);
+    typed_calls = NULL;
+    typed_calls_size = 0;
+}
+
+NativeVariable* compiler_get_native_variable(char *name) {
+    if (name == NULL)
+        return NULL;
+    NativeVariable* variable = find_native_variable(name);
+    if (variable == NULL || variable->is_escaped)
+        return NULL;
+    return variable;
+}
+
+// Every %s in the format is replaced by the name of the variable
+static char* format_native_variable(char *format, NativeVariable* variable) {
+    char *name = variable->name;
+    size_t len = (size_t) snprintf(NULL, 0, format, name, name, name) + 1;
+    char *result = malloc(len);
+    snprintf(result, len, format, name, name, name);
+    return result;
+}
+
+static bool is_native_variable_mixed(NativeVariable* variable) {
+    return variable->type == K_NUMBER && variable->is_int && variable->is_float;
+}
+
+// Reads the variable as getSymbolValueInt, getSymbolValueFloat and getSymbolValueBool would
+char* compiler_read_native_variable(NativeVariable* variable, enum ValueType value_type) {
+    bool is_mixed = is_native_variable_mixed(variable);
+    switch (value_type)
+    {
+        case V_INT:
+            if (is_mixed)
+                return format_native_variable("(kaos_var_%s.is_float ? (long long) kaos_var_%s.f : kaos_var_%s.i)", variable);
+            if (variable->type == K_BOOL || variable->is_float)
+                return format_native_variable("((long long) kaos_var_%s)", variable);
+            return format_native_variable("kaos_var_%s", variable);
+        case V_FLOAT:
+            if (is_mixed)
+                return format_native_variable("(kaos_var_%s.is_float ? kaos_var_%s.f : (long double) kaos_var_%s.i)", variable);
+            if (variable->type == K_BOOL || !variable->is_float)
+                return format_native_variable("((long double) kaos_var_%s)", variable);
+            return format_native_variable("kaos_var_%s", variable);
+        default:
+            if (is_mixed)
+                return format_native_variable("(kaos_var_%s.is_float ? kaos_var_%s.f > 0.0 : kaos_var_%s.i > 0)", variable);
+            if (variable->type == K_STRING)
+                return format_native_variable("(kaos_var_%s[0] != '\\0')", variable);
+            if (variable->type == K_NUMBER)
+                return format_native_variable(variable->is_float ? "(kaos_var_%s > 0.0)" : "(kaos_var_%s > 0)", variable);
+            return format_native_variable("kaos_var_%s", variable);
+    }
+}
+
+bool compiler_transpile_native_read(ASTNode* ast_node, enum ValueType value_type) {
+    NativeVariable* variable = compiler_get_native_variable(ast_node->strings[0]);
+    if (variable == NULL)
+        return false;
+    char *read = compiler_read_native_variable(variable, value_type);
+    setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "%s", read));
+    free(read);
+    return true;
+}
+
+// Compares two variables of unknown types as the resolveRel*Unknown functions
+// would, reading the right one as the value type of the left one
+bool compiler_transpile_native_comparison(ASTNode* ast_node, char *operator) {
+    NativeVariable* left = compiler_get_native_variable(ast_node->strings[0]);
+    NativeVariable* right = compiler_get_native_variable(ast_node->strings[1]);
+    if (left == NULL || right == NULL)
+        return false;
+
+    char *comparison;
+    char *read_int = compiler_read_native_variable(right, V_INT);
+    char *read_float = compiler_read_native_variable(right, V_FLOAT);
+    char *read_bool = compiler_read_native_variable(right, V_BOOL);
+    if (left->type == K_BOOL) {
+        comparison = snprintf_concat_string(NULL, "(kaos_var_%s ", left->name);
+        comparison = snprintf_concat_string(comparison, "%s ", operator);
+        comparison = snprintf_concat_string(comparison, "%s)", read_bool);
+    } else if (is_native_variable_mixed(left)) {
+        comparison = format_native_variable("(kaos_var_%s.is_float ? kaos_var_%s.f ", left);
+        comparison = snprintf_concat_string(comparison, "%s ", operator);
+        comparison = snprintf_concat_string(comparison, "%s : ", read_float);
+        comparison = snprintf_concat_string(comparison, "kaos_var_%s.i ", left->name);
+        comparison = snprintf_concat_string(comparison, "%s ", operator);
+        comparison = snprintf_concat_string(comparison, "%s)", read_int);
+    } else {
+        comparison = snprintf_concat_string(NULL, "(kaos_var_%s ", left->name);
+        comparison = snprintf_concat_string(comparison, "%s ", operator);
+        comparison = snprintf_concat_string(comparison, "%s)", left->is_float ? read_float : read_int);
+    }
+    setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "%s", comparison));
+    free(comparison);
+    free(read_int);
+    free(read_float);
+    free(read_bool);
+    return true;
+}
+
+bool compiler_transpile_native_increment(ASTNode* ast_node, bool assign_first) {
+    NativeVariable* variable = compiler_get_native_variable(ast_node->strings[0]);
+    if (variable == NULL)
+        return false;
+    char *increment;
+    if (is_native_variable_mixed(variable)) {
+        char *read = compiler_read_native_variable(variable, V_INT);
+        increment = snprintf_concat_string(NULL, "(kaos_var_%s.i = ", variable->name);
+        increment = snprintf_concat_string(increment, "%s", read);
+        increment = snprintf_concat_int(increment, " + (%lld), ", ast_node->right->value.i);
+        increment = snprintf_concat_string(increment, "kaos_var_%s.is_float = false, ", variable->name);
+        increment = snprintf_concat_string(increment, "kaos_var_%s.i)", variable->name);
+        free(read);
+    } else {
+        increment = snprintf_concat_string(NULL, "(kaos_var_%s", variable->name);
+        increment = snprintf_concat_int(increment, " += (%lld))", ast_node->right->value.i);
+    }
+    if (assign_first)
+        increment = snprintf_concat_int(increment, " - (%lld)", ast_node->right->value.i);
+    setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "(%s)", increment));
+    free(increment);
+    return true;
+}
+
+// The value of the variable as it's passed to or returned from a typed function
+static char* get_typed_value(NativeVariable* variable) {
+    if (variable->type != K_NUMBER || is_native_variable_mixed(variable))
+        return format_native_variable("kaos_var_%s", variable);
+    if (variable->is_float)
+        return format_native_variable("(KaosNumber) {0, kaos_var_%s, true}", variable);
+    return format_native_variable("(KaosNumber) {kaos_var_%s, 0.0, false}", variable);
+}
+
+static void transpile_native_number_assignment(FILE *c_fp, NativeVariable* variable, enum ValueType value_type, char *value, unsigned short indent) {
+    if (!is_native_variable_mixed(variable)) {
+        fprintf(c_fp, "%*ckaos_var_%s = %s;\n", indent, ' ', variable->name, value);
+        return;
+    }
+    if (value_type == V_INT) {
+        fprintf(c_fp, "%*ckaos_var_%s.i = %s;\n", indent, ' ', variable->name, value);
+        fprintf(c_fp, "%*ckaos_var_%s.is_float = false;\n", indent, ' ', variable->name);
+    } else {
+        fprintf(c_fp, "%*ckaos_var_%s.f = %s;\n", indent, ' ', variable->name, value);
+        fprintf(c_fp, "%*ckaos_var_%s.is_float = true;\n", indent, ' ', variable->name);
+    }
+}
+
+bool compiler_transpile_native_assignment(FILE *c_fp, ASTNode* ast_node, unsigned short indent) {
+    NativeVariable* variable = compiler_get_native_variable(ast_node->strings[0]);
+    if (variable == NULL)
+        return false;
+
+    char *value = NULL;
+    char *value_s;
+    switch (variable->type)
+    {
+        case K_BOOL:
+            if (ast_node->right->is_transpiled) {
+                value = snprintf_concat_string(value, "%s", ast_node->right->transpiled);
+            } else {
+                value = snprintf_concat_string(value, "%s", ast_node->right->value.b ? "true" : "false");
+            }
+            fprintf(c_fp, "%*ckaos_var_%s = %s;\n", indent, ' ', variable->name, value);
+            break;
+        case K_NUMBER:
+            if (ast_node->right->is_transpiled) {
+                value = snprintf_concat_string(value, "%s", ast_node->right->transpiled);
+            } else if (ast_node->right->value_type == V_INT) {
+                value = snprintf_concat_int(value, "%lld", ast_node->right->value.i);
+            } else {
+                value = snprintf_concat_float(value, "%Lf", ast_node->right->value.f);
+            }
+            transpile_native_number_assignment(c_fp, variable, ast_node->right->value_type == V_INT ? V_INT : V_FLOAT, value, indent);
+            break;
+        case K_STRING:
+            value_s = escape_string_literal_for_transpiler(ast_node->value.s);
+            fprintf(c_fp, "%*ckaos_var_%s = \"%s\";\n", indent, ' ', variable->name, value_s);
+            free(value_s);
+            break;
+        default:
+            break;
+    }
+    free(value);
+    return true;
+}
+
+bool compiler_transpile_native_copy(FILE *c_fp, ASTNode* ast_node, unsigned short indent) {
+    NativeVariable* target = compiler_get_native_variable(ast_node->strings[0]);
+    NativeVariable* source = compiler_get_native_variable(ast_node->strings[1]);
+    if (target == NULL || source == NULL)
+        return false;
+
+    if (!is_native_variable_mixed(target) || is_native_variable_mixed(source)) {
+        fprintf(c_fp, "%*ckaos_var_%s = kaos_var_%s;\n", indent, ' ', target->name, source->name);
+    } else {
+        char *value = snprintf_concat_string(NULL, "kaos_var_%s", source->name);
+        transpile_native_number_assignment(c_fp, target, source->is_float ? V_FLOAT : V_INT, value, indent);
+        free(value);
+    }
+    return true;
+}
+
+bool compiler_transpile_native_print(FILE *c_fp, ASTNode* ast_node, char *end, unsigned short indent) {
+    NativeVariable* variable = compiler_get_native_variable(ast_node->strings[0]);
+    if (variable == NULL)
+        return false;
+
+    switch (variable->type)
+    {
+        case K_BOOL:
+            fprintf(c_fp, "%*coutputBool(kaos_var_%s, \"%s\");\n", indent, ' ', variable->name, end);
+            break;
+        case K_NUMBER:
+            if (is_native_variable_mixed(variable)) {
+                fprintf(c_fp, "%*cprintNumber(kaos_var_%s, \"%s\");\n", indent, ' ', variable->name, end);
+            } else {
+                fprintf(c_fp, "%*c%s(kaos_var_%s, \"%s\");\n", indent, ' ', variable->is_float ? "outputFloat" : "outputInt", variable->name, end);
+            }
+            break;
+        case K_STRING:
+            fprintf(c_fp, "%*coutputEscapedString(kaos_var_%s, \"%s\");\n", indent, ' ', variable->name, end);
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+bool compiler_transpile_native_return(FILE *c_fp, ASTNode* ast_node, unsigned short indent) {
+    NativeVariable* variable = compiler_get_native_variable(ast_node->strings[0]);
+    if (variable == NULL)
+        return false;
+
+    if (typed_function_mode != NULL) {
+        char *value = get_typed_value(variable);
+        fprintf(c_fp, "%*ckaos_return = %s;\n", indent, ' ', value);
+        free(value);
+        return true;
+    }
+
+    switch (variable->type)
+    {
+        case K_BOOL:
+            fprintf(c_fp, "%*creturnTemporarySymbol(addSymbolBool(NULL, kaos_var_%s));\n", indent, ' ', variable->name);
+            break;
+        case K_NUMBER:
+            if (is_native_variable_mixed(variable)) {
+                fprintf(c_fp, "%*creturnTemporarySymbol(addSymbolNumber(NULL, kaos_var_%s));\n", indent, ' ', variable->name);
+            } else {
+                fprintf(c_fp, "%*creturnTemporarySymbol(%s(NULL, kaos_var_%s));\n", indent, ' ', variable->is_float ? "addSymbolFloat" : "addSymbolInt", variable->name);
+            }
+            break;
+        case K_STRING:
+            fprintf(c_fp, "%*creturnTemporarySymbol(addSymbolString(NULL, kaos_var_%s));\n", indent, ' ', variable->name);
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+bool compiler_transpile_native_parameter(FILE *c_fp, ASTNode* ast_node, unsigned short indent) {
+    NativeVariable* variable = compiler_get_native_variable(ast_node->strings[0]);
+    if (variable == NULL)
+        return false;
+
+    switch (variable->type)
+    {
+        case K_BOOL:
+            fprintf(c_fp, "%*caddFunctionCallParameterBool(kaos_var_%s);\n", indent, ' ', variable->name);
+            break;
+        case K_NUMBER:
+            if (is_native_variable_mixed(variable)) {
+                fprintf(c_fp, "%*cif (kaos_var_%s.is_float)\n", indent, ' ', variable->name);
+                fprintf(c_fp, "%*caddFunctionCallParameterFloat(kaos_var_%s.f);\n", indent + indent_length, ' ', variable->name);
+                fprintf(c_fp, "%*celse\n", indent, ' ');
+                fprintf(c_fp, "%*caddFunctionCallParameterInt(kaos_var_%s.i);\n", indent + indent_length, ' ', variable->name);
+            } else {
+                fprintf(c_fp, "%*c%s(kaos_var_%s);\n", indent, ' ', variable->is_float ? "addFunctionCallParameterFloat" : "addFunctionCallParameterInt", variable->name);
+            }
+            break;
+        case K_STRING:
+            fprintf(c_fp, "%*caddFunctionCallParameterString(kaos_var_%s);\n", indent, ' ', variable->name);
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+static char* get_typed_type(enum Type type) {
+    switch (type)
+    {
+        case K_BOOL:
+            return "bool";
+        case K_NUMBER:
+            return "KaosNumber";
+        case K_STRING:
+            return "char *";
+        default:
+            return "void";
+    }
+}
+
+static bool is_typed_expression(ASTNode* ast_node) {
+    if (ast_node == NULL)
+        return true;
+    enum ASTNodeType node_type = ast_node->node_type;
+    bool is_expression = (
+        node_type >= AST_PARENTHESIS && node_type <= AST_VAR_BOOLEAN_EXPRESSION_VALUE
+    ) || (
+        node_type >= AST_FUNCTION_CALL_PARAMETERS_START && node_type <= AST_FUNCTION_CALL_PARAMETER_VAR
+    ) || node_type == AST_FUNCTION_STEP;
+    return is_expression &&
+        is_typed_expression(ast_node->depend) &&
+        is_typed_expression(ast_node->right) &&
+        is_typed_expression(ast_node->left) &&
+        is_typed_expression(ast_node->next);
+}
+
+static bool is_typed_statement(ASTNode* ast_node) {
+    switch (ast_node->node_type)
+    {
+        case AST_VAR_CREATE_BOOL:
+        case AST_VAR_CREATE_BOOL_VAR:
+        case AST_VAR_CREATE_BOOL_FUNC_RETURN:
+        case AST_VAR_CREATE_NUMBER:
+        case AST_VAR_CREATE_NUMBER_VAR:
+        case AST_VAR_CREATE_NUMBER_FUNC_RETURN:
+        case AST_VAR_CREATE_STRING:
+        case AST_VAR_CREATE_STRING_VAR:
+        case AST_VAR_CREATE_STRING_FUNC_RETURN:
+        case AST_VAR_UPDATE_BOOL:
+        case AST_VAR_UPDATE_NUMBER:
+        case AST_VAR_UPDATE_STRING:
+        case AST_VAR_UPDATE_VAR:
+        case AST_VAR_UPDATE_FUNC_RETURN:
+        case AST_RETURN_VAR:
+        case AST_PRINT_VAR:
+        case AST_PRINT_EXPRESSION:
+        case AST_PRINT_MIXED_EXPRESSION:
+        case AST_PRINT_STRING:
+        case AST_ECHO_VAR:
+        case AST_ECHO_EXPRESSION:
+        case AST_ECHO_MIXED_EXPRESSION:
+        case AST_ECHO_STRING:
+        case AST_PRETTY_PRINT_VAR:
+        case AST_PRETTY_ECHO_VAR:
+        case AST_START_TIMES_DO:
+        case AST_START_TIMES_DO_VAR:
+        case AST_PRINT_FUNCTION_RETURN:
+        case AST_ECHO_FUNCTION_RETURN:
+        case AST_PRETTY_PRINT_FUNCTION_RETURN:
+        case AST_PRETTY_ECHO_FUNCTION_RETURN:
+        case AST_FUNCTION_RETURN:
+            return is_typed_expression(ast_node->depend) && is_typed_expression(ast_node->right) && is_typed_expression(ast_node->left);
+        default:
+            return false;
+    }
+}
+
+// Checks the body of a function whose variables are settled, counting its
+// calls and its returns, of which the ones at the top level always run
+static bool check_typed_body(ASTNode* ast_node, enum Type type, unsigned *call_count, unsigned *return_count, bool *has_return) {
+    unsigned depth = 0;
+    for (; ast_node != NULL; ast_node = ast_node->next) {
+        if (ast_node->node_type == AST_END) {
+            if (depth == 0)
+                return true;
+            depth--;
+            continue;
+        }
+        if (!is_typed_statement(ast_node))
+            return false;
+        if (is_node_function_call(ast_node))
+            (*call_count)++;
+        if (ast_node->node_type == AST_START_TIMES_DO || ast_node->node_type == AST_START_TIMES_DO_VAR)
+            depth++;
+        if (ast_node->node_type == AST_RETURN_VAR) {
+            NativeVariable* variable = compiler_get_native_variable(ast_node->strings[0]);
+            if (type == K_VOID || variable == NULL || variable->type != type)
+                return false;
+            (*return_count)++;
+            if (depth == 0)
+                *has_return = true;
+        }
+    }
+    return false;
+}
+
+static bool check_typed_decisions(ASTNode* ast_node, enum Type type, unsigned *call_count, bool *has_return) {
+    for (; ast_node != NULL; ast_node = ast_node->next) {
+        NativeVariable* variable;
+        TypedCall* call;
+        switch (ast_node->node_type)
+        {
+            case AST_FUNCTION_STEP:
+                if (
+                    !check_typed_decisions(ast_node->depend, type, call_count, has_return) ||
+                    !check_typed_decisions(ast_node->right, type, call_count, has_return) ||
+                    !check_typed_decisions(ast_node->left, type, call_count, has_return)
+                )
+                    return false;
+                break;
+            case AST_DECISION_MAKE_BOOLEAN:
+            case AST_DECISION_MAKE_DEFAULT:
+                (*call_count)++;
+                call = compiler_get_typed_call(ast_node);
+                if (call == NULL || call->callee->function->type != type || !is_typed_expression(ast_node->right))
+                    return false;
+                if (ast_node->node_type == AST_DECISION_MAKE_DEFAULT)
+                    *has_return = true;
+                break;
+            case AST_DECISION_MAKE_BOOLEAN_RETURN:
+            case AST_DECISION_MAKE_DEFAULT_RETURN:
+                variable = compiler_get_native_variable(ast_node->strings[0]);
+                if (variable == NULL || variable->type != type || !is_typed_expression(ast_node->right))
+                    return false;
+                if (ast_node->node_type == AST_DECISION_MAKE_DEFAULT_RETURN)
+                    *has_return = true;
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+static bool is_typed_function_candidate(_Function* function, char *module) {
+    if (
+        function->node == NULL ||
+        function->is_dynamic ||
+        function->optional_parameter_count > 0 ||
+        function->node->node_type < AST_DEFINE_FUNCTION_BOOL ||
+        function->node->node_type > AST_DEFINE_FUNCTION_VOID ||
+        function->node->dont_transpile ||
+        (function->type != K_BOOL && function->type != K_NUMBER && function->type != K_STRING && function->type != K_VOID) ||
+        strcmp(function->module, "") != 0 ||
+        strcmp(function->context, function->module_context) != 0
+    )
+        return false;
+
+    char *module_context = malloc(1 + strlen(function->module_context));
+    strcpy(module_context, function->module_context);
+    compiler_escape_module(module_context);
+    bool is_in_module = strcmp(module_context, module) == 0;
+    free(module_context);
+    if (!is_in_module)
+        return false;
+
+    // An unqualified call must resolve to this function alone
+    for (_Function* other = start_function; other != NULL; other = other->next) {
+        if (other != function && strcmp(other->module, "") == 0 && strcmp(other->name, function->name) == 0)
+            return false;
+    }
+    return true;
+}
+
+// Finds the functions of the program that can be transpiled into C functions
+// with typed parameters and a return value. A function stays typed only if
+// all of its variables can be C locals and all of its calls and decisions
+// go to typed functions, so the candidates are narrowed until none drops out.
+void compiler_find_typed_functions(char *module) {
+    typed_functions_module = module;
+    for (_Function* function = start_function; function != NULL; function = function->next) {
+        if (!is_typed_function_candidate(function, module))
+            continue;
+        typed_functions = realloc(typed_functions, sizeof(TypedFunction) * ++typed_functions_size);
+        TypedFunction* typed_function = &typed_functions[typed_functions_size - 1];
+        typed_function->function = function;
+        typed_function->parameters = NULL;
+        typed_function->parameter_count = 0;
+        flatten_parameters(function->node->right, &typed_function->parameters, &typed_function->parameter_count);
+        typed_function->is_typed = typed_function->parameter_count == function->parameter_count;
+        for (unsigned short i = 0; i < typed_function->parameter_count; i++) {
+            if (get_parameter_type(typed_function->parameters[i]) == K_ANY)
+                typed_function->is_typed = false;
+        }
+        typed_function->name = snprintf_concat_string(NULL, "kaos_fn_%s", module);
+        typed_function->name = snprintf_concat_string(typed_function->name, "_%s", function->name);
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (unsigned i = 0; i < typed_functions_size; i++) {
+            if (!typed_functions[i].is_typed)
+                continue;
+            bool is_typed = compiler_analyze_typed_function(&typed_functions[i], module);
+            compiler_free_native_variables();
+            if (!is_typed) {
+                typed_functions[i].is_typed = false;
+                changed = true;
+            }
+        }
+    }
+}
+
+TypedFunction* compiler_get_typed_function(_Function* function) {
+    for (unsigned i = 0; i < typed_functions_size; i++) {
+        if (typed_functions[i].function == function && typed_functions[i].is_typed)
+            return &typed_functions[i];
+    }
+    return NULL;
+}
+
+TypedFunction* compiler_get_typed_function_by_node(ASTNode* ast_node) {
+    for (unsigned i = 0; i < typed_functions_size; i++) {
+        if (typed_functions[i].function->node == ast_node && typed_functions[i].is_typed)
+            return &typed_functions[i];
+    }
+    return NULL;
+}
+
+// Analyzes the variables of a typed function, the parameters become C
+// parameters. Returns false if the function can't stay typed.
+bool compiler_analyze_typed_function(TypedFunction* typed_function, char *module) {
+    _Function* function = typed_function->function;
+    typed_calls_enabled = true;
+    for (unsigned short i = 0; i < typed_function->parameter_count; i++) {
+        char *name = typed_function->parameters[i]->strings[0];
+        if (find_native_variable(name) != NULL)
+            return false;
+        enum Type type = get_parameter_type(typed_function->parameters[i]);
+        NativeVariable* variable = add_native_variable(name, type, false);
+        variable->is_parameter = true;
+        variable->is_read = true;
+        variable->is_int = type == K_NUMBER;
+        variable->is_float = type == K_NUMBER;
+    }
+    scan_native_variables_region(function->node->child, module, true);
+    scan_native_variables_decisions(function->decision_node);
+    settle_native_variables();
+
+    for (unsigned i = 0; i < native_variables_size; i++) {
+        if (native_variables[i].is_escaped)
+            return false;
+    }
+
+    unsigned call_count = 0;
+    unsigned return_count = 0;
+    bool has_return = false;
+    if (!check_typed_body(function->node->child, function->type, &call_count, &return_count, &has_return))
+        return false;
+    typed_function->has_return = has_return;
+
+    // A decision that calls a function keeps the return value of the body if
+    // there is one, so the body can't return only from inside of a loop
+    unsigned body_call_count = call_count;
+    if (!check_typed_decisions(function->decision_node, function->type, &call_count, &has_return))
+        return false;
+    if (function->type != K_VOID && !has_return)
+        return false;
+    if (return_count > 0 && !typed_function->has_return && call_count > body_call_count)
+        return false;
+
+    unsigned direct_call_count = 0;
+    for (unsigned i = 0; i < typed_calls_size; i++) {
+        if (typed_calls[i].is_direct)
+            direct_call_count++;
+    }
+    return direct_call_count == call_count;
 }
 
-bool transpile_common_mixed_operator(ASTNode* ast_node, char *operator) {
-    if ((ast_node->left != NULL && ast_node->left->is_transpiled) || (ast_node->right != NULL && ast_node->right->is_transpiled)) {
-        if (ast_node->left != NULL && ast_node->left->is_transpiled) {
-            if (ast_node->left->value_type == V_INT) {
-                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "(long double) %s", ast_node->left->transpiled));
-            } else {
-                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "%s", ast_node->left->transpiled));
-            }
-        } else {
-            if (ast_node->left->value_type == V_INT) {
-                setASTNodeTranspiled(ast_node, snprintf_concat_int(ast_node->transpiled, "%lld", (long double) ast_node->left->value.i));
+static char* transpile_typed_argument(ASTNode* ast_node) {
+    char *value = NULL;
+    char *argument = NULL;
+    switch (ast_node->node_type)
+    {
+        case AST_FUNCTION_CALL_PARAMETER_BOOL:
+            if (ast_node->right->is_transpiled)
+                return snprintf_concat_string(NULL, "%s", ast_node->right->transpiled);
+            return snprintf_concat_string(NULL, "%s", ast_node->right->value.b ? "true" : "false");
+        case AST_FUNCTION_CALL_PARAMETER_NUMBER:
+            if (ast_node->right->is_transpiled) {
+                value = snprintf_concat_string(NULL, "%s", ast_node->right->transpiled);
+            } else if (ast_node->right->value_type == V_INT) {
+                value = snprintf_concat_int(NULL, "%lld", ast_node->right->value.i);
             } else {
-                setASTNodeTranspiled(ast_node, snprintf_concat_float(ast_node->transpiled, "%Lf", ast_node->left->value.f));
+                value = snprintf_concat_float(NULL, "%Lf", ast_node->right->value.f);
             }
-        }
-        setASTNodeTranspiled(ast_node, strcat_ext(ast_node->transpiled, " "));
-        setASTNodeTranspiled(ast_node, strcat_ext(ast_node->transpiled, operator));
-        setASTNodeTranspiled(ast_node, strcat_ext(ast_node->transpiled, " "));
-        if (ast_node->right != NULL && ast_node->right->is_transpiled) {
             if (ast_node->right->value_type == V_INT) {
-                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "(long double) %s", ast_node->right->transpiled));
+                argument = snprintf_concat_string(NULL, "(KaosNumber) {%s, 0.0, false}", value);
             } else {
-                setASTNodeTranspiled(ast_node, snprintf_concat_string(ast_node->transpiled, "%s", ast_node->right->transpiled));
+                argument = snprintf_concat_string(NULL, "(KaosNumber) {0, %s, true}", value);
             }
+            free(value);
+            return argument;
+        case AST_FUNCTION_CALL_PARAMETER_STRING:
+            value = escape_string_literal_for_transpiler(ast_node->value.s);
+            argument = snprintf_concat_string(NULL, "\"%s\"", value);
+            free(value);
+            return argument;
+        default:
+            return get_typed_value(compiler_get_native_variable(ast_node->strings[0]));
+    }
+}
+
+static char* transpile_typed_call_expression(TypedCall* call) {
+    ASTNode* ast_node = call->ast_node;
+    ASTNode** arguments = NULL;
+    unsigned short argument_count = 0;
+    flatten_parameters(ast_node->node_type == AST_DECISION_MAKE_BOOLEAN ? ast_node->left : ast_node->right, &arguments, &argument_count);
+
+    char *expression = snprintf_concat_string(NULL, "%s(", call->callee->name);
+    for (unsigned short i = 0; i < argument_count; i++) {
+        char *argument = transpile_typed_argument(arguments[i]);
+        expression = snprintf_concat_string(expression, i > 0 ? ", %s" : "%s", argument);
+        free(argument);
+    }
+    expression = snprintf_concat_string(expression, "%s", ")");
+    free(arguments);
+    return expression;
+}
+
+static void transpile_typed_decision_result(FILE *c_fp, ASTNode* ast_node, TypedFunction* typed_function, unsigned short indent) {
+    char *value;
+    if (ast_node->node_type == AST_DECISION_MAKE_BOOLEAN || ast_node->node_type == AST_DECISION_MAKE_DEFAULT) {
+        value = transpile_typed_call_expression(compiler_get_typed_call(ast_node));
+        if (typed_function->function->type == K_VOID || typed_function->has_return) {
+            fprintf(c_fp, "%*c%s;\n", indent, ' ', value);
+            fprintf(c_fp, "%*creturn%s;\n", indent, ' ', typed_function->has_return ? " kaos_return" : "");
         } else {
-            if (ast_node->right->value_type == V_INT) {
-                setASTNodeTranspiled(ast_node, snprintf_concat_int(ast_node->transpiled, "%lld", (long double) ast_node->right->value.i));
-            } else {
-                setASTNodeTranspiled(ast_node, snprintf_concat_float(ast_node->transpiled, "%Lf", ast_node->right->value.f));
-            }
+            fprintf(c_fp, "%*creturn %s;\n", indent, ' ', value);
         }
-        return true;
+    } else {
+        value = get_typed_value(compiler_get_native_variable(ast_node->strings[0]));
+        fprintf(c_fp, "%*creturn %s;\n", indent, ' ', value);
     }
-    return false;
+    free(value);
 }
 
-void transpile_function_call(FILE *c_fp, char *module, char *name, unsigned short indent) {
-    fprintf(
-        c_fp,
-        "%*cfunction_call_%llu->lineno = kaos_lineno;\n",
-        indent,
-        ' ',
-        compiler_function_counter
-    );
-    char *module_context = compiler_getFunctionModuleContext(name, module);
-    if (!isFunctionFromDynamicLibrary(name, module))
-        fprintf(c_fp, "%*ckaos_function_%s_%s();\n", indent, ' ', module_context, name);
+// The decisions of a typed function become the conditional returns at the end of its body
+static void transpile_typed_decisions(ASTNode* ast_node, char *module, FILE *c_fp, TypedFunction* typed_function, unsigned short indent) {
+    for (; ast_node != NULL; ast_node = ast_node->next) {
+        if (ast_node->node_type == AST_FUNCTION_STEP) {
+            transpile_typed_decisions(ast_node->depend, module, c_fp, typed_function, indent);
+            transpile_typed_decisions(ast_node->right, module, c_fp, typed_function, indent);
+            transpile_typed_decisions(ast_node->left, module, c_fp, typed_function, indent);
+            continue;
+        }
 
-    _Function* function = NULL;
-    if (
-        module == NULL
-        &&
-        transpiled_modules.size > 0
-        &&
-        strcmp(transpiled_modules.arr[transpiled_modules.size - 1], "") != 0
-    ) {
-        function = getFunctionByModuleContext(name, transpiled_modules.arr[transpiled_modules.size - 1]);
+        fprintf(c_fp, "%*ckaos_lineno = %d;\n", indent, ' ', ast_node->lineno);
+        if (ast_node->node_type == AST_DECISION_MAKE_DEFAULT || ast_node->node_type == AST_DECISION_MAKE_DEFAULT_RETURN) {
+            transpile_typed_decision_result(c_fp, ast_node, typed_function, indent);
+            continue;
+        }
+
+        transpile_node(ast_node->right, module, c_fp, indent);
+        if (ast_node->right->is_transpiled) {
+            fprintf(c_fp, "%*cif (%s) {\n", indent, ' ', ast_node->right->transpiled);
+        } else {
+            fprintf(c_fp, "%*cif (%s) {\n", indent, ' ', ast_node->right->value.b ? "true" : "false");
+        }
+        transpile_typed_decision_result(c_fp, ast_node, typed_function, indent + indent_length);
+        fprintf(c_fp, "%*c}\n", indent, ' ');
+    }
+}
+
+void compiler_transpile_typed_function(FILE *c_fp, FILE *h_fp, TypedFunction* typed_function, char *module, unsigned short indent) {
+    _Function* function = typed_function->function;
+    char *parameters = snprintf_concat_string(NULL, "%s", "(");
+    for (unsigned short i = 0; i < typed_function->parameter_count; i++) {
+        ASTNode* parameter = typed_function->parameters[i];
+        parameters = snprintf_concat_string(parameters, i > 0 ? ", %s" : "%s", get_typed_type(get_parameter_type(parameter)));
+        parameters = snprintf_concat_string(parameters, " kaos_var_%s", parameter->strings[0]);
+    }
+    parameters = snprintf_concat_string(parameters, "%s", typed_function->parameter_count > 0 ? ")" : "void)");
+    fprintf(h_fp, "%s %s%s;\n", get_typed_type(function->type), typed_function->name, parameters);
+    // An instrumented function has its body in a separate C function, so that every return of it passes the exit hook
+    if (instrument_functions) {
+        compiler_transpile_instrument_site(c_fp, module, function->name, function->node);
+        fprintf(c_fp, "static %s %s_body%s {\n", get_typed_type(function->type), typed_function->name, parameters);
     } else {
-        function = getFunction(name, module);
+        fprintf(c_fp, "%s %s%s {\n", get_typed_type(function->type), typed_function->name, parameters);
+    }
+
+    compiler_analyze_typed_function(typed_function, module);
+    typed_function_mode = typed_function;
+    switch (function->type)
+    {
+        case K_BOOL:
+            fprintf(c_fp, "%*cbool kaos_return = false;\n", indent, ' ');
+            break;
+        case K_NUMBER:
+            fprintf(c_fp, "%*cKaosNumber kaos_return = {0, 0.0, false};\n", indent, ' ');
+            break;
+        case K_STRING:
+            fprintf(c_fp, "%*cchar * kaos_return = \"\";\n", indent, ' ');
+            break;
+        default:
+            break;
     }
-    if (function->decision_node != NULL) {
-        fprintf(c_fp, "%*ckaos_decision_%s_%s();\n", indent, ' ', module_context, name);
+    compiler_declare_native_variables(c_fp, indent);
+    transpile_node(function->node->child, module, c_fp, indent);
+    transpile_typed_decisions(function->decision_node, module, c_fp, typed_function, indent);
+    if (function->type != K_VOID)
+        fprintf(c_fp, "%*creturn kaos_return;\n", indent, ' ');
+    typed_function_mode = NULL;
+    compiler_free_native_variables();
+    fprintf(c_fp, "}\n\n");
+
+    if (instrument_functions) {
+        char *body_call = snprintf_concat_string(NULL, "%s_body(", typed_function->name);
+        for (unsigned short i = 0; i < typed_function->parameter_count; i++)
+            body_call = snprintf_concat_string(body_call, i > 0 ? ", kaos_var_%s" : "kaos_var_%s", typed_function->parameters[i]->strings[0]);
+        body_call = snprintf_concat_string(body_call, "%s", ")");
+        fprintf(c_fp, "%s %s%s {\n", get_typed_type(function->type), typed_function->name, parameters);
+        compiler_transpile_instrument_hook(c_fp, "instrumentEnter", indent);
+        if (function->type == K_VOID) {
+            fprintf(c_fp, "%*c%s;\n", indent, ' ', body_call);
+            compiler_transpile_instrument_hook(c_fp, "instrumentExit", indent);
+        } else {
+            fprintf(c_fp, "%*c%s kaos_return = %s;\n", indent, ' ', get_typed_type(function->type), body_call);
+            compiler_transpile_instrument_hook(c_fp, "instrumentExit", indent);
+            fprintf(c_fp, "%*creturn kaos_return;\n", indent, ' ');
+        }
+        fprintf(c_fp, "}\n\n");
+        free(body_call);
+        compiler_free_instrument_site();
     }
-    free(module_context);
-    fprintf(
-        c_fp,
-        "%*ccallFunctionCleanUp(function_call_%llu, %s);\n",
-        indent,
-        ' ',
-        compiler_function_counter,
-        function->decision_node != NULL ? "true" : "false"
-    );
+    free(parameters);
+
+    // The entry point for callFunction, which has already type checked the parameters
+    char *call = snprintf_concat_string(NULL, "%s(", typed_function->name);
+    for (unsigned short i = 0; i < typed_function->parameter_count; i++) {
+        ASTNode* parameter = typed_function->parameters[i];
+        if (i > 0)
+            call = snprintf_concat_string(call, "%s", ", ");
+        switch (get_parameter_type(parameter))
+        {
+            case K_BOOL:
+                call = snprintf_concat_string(call, "getSymbolValueBool(\"%s\")", parameter->strings[0]);
+                break;
+            case K_NUMBER:
+                call = snprintf_concat_string(call, "getSymbolValueNumber(\"%s\")", parameter->strings[0]);
+                break;
+            default:
+                call = snprintf_concat_string(call, "getSymbol(\"%s\")->value.s", parameter->strings[0]);
+                break;
+        }
+    }
+    call = snprintf_concat_string(call, "%s", ")");
+    fprintf(h_fp, "void kaos_function_%s_%s();\n", module, function->name);
+    fprintf(c_fp, "void kaos_function_%s_%s() {\n", module, function->name);
+    switch (function->type)
+    {
+        case K_BOOL:
+            fprintf(c_fp, "%*creturnTemporarySymbol(addSymbolBool(NULL, %s));\n", indent, ' ', call);
+            break;
+        case K_NUMBER:
+            fprintf(c_fp, "%*creturnTemporarySymbol(addSymbolNumber(NULL, %s));\n", indent, ' ', call);
+            break;
+        case K_STRING:
+            fprintf(c_fp, "%*creturnTemporarySymbol(addSymbolString(NULL, %s));\n", indent, ' ', call);
+            break;
+        default:
+            fprintf(c_fp, "%*c%s;\n", indent, ' ', call);
+            break;
+    }
+    fprintf(c_fp, "}\n\n");
+    free(call);
 }
 
-void transpile_function_call_decision(FILE *c_fp, char *module_context, char* module, char *name, unsigned short indent) {
-    fprintf(
-        c_fp,
-        "%*cfunction_call_%llu->lineno = kaos_lineno;\n",
-        indent,
-        ' ',
-        compiler_function_counter
-    );
-    if (!isFunctionFromDynamicLibraryByModuleContext(name, module_context))
-        fprintf(c_fp, "%*ckaos_function_%s_%s();\n", indent, ' ', module, name);
-    _Function* function = getFunctionByModuleContext(name, module_context);
-    if (function->decision_node != NULL) {
-        fprintf(c_fp, "%*ckaos_decision_%s_%s();\n", indent, ' ', module, name);
+TypedCall* compiler_get_typed_call(ASTNode* ast_node) {
+    for (unsigned i = 0; i < typed_calls_size; i++) {
+        if (typed_calls[i].ast_node == ast_node && typed_calls[i].is_direct)
+            return &typed_calls[i];
     }
-    fprintf(
-        c_fp,
-        "%*ccallFunctionCleanUp(function_call_%llu, %s);\n",
-        indent,
-        ' ',
-        compiler_function_counter,
-        function->decision_node != NULL ? "true" : "false"
-    );
+    return NULL;
 }
 
-void transpile_function_call_create_var(FILE *c_fp, ASTNode* ast_node, char *module, enum Type type1, enum Type type2, unsigned short indent) {
-    compiler_function_counter++;
-    switch (ast_node->strings_size)
+bool compiler_transpile_typed_call(FILE *c_fp, ASTNode* ast_node, unsigned short indent) {
+    TypedCall* call = compiler_get_typed_call(ast_node);
+    if (call == NULL)
+        return false;
+
+    char *expression = transpile_typed_call_expression(call);
+    char *end = ast_node->node_type == AST_PRINT_FUNCTION_RETURN || ast_node->node_type == AST_PRETTY_PRINT_FUNCTION_RETURN ? "\\n" : "";
+    switch (ast_node->node_type)
     {
-        case 2:
-            fprintf(
-                c_fp,
-                "%*cFunctionCall* function_call_%llu = callFunction(\"%s\", NULL);\n",
-                indent,
-                ' ',
-                compiler_function_counter,
-                ast_node->strings[1]
-            );
-            transpile_function_call(c_fp, NULL, ast_node->strings[1], indent);
+        case AST_VAR_CREATE_BOOL_FUNC_RETURN:
+        case AST_VAR_CREATE_NUMBER_FUNC_RETURN:
+        case AST_VAR_CREATE_STRING_FUNC_RETURN:
+        case AST_VAR_UPDATE_FUNC_RETURN:
+            fprintf(c_fp, "%*ckaos_var_%s = %s;\n", indent, ' ', ast_node->strings[0], expression);
             break;
-        case 3:
-            fprintf(
-                c_fp,
-                "%*cFunctionCall* function_call_%llu = callFunction(\"%s\", \"%s\");\n",
-                indent,
-                ' ',
-                compiler_function_counter,
-                ast_node->strings[2],
-                ast_node->strings[1]
-            );
-            transpile_function_call(c_fp, ast_node->strings[1], ast_node->strings[2], indent);
+        case AST_PRINT_FUNCTION_RETURN:
+        case AST_ECHO_FUNCTION_RETURN:
+        case AST_PRETTY_PRINT_FUNCTION_RETURN:
+        case AST_PRETTY_ECHO_FUNCTION_RETURN:
+            switch (call->callee->function->type)
+            {
+                case K_BOOL:
+                    fprintf(c_fp, "%*coutputBool(%s, \"%s\");\n", indent, ' ', expression, end);
+                    break;
+                case K_NUMBER:
+                    fprintf(c_fp, "%*cprintNumber(%s, \"%s\");\n", indent, ' ', expression, end);
+                    break;
+                default:
+                    fprintf(c_fp, "%*coutputEscapedString(%s, \"%s\");\n", indent, ' ', expression, end);
+                    break;
+            }
             break;
         default:
+            fprintf(c_fp, "%*c%s;\n", indent, ' ', expression);
             break;
     }
-    fprintf(
-        c_fp,
-        "%*ccreateCloneFromFunctionReturn(\"%s\", %s, function_call_%llu, %s);\n"
-        "%*cupdateDecisionSymbolChainScope();\n"
-        "%*cfree(function_call_%llu);\n",
-        indent,
-        ' ',
-        ast_node->strings[0],
-        type_strings[type1],
-        compiler_function_counter,
-        type_strings[type2],
-        indent,
-        ' ',
-        indent,
-        ' ',
-        compiler_function_counter
-    );
+    free(expression);
+    return true;
+}
+
+void compiler_free_typed_functions() {
+    for (unsigned i = 0; i < typed_functions_size; i++) {
+        free(typed_functions[i].name);
+        free(typed_functions[i].parameters);
+    }
+    free(typed_functions);
+    typed_functions = NULL;
+    typed_functions_size = 0;
+    typed_functions_module = NULL;
+    typed_calls_enabled = false;
+}
+
+char* compiler_get_instrument_site(char *module, char *name) {
+    char *site = snprintf_concat_string(NULL, "kaos_site_%s", module);
+    return snprintf_concat_string(site, "_%s", name);
+}
+
+// The counters of an instrumented function, with the location of its definition in the Chaos source
+void compiler_transpile_instrument_site(FILE *c_fp, char *module, char *name, ASTNode* ast_node) {
+    instrument_site = compiler_get_instrument_site(module, name);
+    char *source = fix_bs(ast_node->module);
+    // The node of a definition is reduced at the newline that ends its header
+    fprintf(c_fp, "static InstrumentSite %s = {\"%s\", \"%s\", %d};\n\n", instrument_site, name, source, ast_node->lineno - 1);
+    free(source);
+}
+
+void compiler_transpile_instrument_hook(FILE *c_fp, char *hook, unsigned short indent) {
+    if (instrument_site == NULL)
+        return;
+    fprintf(c_fp, "%*c%s(&%s);\n", indent, ' ', hook, instrument_site);
+}
+
+void compiler_free_instrument_site() {
+    free(instrument_site);
+    instrument_site = NULL;
 }
 
 void compiler_handleModuleImport(char *module_name, bool directly_import, FILE *c_fp, unsigned short indent, FILE *h_fp) {
@@ -3702,7 +5994,49 @@ void compiler_handleModuleImport(char *module_name, bool directly_import, FILE *
     strcpy(compiled_module, module_path_stack.arr[module_path_stack.size - 1]);
     compiler_escape_module(compiled_module);
     ASTNode* ast_node = ast_root_node;
-    transpile_functions(ast_node, compiled_module, c_fp, indent, h_fp);
+
+    // Dynamic libraries have no functions to transpile, their spells are registered by the program
+    if (strcmp(get_filename_ext(module_path), __KAOS_DYNAMIC_LIBRARY_EXTENSION__) == 0) {
+        free(compiled_module);
+        moduleImportCleanUp(module_path);
+        return;
+    }
+
+    TranslationUnit* unit = compiler_get_translation_unit(compiled_module);
+    if (unit == NULL) {
+        unit = compiler_open_translation_unit(compiled_module);
+        // The program calls the functions of every module through its own header
+        TranslationUnit* main_unit = translation_units[0];
+        append_to_array(&main_unit->dependencies, compiled_module);
+        fprintf(main_unit->h_fp, "#include \"%s.h\"\n", compiled_module);
+    }
+
+    TranslationUnit* importer = compiler_get_translation_unit_by_header(h_fp);
+    if (
+        importer != NULL
+        &&
+        importer != translation_units[0]
+        &&
+        importer != unit
+        &&
+        !is_in_array(&importer->dependencies, compiled_module)
+    ) {
+        append_to_array(&importer->dependencies, compiled_module);
+        fprintf(importer->h_fp, "#include \"%s.h\"\n", compiled_module);
+    }
+
+    // The counters only name the locals of the C functions, starting them over keeps
+    // the C code of a module the same no matter which program imports it
+    unsigned long long loop_counter = compiler_loop_counter;
+    unsigned long long function_counter = compiler_function_counter;
+    unsigned long long symbol_counter = compiler_symbol_counter;
+    compiler_loop_counter = 0;
+    compiler_function_counter = 0;
+    compiler_symbol_counter = 0;
+    transpile_functions(ast_node, compiled_module, unit->c_fp, indent, unit->h_fp);
+    compiler_loop_counter = loop_counter;
+    compiler_function_counter = function_counter;
+    compiler_symbol_counter = symbol_counter;
     free(compiled_module);
 
     moduleImportCleanUp(module_path);
@@ -3752,6 +6086,7 @@ void compiler_handleModuleImportRegister(char *module_name, bool directly_import
         copy_binary_file(module_path, new_module_path);
         free(new_module_path);
 
+        compiler_register_static_functions(c_fp, indent);
         extension_counter++;
         fprintf(
             c_fp,
@@ -3885,6 +6220,134 @@ void free_transpiled_functions() {
     transpiled_modules.size = 0;
 }
 
+TranslationUnit* compiler_open_translation_unit(char *name) {
+    TranslationUnit* unit = malloc(sizeof(TranslationUnit));
+    unit->name = malloc(1 + strlen(name));
+    strcpy(unit->name, name);
+    unit->c_file_path = NULL;
+    unit->c_file_path = snprintf_concat_string(unit->c_file_path, "%s", __KAOS_BUILD_DIRECTORY__);
+    unit->c_file_path = snprintf_concat_string(unit->c_file_path, "%s", __KAOS_PATH_SEPARATOR__);
+    unit->c_file_path = snprintf_concat_string(unit->c_file_path, "%s.c", name);
+    unit->h_file_path = NULL;
+    unit->h_file_path = snprintf_concat_string(unit->h_file_path, "%s", __KAOS_BUILD_DIRECTORY__);
+    unit->h_file_path = snprintf_concat_string(unit->h_file_path, "%s", __KAOS_PATH_SEPARATOR__);
+    unit->h_file_path = snprintf_concat_string(unit->h_file_path, "%s.h", name);
+    unit->dependencies.capacity = 0;
+    unit->dependencies.size = 0;
+
+    printf("Compiling Chaos code into %s\n", unit->c_file_path);
+
+    errno = 0;
+
+    unit->c_fp = fopen(unit->c_file_path, "w");
+    if (unit->c_fp == NULL)
+    {
+        fprintf(stderr, "Cannot open file! Error no: %d\n", errno);
+        fprintf(stderr, "C source path: %s\n", unit->c_file_path);
+        exit(1);
+    }
+
+    unit->h_fp = fopen(unit->h_file_path, "w");
+    if (unit->h_fp == NULL)
+    {
+        fprintf(stderr, "Cannot open file! Error no: %d\n", errno);
+        fprintf(stderr, "C header path: %s\n", unit->h_file_path);
+        exit(1);
+    }
+
+    if (keep_translation_units) {
+        fprintf(
+            unit->h_fp,
+            "/*\n"
+            " * Intermediate C header code generated by Chaos Programming Language\n"
+            " * Language Reference: https://chaos-lang.org\n"
+            " *\n"
+            " * Filename: %s.h\n"
+            " */\n\n",
+            name
+        );
+        fprintf(
+            unit->c_fp,
+            "/*\n"
+            " * Intermediate C source code generated by Chaos Programming Language\n"
+            " * Language Reference: https://chaos-lang.org\n"
+            " *\n"
+            " * Filename: %s.c\n"
+            " */\n\n",
+            name
+        );
+    }
+
+    char *name_upper = malloc(1 + strlen(name));
+    strcpy(name_upper, name);
+    string_uppercase(name_upper);
+    fprintf(unit->h_fp, "#ifndef %s_H\n", name_upper);
+    fprintf(unit->h_fp, "#define %s_H\n\n", name_upper);
+    free(name_upper);
+
+    const char *h_file_base =
+        "#include <stdio.h>\n"
+        "#include <stdbool.h>\n\n"
+        "#include \"interpreter/function.h\"\n"
+        "#include \"interpreter/symbol.h\"\n\n"
+        "extern bool disable_complex_mode;\n"
+        "extern int kaos_lineno;\n\n";
+
+    fprintf(unit->h_fp, "%s", h_file_base);
+
+    fprintf(unit->c_fp, "#include <math.h>\n\n");
+    fprintf(unit->c_fp, "#include \"%s.h\"\n\n", name);
+
+    translation_units = realloc(translation_units, sizeof(TranslationUnit*) * (translation_units_size + 1));
+    translation_units[translation_units_size++] = unit;
+    return unit;
+}
+
+TranslationUnit* compiler_get_translation_unit(char *name) {
+    for (unsigned i = 0; i < translation_units_size; i++) {
+        if (strcmp(translation_units[i]->name, name) == 0)
+            return translation_units[i];
+    }
+    return NULL;
+}
+
+TranslationUnit* compiler_get_translation_unit_by_header(FILE *h_fp) {
+    for (unsigned i = 0; i < translation_units_size; i++) {
+        if (translation_units[i]->h_fp == h_fp)
+            return translation_units[i];
+    }
+    return NULL;
+}
+
+void compiler_close_translation_units() {
+    for (unsigned i = 0; i < translation_units_size; i++) {
+        fprintf(translation_units[i]->h_fp, "\n#endif\n");
+        fclose(translation_units[i]->c_fp);
+        fclose(translation_units[i]->h_fp);
+    }
+}
+
+void compiler_free_translation_units() {
+    for (unsigned i = 0; i < translation_units_size; i++) {
+        TranslationUnit* unit = translation_units[i];
+        if (!keep_translation_units) {
+            remove(unit->c_file_path);
+            remove(unit->h_file_path);
+        }
+        free(unit->name);
+        free(unit->c_file_path);
+        free(unit->h_file_path);
+        for (unsigned j = 0; j < unit->dependencies.size; j++) {
+            free(unit->dependencies.arr[j]);
+        }
+        if (unit->dependencies.size > 0) free(unit->dependencies.arr);
+        free(unit);
+    }
+    free(translation_units);
+    translation_units = NULL;
+    translation_units_size = 0;
+}
+
 void free_transpiled_decisions() {
     for (unsigned i = 0; i < transpiled_decisions.size; i++) {
         free(transpiled_decisions.arr[i]);
@@ -29,6 +29,7 @@
 #   include <windows.h>
 #else
 #   include <sys/wait.h>
+#   include <dirent.h>
 #endif
 
 #if defined(__APPLE__) && defined(__MACH__)
@@ -42,20 +43,191 @@
 #include "../ast/ast.h"
 #include "../preemptive/preemptive.h"
 
+// Runtime sources prebuilt with -O3 by `make install`, linked instead of compiling them on each compilation
+#define __KAOS_RUNTIME_LIBRARY__ "/usr/local/lib/libchaos-runtime.a"
+
+#define __KAOS_DEFAULT_OPTIMIZATION_LEVEL__ 2
+#define __KAOS_MAX_OPTIMIZATION_LEVEL__ 3
+#define __KAOS_COMPILER_FLAGS_MAX__ 8
+#define __KAOS_COMPILER_ARGS_BASE__ 32
+
+// Object files of the translation units, reused by the next compilation while their content hash holds
+#define __KAOS_OBJECTS_DIRECTORY__ "objects"
+#define __KAOS_HASH_OFFSET_BASIS__ 14695981039346656037ULL
+#define __KAOS_HASH_PRIME__ 1099511628211ULL
+
+// A scalar variable of the region being transpiled (the main program or a function body)
+// that lives in a C local instead of the symbol table, unless it escapes to the dynamic API
+typedef struct NativeVariable {
+    char *name;
+    enum Type type;
+    bool is_int;
+    bool is_float;
+    bool is_read;
+    bool is_escaped;
+    bool is_parameter;
+    bool is_loop_element;
+    bool is_out_of_scope;
+} NativeVariable;
+
+typedef struct NativeVariableCopy {
+    unsigned target;
+    unsigned source;
+} NativeVariableCopy;
+
+// The element of a foreach that is read by index from a bool or number list, which has to
+// keep the type of its element for the element to stay in C
+typedef struct NativeLoopElement {
+    unsigned variable;
+    char *list;
+    enum Type type;
+} NativeLoopElement;
+
+// A list of the region with the element type of its typed creations, K_ANY if any of them is not typed alike
+typedef struct NativeList {
+    char *name;
+    enum Type type;
+} NativeList;
+
+NativeVariable* native_variables;
+unsigned native_variables_size;
+NativeVariableCopy* native_variable_copies;
+unsigned native_variable_copies_size;
+NativeLoopElement* native_loop_elements;
+unsigned native_loop_elements_size;
+NativeList* native_lists;
+unsigned native_lists_size;
+bool native_variables_disabled;
+
+// A function of the program that is also transpiled into a C function which takes its
+// parameters and returns its value in C types, and runs its decision inline
+typedef struct TypedFunction {
+    _Function* function;
+    char *name;
+    ASTNode** parameters;
+    unsigned short parameter_count;
+    bool has_return;
+    bool is_typed;
+} TypedFunction;
+
+// A call of the region being transpiled that goes straight to the C function of a typed function
+typedef struct TypedCall {
+    ASTNode* ast_node;
+    TypedFunction* callee;
+    bool is_direct;
+} TypedCall;
+
+TypedFunction* typed_functions;
+unsigned typed_functions_size;
+TypedFunction* typed_function_mode;
+char *typed_functions_module;
+TypedCall* typed_calls;
+unsigned typed_calls_size;
+bool typed_calls_enabled;
+bool typed_call_arguments_mode;
+
+// A function whose parameters have no default value other than a literal, registered from
+// a static table of the compiled program instead of the calls that rebuild it at startup
+typedef struct StaticFunction {
+    ASTNode* ast_node;
+    char *context;
+    char *module_context;
+    char *module;
+    ASTNode** parameters;
+    unsigned short parameter_count;
+    unsigned short optional_parameter_count;
+} StaticFunction;
+
+StaticFunction* static_functions;
+unsigned static_functions_size;
+unsigned static_functions_registered;
+unsigned static_parameters_size;
+unsigned static_parameters_registered;
+string_array main_function_names;
+
+// A C source and header pair of the build directory, one for the program and one for each imported module
+typedef struct TranslationUnit {
+    char *name;
+    char *c_file_path;
+    char *h_file_path;
+    FILE *c_fp;
+    FILE *h_fp;
+    string_array dependencies;
+} TranslationUnit;
+
+TranslationUnit** translation_units;
+unsigned translation_units_size;
+bool keep_translation_units;
+
+// A loop of the C function being transpiled, the break or continue decision of a call inside it lands on the innermost one
+typedef struct TranspiledLoop {
+    unsigned long long id;
+    ASTNode* ast_node;
+    bool has_element_symbol;
+} TranspiledLoop;
+
+TranspiledLoop* transpiled_loops;
+unsigned transpiled_loops_size;
+// Whether the C function being transpiled is a function or a decision of the program, which returns on a break or continue outside of its loops
+bool loop_jump_returns;
+
+// The name of the static InstrumentSite of the function being transpiled by `--instrument`
+bool instrument_functions;
+char *instrument_site;
+
 string_array transpiled_functions;
 string_array transpiled_decisions;
 string_array transpiled_modules;
 
-void compile(char *module, enum Phase phase_arg, char *bin_file, char *extra_flags, bool keep, bool unsafe);
+void compile(char *module, enum Phase phase_arg, char *bin_file, char *extra_flags, bool keep, bool unsafe, unsigned short optimization_level, bool lto, char *pgo_args, unsigned jobs, bool instrument);
 ASTNode* transpile_functions(ASTNode* ast_node, char *module, FILE *c_fp, unsigned short indent, FILE *h_fp);
 ASTNode* transpile_decisions(ASTNode* ast_node, char *module, FILE *c_fp, unsigned short indent);
 ASTNode* compiler_register_functions(ASTNode* ast_node, char *module, FILE *c_fp, unsigned short indent);
+bool compiler_add_static_function(ASTNode* ast_node, FILE *c_fp, unsigned short indent);
+void compiler_register_static_functions(FILE *c_fp, unsigned short indent);
+void compiler_transpile_static_functions(FILE *c_fp);
+void compiler_free_static_functions();
 ASTNode* transpile_node(ASTNode* ast_node, char *module, FILE *c_fp, unsigned short indent);
 bool transpile_common_operator(ASTNode* ast_node, char *operator, enum ValueType left_value_type, enum ValueType right_value_type);
 bool transpile_common_mixed_operator(ASTNode* ast_node, char *operator);
 void transpile_function_call(FILE *c_fp, char *module, char *name, unsigned short indent);
 void transpile_function_call_decision(FILE *c_fp, char *module_context, char* module_context_compiler, char *name, unsigned short indent);
+void compiler_push_transpiled_loop(ASTNode* ast_node, unsigned long long id, bool has_element_symbol);
+void compiler_pop_transpiled_loop();
+void transpile_loop_jump(FILE *c_fp, unsigned short indent);
 void transpile_function_call_create_var(FILE *c_fp, ASTNode* ast_node, char *module, enum Type type1, enum Type type2, unsigned short indent);
+bool compiler_has_node_type(ASTNode* ast_node, enum ASTNodeType node_type);
+void compiler_escape_native_variables(ASTNode* ast_node);
+void compiler_analyze_native_variables(ASTNode* ast_node, char *module, bool is_function_body);
+void compiler_declare_native_variables(FILE *c_fp, unsigned short indent);
+void compiler_free_native_variables();
+NativeVariable* compiler_get_native_variable(char *name);
+char* compiler_read_native_variable(NativeVariable* variable, enum ValueType value_type);
+bool compiler_transpile_native_read(ASTNode* ast_node, enum ValueType value_type);
+bool compiler_transpile_native_comparison(ASTNode* ast_node, char *operator);
+bool compiler_transpile_native_increment(ASTNode* ast_node, bool assign_first);
+bool compiler_transpile_native_assignment(FILE *c_fp, ASTNode* ast_node, unsigned short indent);
+bool compiler_transpile_native_copy(FILE *c_fp, ASTNode* ast_node, unsigned short indent);
+bool compiler_transpile_native_print(FILE *c_fp, ASTNode* ast_node, char *end, unsigned short indent);
+bool compiler_transpile_native_return(FILE *c_fp, ASTNode* ast_node, unsigned short indent);
+bool compiler_transpile_native_parameter(FILE *c_fp, ASTNode* ast_node, unsigned short indent);
+void compiler_find_typed_functions(char *module);
+TypedFunction* compiler_get_typed_function(_Function* function);
+TypedFunction* compiler_get_typed_function_by_node(ASTNode* ast_node);
+bool compiler_analyze_typed_function(TypedFunction* typed_function, char *module);
+void compiler_transpile_typed_function(FILE *c_fp, FILE *h_fp, TypedFunction* typed_function, char *module, unsigned short indent);
+TypedCall* compiler_get_typed_call(ASTNode* ast_node);
+bool compiler_transpile_typed_call(FILE *c_fp, ASTNode* ast_node, unsigned short indent);
+void compiler_free_typed_functions();
+char* compiler_get_instrument_site(char *module, char *name);
+void compiler_transpile_instrument_site(FILE *c_fp, char *module, char *name, ASTNode* ast_node);
+void compiler_transpile_instrument_hook(FILE *c_fp, char *hook, unsigned short indent);
+void compiler_free_instrument_site();
+TranslationUnit* compiler_open_translation_unit(char *name);
+TranslationUnit* compiler_get_translation_unit(char *name);
+TranslationUnit* compiler_get_translation_unit_by_header(FILE *h_fp);
+void compiler_close_translation_units();
+void compiler_free_translation_units();
 void compiler_handleModuleImport(char *module_name, bool directly_import, FILE *c_fp, unsigned short indent, FILE *h_fp);
 void compiler_handleModuleImportRegister(char *module_name, bool directly_import, FILE *c_fp, unsigned short indent);
 char* compiler_getCurrentContext();
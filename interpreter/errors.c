@@ -159,6 +159,9 @@ void throw_error_base(
         case E_CONTINUE_CALL_MULTILINE_LOOP:
             sprintf(error_msg, "Call to a function with `continue` from a multiline loop: %s", str1);
             break;
+        case E_INVALID_JSON:
+            sprintf(error_msg, "Invalid JSON at position: %llu", llu1);
+            break;
         default:
             sprintf(error_msg, "Unkown error.");
             break;
@@ -174,9 +177,10 @@ void throw_error_base(
     } else {
         traceback_size = function_call_stack.size + 1;
     }
-    int cols[2 + traceback_size * 2];
-    char traceback_line_msg[traceback_size][__KAOS_MSG_LINE_LENGTH__];
-    char traceback_line[traceback_size][__KAOS_MSG_LINE_LENGTH__];
+    // Kept on the heap since the traceback grows with the call depth
+    int *cols = malloc((2 + traceback_size * 2) * sizeof(int));
+    char (*traceback_line_msg)[__KAOS_MSG_LINE_LENGTH__] = malloc(traceback_size * sizeof(*traceback_line_msg));
+    char (*traceback_line)[__KAOS_MSG_LINE_LENGTH__] = malloc(traceback_size * sizeof(*traceback_line));
 
     FILE* fp_module = NULL;
 
@@ -346,6 +350,9 @@ void throw_error_base(
 #endif
     fprintf(stderr, "\n");
     free(new_error_msg_out);
+    free(cols);
+    free(traceback_line_msg);
+    free(traceback_line);
     fflush(stderr);
 
 #ifndef CHAOS_COMPILER
@@ -69,7 +69,8 @@ enum ExitCode {
     E_CONTINUE_CALL_OUTSIDE_LOOP,
     E_BREAK_CALL_MULTILINE_LOOP,
     E_CONTINUE_CALL_MULTILINE_LOOP,
-    E_PREEMPTIVE
+    E_PREEMPTIVE,
+    E_INVALID_JSON
 };
 
 extern void freeEverything();
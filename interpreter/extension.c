@@ -80,26 +80,151 @@ void initKaosApi() {
     kaos.getRole = getRole;
     kaos.raiseError = raiseError;
     kaos.parseJson = parseJson;
+    kaos.getParameterHandle = getParameterHandle;
+    kaos.getVariableHandle = getVariableHandle;
+    kaos.getHandleType = getHandleType;
+    kaos.getHandleSecondaryType = getHandleSecondaryType;
+    kaos.getHandleValueType = getHandleValueType;
+    kaos.getHandleBool = getHandleBool;
+    kaos.getHandleInt = getHandleInt;
+    kaos.getHandleFloat = getHandleFloat;
+    kaos.getHandleString = getHandleString;
+    kaos.getHandleBoolByTypeCasting = getHandleBoolByTypeCasting;
+    kaos.getHandleIntByTypeCasting = getHandleIntByTypeCasting;
+    kaos.getHandleFloatByTypeCasting = getHandleFloatByTypeCasting;
+    kaos.getHandleStringByTypeCasting = getHandleStringByTypeCasting;
+    kaos.getHandleLength = getHandleLength;
+    kaos.getListElementHandle = getListElementHandle;
+    kaos.getDictElementHandle = getDictElementHandle;
+    kaos.getDictElementHandleByIndex = getDictElementHandleByIndex;
+    kaos.getHandleKey = getHandleKey;
+    kaos.copyHandle = copyHandle;
+    kaos.copyListToIntBuffer = copyListToIntBuffer;
+    kaos.copyListToFloatBuffer = copyListToFloatBuffer;
+    kaos.copyListToStringBuffer = copyListToStringBuffer;
+    kaos.returnListFromIntBuffer = returnListFromIntBuffer;
+    kaos.returnListFromFloatBuffer = returnListFromFloatBuffer;
+    kaos.returnListFromStringBuffer = returnListFromStringBuffer;
+    kaos.defineNativeFunction = defineNativeFunction;
 }
 
 void callRegisterInDynamicLibrary(char* dynamic_library_path) {
     dynamic_library dylib = getFunctionFromDynamicLibrary(dynamic_library_path, __KAOS_EXTENSION_REGISTER_FUNCTION__);
     dylib.func(kaos);
+    // Every registered function holds its own reference to the library
+    if (dylib.handle != NULL)
+        CLOSELIB(dylib.handle);
 #ifndef CHAOS_COMPILER
     if (is_interactive)
         phase = PROGRAM;
 #endif
 }
 
-void callFunctionFromDynamicLibrary(_Function* function) {
+static void callNativeFunctionFromDynamicLibrary(_Function* function, Symbol** parameters, unsigned short parameter_count) {
+    KaosValue args[KAOS_NATIVE_FUNCTION_MAX_PARAMETERS];
+    for (unsigned short i = 0; i < parameter_count; i++) {
+        Symbol* parameter = parameters[i];
+        args[i].b = false;
+        args[i].i = 0;
+        args[i].f = 0;
+        args[i].s = NULL;
+        switch (parameter->value_type)
+        {
+            case V_BOOL:
+                args[i].b = parameter->value.b;
+                break;
+            case V_INT:
+                args[i].i = parameter->value.i;
+                args[i].f = (long double) parameter->value.i;
+                break;
+            case V_FLOAT:
+                args[i].i = (long long) parameter->value.f;
+                args[i].f = parameter->value.f;
+                break;
+            case V_STRING:
+                args[i].s = parameter->value.s;
+                break;
+            default:
+                break;
+        }
+    }
+
+    KaosValue result = ((KaosNativeFunction) function->dynamic_function)(args, parameter_count);
+
+    union Value value;
+    enum ValueType value_type;
+    switch (function->type)
+    {
+        case K_BOOL:
+            value_type = V_BOOL;
+            value.b = result.b;
+            break;
+        case K_NUMBER:
+            // Whole numbers stay integers, as if the spell had called returnVariableInt
+            if (result.f >= (long double) LLONG_MIN && result.f < -(long double) LLONG_MIN && result.f == (long double) (long long) result.f) {
+                value_type = V_INT;
+                value.i = (long long) result.f;
+            } else {
+                value_type = V_FLOAT;
+                value.f = result.f;
+            }
+            break;
+        case K_STRING:
+            value_type = V_STRING;
+            if (result.s == NULL) {
+                result.s = malloc(1);
+                result.s[0] = '\0';
+            }
+            value.s = result.s;
+            break;
+        default:
+            return;
+    }
+
+    // The result goes straight into the caller's scope instead of being cloned out of the callee's
+    FunctionCall* function_call = function_call_stack.arr[function_call_stack.size - 1];
+    freeFunctionReturn(function_call);
+    function->symbol = addSymbolToScope(function_call->parent_scope, function->type, value, value_type);
+}
+
+void callFunctionFromDynamicLibrary(_Function* function, Symbol** parameters, unsigned short parameter_count) {
+    kaos_stats.dynamic_library_calls++;
+
+    if (function->is_native) {
+        callNativeFunctionFromDynamicLibrary(function, parameters, parameter_count);
+        free(parameters);
+        return;
+    }
+
+    Symbol** previous_parameters = dynamic_function_parameters;
+    unsigned short previous_parameter_count = dynamic_function_parameter_count;
+    dynamic_function_parameters = parameters;
+    dynamic_function_parameter_count = parameter_count;
+
+    function->dynamic_function();
+
+    dynamic_function_parameters = previous_parameters;
+    dynamic_function_parameter_count = previous_parameter_count;
+    free(parameters);
+}
+
+void resolveFunctionFromDynamicLibrary(_Function* function) {
     char* function_name = "";
     function_name = strcat_ext(function_name, __KAOS_EXTENSION_FUNCTION_PREFIX__);
     function_name = strcat_ext(function_name, function->name);
     dynamic_library dylib = getFunctionFromDynamicLibrary(function->module_context, function_name);
-    dylib.func();
+    function->dynamic_library = dylib.handle;
+    function->dynamic_function = (void (*)()) dylib.func;
     free(function_name);
 }
 
+void closeFunctionDynamicLibrary(_Function* function) {
+    if (function->dynamic_library != NULL)
+        CLOSELIB(function->dynamic_library);
+    function->dynamic_library = NULL;
+    function->dynamic_function = NULL;
+}
+
 dynamic_library getFunctionFromDynamicLibrary(char* dynamic_library_path, char* function_name) {
     dynamic_library dylib;
 
@@ -123,20 +248,7 @@ dynamic_library getFunctionFromDynamicLibrary(char* dynamic_library_path, char*
 }
 
 void returnVariable(Symbol* symbol) {
-    scope_override = function_call_stack.arr[function_call_stack.size - 1]->parent_scope;
-    function_call_stack.arr[function_call_stack.size - 1]->function->symbol = createCloneFromSymbol(
-        NULL,
-        symbol->type,
-        symbol,
-        symbol->secondary_type
-    );
-
-    decision_symbol_chain = createCloneFromSymbol(
-        NULL,
-        symbol->type,
-        symbol,
-        symbol->secondary_type
-    );
-    scope_override = NULL;
-    removeSymbol(symbol);
+    freeFunctionReturn(function_call_stack.arr[function_call_stack.size - 1]);
+    changeSymbolScope(symbol, function_call_stack.arr[function_call_stack.size - 1]->parent_scope);
+    function_call_stack.arr[function_call_stack.size - 1]->function->symbol = symbol;
 }
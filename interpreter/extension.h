@@ -24,6 +24,7 @@
 #define KAOS_EXTENSION_H
 
 #include <stdio.h>
+#include <limits.h>
 #if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
 #   include <windows.h>
 #   define LIBTYPE HINSTANCE
@@ -50,7 +51,12 @@ typedef struct dynamic_library {
 
 void initKaosApi();
 void callRegisterInDynamicLibrary(char* dynamic_library_path);
-void callFunctionFromDynamicLibrary(_Function* function);
+Symbol** dynamic_function_parameters;
+unsigned short dynamic_function_parameter_count;
+
+void callFunctionFromDynamicLibrary(_Function* function, Symbol** parameters, unsigned short parameter_count);
+void resolveFunctionFromDynamicLibrary(_Function* function);
+void closeFunctionDynamicLibrary(_Function* function);
 dynamic_library getFunctionFromDynamicLibrary(char* dynamic_library_path, char* function_name);
 void returnVariable(Symbol* symbol);
 
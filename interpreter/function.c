@@ -23,14 +23,13 @@
 #include "function.h"
 
 extern int kaos_lineno;
-extern int yyparse();
 
 bool decision_execution_mode = false;
 FunctionCall* function_call_start = NULL;
 
 #ifdef CHAOS_COMPILER
-extern jmp_buf LoopBreak;
-extern jmp_buf LoopContinue;
+// Set by a break or continue decision, the loops of a compiled program act on it after the call returns
+enum LoopJump loop_jump = LOOP_JUMP_NONE;
 #endif
 
 #ifdef CHAOS_COMPILER
@@ -103,6 +102,7 @@ void startFunction(char *name, enum Type type, enum Type secondary_type) {
         fake_ast_end->module = function_mode->module_context;
         fake_ast_end->child = fake_ast_end;
         function_mode->node = fake_ast_end;
+        resolveFunctionFromDynamicLibrary(function_mode);
     }
 
     if (start_function == NULL) {
@@ -162,6 +162,63 @@ void endFunction() {
     freeFunctionParametersMode();
 }
 
+#ifdef CHAOS_COMPILER
+static Symbol* addStaticParameter(const StaticParameter* parameter) {
+    Symbol* symbol;
+    union Value value;
+    switch (parameter->value_type)
+    {
+        case V_BOOL:
+            symbol = addSymbolBool(NULL, parameter->b);
+            break;
+        case V_INT:
+            symbol = addSymbolInt(NULL, parameter->i);
+            break;
+        case V_FLOAT:
+            symbol = addSymbolFloat(NULL, parameter->f);
+            break;
+        case V_STRING:
+            symbol = addSymbolString(NULL, parameter->s);
+            break;
+        default:
+            value.i = 0;
+            symbol = addSymbol(NULL, parameter->type, value, V_VOID);
+            symbol->secondary_type = parameter->secondary_type;
+            break;
+    }
+    symbol->secondary_name = malloc(1 + strlen(parameter->name));
+    strcpy(symbol->secondary_name, parameter->name);
+    symbol->role = PARAM;
+    return symbol;
+}
+
+// Links the functions of a compiled program's static table into the function list as they are,
+// the parameters of each function follow the ones of the previous function in the order of
+// their creation, which is the reverse of their declaration
+void registerStaticFunctions(_Function* functions, unsigned function_count, const StaticParameter* parameters) {
+    for (unsigned i = 0; i < function_count; i++) {
+        _Function* function = &functions[i];
+
+        if (function->parameter_count > 0)
+            function->parameters = malloc(sizeof(Symbol*) * function->parameter_count);
+
+        for (unsigned short j = function->parameter_count; j > 0; j--) {
+            Symbol* parameter = addStaticParameter(parameters++);
+            parameter->param_of = function;
+            function->parameters[j - 1] = parameter;
+        }
+
+        if (start_function == NULL) {
+            start_function = function;
+        } else {
+            end_function->next = function;
+            function->previous = end_function;
+        }
+        end_function = function;
+    }
+}
+#endif
+
 void freeFunctionParametersMode() {
     if (function_parameters_mode == NULL) return;
 
@@ -193,6 +250,7 @@ FunctionCall* callFunction(char *name, char *module) {
     }
     function_call_start = NULL;
     function_call->function = function;
+    kaos_stats.function_calls++;
 #ifndef CHAOS_COMPILER
     function_call->dont_pop_module_stack = false;
 #endif
@@ -251,6 +309,10 @@ FunctionCall* callFunction(char *name, char *module) {
                 throw_error(E_ILLEGAL_VARIABLE_TYPE_FOR_FUNCTION_PARAMETER, parameter->secondary_name, function->name);
             }
 
+            // A native spell function reads its arguments by position, they need no names
+            if (function->is_native)
+                continue;
+
             if ((parameter->type == K_LIST || parameter->type == K_DICT) && parameter->secondary_type != K_ANY) {
                 for (unsigned long i = 0; i < parameter_call->children_count; i++) {
                     Symbol* child = parameter_call->children[i];
@@ -271,9 +333,23 @@ FunctionCall* callFunction(char *name, char *module) {
     }
     scope_override = NULL;
 
+    // A spell function receives its parameters by position through the Kaos API
+    Symbol** dynamic_parameters = NULL;
+    unsigned short dynamic_parameter_count = 0;
+    if (function->is_dynamic && function_parameters_mode != NULL) {
+        dynamic_parameters = function_parameters_mode->parameters;
+        dynamic_parameter_count = function_parameters_mode->parameter_count;
+        function_parameters_mode->parameters = NULL;
+        function_parameters_mode->parameter_count = 0;
+    }
+
     freeFunctionParametersMode();
 
     FunctionCall* parent_scope = getCurrentScope();
+#ifdef CHAOS_COMPILER
+    // A call in a loop sets it right after, the rest are in a loop if their caller is
+    function_call->is_in_loop = function_call_stack.size > 0 && function_call_stack.arr[function_call_stack.size - 1]->is_in_loop;
+#endif
     pushExecutedFunctionStack(function_call);
     function_call_stack.arr[function_call_stack.size - 1]->parent_scope = parent_scope;
 
@@ -298,7 +374,7 @@ FunctionCall* callFunction(char *name, char *module) {
 #endif
 
     if (function->is_dynamic) {
-        callFunctionFromDynamicLibrary(function);
+        callFunctionFromDynamicLibrary(function, dynamic_parameters, dynamic_parameter_count);
     }
 
     return function_call;
@@ -310,16 +386,8 @@ void callFunctionCleanUp(FunctionCall* function_call) {
 void callFunctionCleanUp(FunctionCall* function_call, bool has_decision) {
 #endif
 
-    bool is_loop_breaked = false;
-    bool is_loop_continued = false;
-
-#ifndef CHAOS_COMPILER
-    if (setjmp(LoopBreakDecision))
-        is_loop_breaked = true;
-
-    if (setjmp(LoopContinueDecision))
-        is_loop_continued = true;
-#endif
+    bool is_loop_breaked = loop_jump == LOOP_JUMP_BREAK;
+    bool is_loop_continued = loop_jump == LOOP_JUMP_CONTINUE;
 
 #ifdef CHAOS_COMPILER
     if (has_decision) {
@@ -360,14 +428,8 @@ void callFunctionCleanUp(FunctionCall* function_call, bool has_decision) {
     }
 #endif
 
-    if (is_loop_breaked) {
+    if (is_loop_breaked || is_loop_continued) {
         free(function_call);
-        breakLoop();
-    }
-
-    if (is_loop_continued) {
-        free(function_call);
-        continueLoop();
     }
 }
 
@@ -634,7 +696,16 @@ void addFunctionCallParameterList(enum Type type) {
 }
 
 void returnSymbol(char *name) {
-    Symbol* symbol = getSymbol(name);
+    _returnSymbol(getSymbol(name));
+}
+
+// Returns a value the compiled code holds in a native C variable, through an unnamed symbol made only for that
+void returnTemporarySymbol(Symbol* symbol) {
+    _returnSymbol(symbol);
+    removeSymbol(symbol);
+}
+
+void _returnSymbol(Symbol* symbol) {
     if (symbol->type != K_ANY &&
         function_call_stack.arr[function_call_stack.size - 1]->function->type != K_ANY &&
         symbol->type != function_call_stack.arr[function_call_stack.size - 1]->function->type
@@ -648,6 +719,8 @@ void returnSymbol(char *name) {
         throw_error(E_ILLEGAL_VARIABLE_TYPE_FOR_FUNCTION, getTypeName(symbol->secondary_type), function_call_stack.arr[function_call_stack.size - 1]->function->name);
     }
 
+    // The return slot holds the only copy, the caller moves it into its destination
+    freeFunctionReturn(function_call_stack.arr[function_call_stack.size - 1]);
     scope_override = function_call_stack.arr[function_call_stack.size - 1]->parent_scope;
     function_call_stack.arr[function_call_stack.size - 1]->function->symbol = createCloneFromSymbol(
         NULL,
@@ -655,14 +728,6 @@ void returnSymbol(char *name) {
         symbol,
         symbol->secondary_type
     );
-
-    decision_symbol_chain = createCloneFromSymbol(
-        NULL,
-        symbol->type,
-        symbol,
-        symbol->secondary_type
-    );
-
     scope_override = NULL;
 }
 
@@ -680,8 +745,8 @@ void createCloneFromFunctionReturn(char *clone_name, enum Type type, FunctionCal
         throw_error(E_FUNCTION_DID_NOT_RETURN_ANYTHING, function_call->function->name);
         return;
     }
-    createCloneFromSymbol(clone_name, type, function_call->function->symbol, extra_type);
-    freeFunctionReturn(function_call);
+    createSymbolByMoving(clone_name, type, function_call->function->symbol, extra_type);
+    function_call->function->symbol = NULL;
 }
 
 void updateSymbolByClonningFunctionReturn(char *clone_name, FunctionCall* function_call) {
@@ -689,8 +754,8 @@ void updateSymbolByClonningFunctionReturn(char *clone_name, FunctionCall* functi
         throw_error(E_FUNCTION_DID_NOT_RETURN_ANYTHING, function_call->function->name);
         return;
     }
-    updateSymbolByClonning(clone_name, function_call->function->symbol);
-    freeFunctionReturn(function_call);
+    updateSymbolByMoving(clone_name, function_call->function->symbol);
+    function_call->function->symbol = NULL;
 }
 
 void updateComplexSymbolByClonningFunctionReturn(FunctionCall* function_call) {
@@ -712,7 +777,8 @@ void initMainFunction() {
     initScopeless();
     initMainContext();
     initKaosApi();
-#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
+#if defined(CHAOS_COMPILER) && !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
+    // Transpiled functions recurse on the native stack, the interpreter does not need this
     increaseStackSize();
 #endif
 }
@@ -771,7 +837,6 @@ void removeFunction(_Function* function) {
 }
 
 void freeFunction(_Function* function) {
-    free(function->name);
     free(function->parameters);
     for (unsigned i = 0; i < function->decision_functions.size; i++) {
         free(function->decision_expressions.arr[i]);
@@ -780,11 +845,18 @@ void freeFunction(_Function* function) {
     free(function->decision_expressions.arr);
     free(function->decision_functions.arr);
     free(function->decision_default);
+    freeDecisionTable(function->decision_table);
+    // The strings and the memory of a function from a static table belong to the compiled program
+    if (function->is_static)
+        return;
+    free(function->name);
     free(function->context);
     free(function->module_context);
     free(function->module);
-    if (function->is_dynamic)
+    if (function->is_dynamic) {
         free(function->node);
+        closeFunctionDynamicLibrary(function);
+    }
     free(function);
 }
 
@@ -852,27 +924,168 @@ void executeDecision(FunctionCall* function_call) {
         return;
     }
 
-    eval_node(function_call->function->decision_node, function_call->function->module_context);
-    stop_ast_evaluation = false;
+    // The decision block itself is evaluated by eval_node before the clean up
 #endif
 
     if (decision_symbol_chain == NULL)
         return;
 
+    // Adopt the return value of the function that the decision has called
     if (function_call_stack.arr[function_call_stack.size - 1]->function->type != K_VOID && function_call_stack.arr[function_call_stack.size - 1]->function->symbol == NULL) {
-        scope_override = function_call_stack.arr[function_call_stack.size - 1]->parent_scope;
-        function_call_stack.arr[function_call_stack.size - 1]->function->symbol = createCloneFromSymbol(
-            NULL,
-            decision_symbol_chain->type,
-            decision_symbol_chain,
-            decision_symbol_chain->secondary_type
-        );
-        scope_override = NULL;
-    }
-    if (function_call_stack.size < 2 && decision_symbol_chain != NULL) {
+        changeSymbolScope(decision_symbol_chain, function_call_stack.arr[function_call_stack.size - 1]->parent_scope);
+        function_call_stack.arr[function_call_stack.size - 1]->function->symbol = decision_symbol_chain;
+    } else {
         removeSymbol(decision_symbol_chain);
-        decision_symbol_chain = NULL;
     }
+    decision_symbol_chain = NULL;
+}
+
+DecisionTable* compileDecision(ASTNode* decision_node) {
+    DecisionTable* decision_table = (struct DecisionTable*)calloc(1, sizeof(DecisionTable));
+    addDecisionCase(decision_table, decision_node);
+
+    // A block that only compares the same variable against integer constants
+    // is dispatched by reading that variable once instead of evaluating the expressions
+    for (unsigned i = 0; i < decision_table->size; i++) {
+        DecisionCase* decision_case = &decision_table->cases[i];
+        ASTNode* predicate = decision_case->predicate;
+        if (predicate == NULL)
+            continue;
+
+        if (predicate->node_type < AST_BOOLEAN_EXPRESSION_REL_EQUAL_EXP ||
+            predicate->node_type > AST_BOOLEAN_EXPRESSION_REL_SMALL_EQUAL_EXP
+        )
+            goto compile_decision_generic;
+
+        ASTNode* variable = predicate->left;
+        ASTNode* constant = predicate->right;
+        decision_case->relation = predicate->node_type;
+        if (variable->node_type == AST_EXPRESSION_VALUE) {
+            variable = predicate->right;
+            constant = predicate->left;
+            switch (predicate->node_type)
+            {
+                case AST_BOOLEAN_EXPRESSION_REL_GREAT_EXP:
+                    decision_case->relation = AST_BOOLEAN_EXPRESSION_REL_SMALL_EXP;
+                    break;
+                case AST_BOOLEAN_EXPRESSION_REL_SMALL_EXP:
+                    decision_case->relation = AST_BOOLEAN_EXPRESSION_REL_GREAT_EXP;
+                    break;
+                case AST_BOOLEAN_EXPRESSION_REL_GREAT_EQUAL_EXP:
+                    decision_case->relation = AST_BOOLEAN_EXPRESSION_REL_SMALL_EQUAL_EXP;
+                    break;
+                case AST_BOOLEAN_EXPRESSION_REL_SMALL_EQUAL_EXP:
+                    decision_case->relation = AST_BOOLEAN_EXPRESSION_REL_GREAT_EQUAL_EXP;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        if (variable->node_type != AST_VAR_EXPRESSION_VALUE ||
+            constant->node_type != AST_EXPRESSION_VALUE ||
+            constant->value_type != V_INT ||
+            (decision_table->subject != NULL && strcmp(decision_table->subject, variable->strings[0]) != 0)
+        )
+            goto compile_decision_generic;
+
+        decision_case->constant = constant->value.i;
+        decision_table->subject = variable->strings[0];
+    }
+    return decision_table;
+
+compile_decision_generic:
+    decision_table->subject = NULL;
+    return decision_table;
+}
+
+void addDecisionCase(DecisionTable* decision_table, ASTNode* ast_node) {
+    if (ast_node == NULL)
+        return;
+
+    // Flatten the steps in the order eval_node would visit them
+    if (ast_node->node_type == AST_FUNCTION_STEP) {
+        addDecisionCase(decision_table, ast_node->depend);
+        addDecisionCase(decision_table, ast_node->right);
+        addDecisionCase(decision_table, ast_node->left);
+        return;
+    }
+
+    if (decision_table->capacity == 0) {
+        decision_table->cases = (DecisionCase*)malloc((decision_table->capacity = 4) * sizeof(DecisionCase));
+    } else if (decision_table->capacity == decision_table->size) {
+        decision_table->cases = (DecisionCase*)realloc(decision_table->cases, (decision_table->capacity *= 2) * sizeof(DecisionCase));
+    }
+
+    DecisionCase* decision_case = &decision_table->cases[decision_table->size++];
+    decision_case->ast_node = ast_node;
+    decision_case->predicate = ast_node->node_type < AST_DECISION_MAKE_DEFAULT ? ast_node->right : NULL;
+    decision_case->relation = AST_FUNCTION_STEP;
+    decision_case->constant = 0;
+}
+
+#ifndef CHAOS_COMPILER
+ASTNode* selectDecision(DecisionTable* decision_table, char *module) {
+    long long value = 0;
+    if (decision_table->subject != NULL)
+        value = getSymbolValueInt(decision_table->subject);
+
+    for (unsigned i = 0; i < decision_table->size; i++) {
+        DecisionCase* decision_case = &decision_table->cases[i];
+        ASTNode* ast_node = decision_case->ast_node;
+
+        if ((ast_node->node_type == AST_DECISION_MAKE_BOOLEAN_BREAK ||
+            ast_node->node_type == AST_DECISION_MAKE_BOOLEAN_CONTINUE ||
+            ast_node->node_type == AST_DECISION_MAKE_DEFAULT_BREAK ||
+            ast_node->node_type == AST_DECISION_MAKE_DEFAULT_CONTINUE) &&
+            nested_loop_counter == 0
+        )
+            continue;
+
+        if (decision_case->predicate == NULL)
+            return ast_node;
+
+        if (decision_table->subject == NULL) {
+            eval_node(decision_case->predicate, module);
+        } else {
+            switch (decision_case->relation)
+            {
+                case AST_BOOLEAN_EXPRESSION_REL_EQUAL_EXP:
+                    decision_case->predicate->value.b = value == decision_case->constant;
+                    break;
+                case AST_BOOLEAN_EXPRESSION_REL_NOT_EQUAL_EXP:
+                    decision_case->predicate->value.b = value != decision_case->constant;
+                    break;
+                case AST_BOOLEAN_EXPRESSION_REL_GREAT_EXP:
+                    decision_case->predicate->value.b = value > decision_case->constant;
+                    break;
+                case AST_BOOLEAN_EXPRESSION_REL_SMALL_EXP:
+                    decision_case->predicate->value.b = value < decision_case->constant;
+                    break;
+                case AST_BOOLEAN_EXPRESSION_REL_GREAT_EQUAL_EXP:
+                    decision_case->predicate->value.b = value >= decision_case->constant;
+                    break;
+                case AST_BOOLEAN_EXPRESSION_REL_SMALL_EQUAL_EXP:
+                    decision_case->predicate->value.b = value <= decision_case->constant;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        if (decision_case->predicate->value.b)
+            return ast_node;
+    }
+    return NULL;
+}
+#endif
+
+void freeDecisionTable(DecisionTable* decision_table) {
+    if (decision_table == NULL)
+        return;
+
+    free(decision_table->cases);
+    free(decision_table);
 }
 
 void addFunctionNameToFunctionNamesBuffer(char *name) {
@@ -914,9 +1127,19 @@ void pushExecutedFunctionStack(FunctionCall* function_call) {
 
     function_call_stack.arr[function_call_stack.size] = function_call;
     function_call_stack.size++;
+
+#ifndef CHAOS_COMPILER
+    if (profile_enabled)
+        profileFunctionEnter(function_call->function);
+#endif
 }
 
 void popExecutedFunctionStack() {
+#ifndef CHAOS_COMPILER
+    if (profile_enabled)
+        profileFunctionExit();
+#endif
+
     function_call_stack.arr[function_call_stack.size - 1] = NULL;
     function_call_stack.size--;
 }
@@ -928,25 +1151,32 @@ void freeFunctionReturn(FunctionCall* function_call) {
     }
 }
 
+void chainFunctionReturn(FunctionCall* function_call) {
+    if (function_call->function->symbol == NULL)
+        return;
+
+    if (decision_symbol_chain != NULL)
+        removeSymbol(decision_symbol_chain);
+    decision_symbol_chain = function_call->function->symbol;
+    function_call->function->symbol = NULL;
+}
+
 void decisionBreakLoop() {
 #ifdef CHAOS_COMPILER
-    callFunctionCleanUpSymbols(function_call_stack.arr[function_call_stack.size - 1]);
-    free(function_call_stack.arr[function_call_stack.size - 1]);
-    callFunctionCleanUpCommon();
-    longjmp(LoopBreak, 1);
+    // The call is cleaned up by callFunctionCleanUp, then the loop breaks at the call site
+    loop_jump = LOOP_JUMP_BREAK;
 #else
-    longjmp(LoopBreakDecision, 1);
+    breakLoop();
+    stop_ast_evaluation = true;
 #endif
 }
 
 void decisionContinueLoop() {
 #ifdef CHAOS_COMPILER
-    callFunctionCleanUpSymbols(function_call_stack.arr[function_call_stack.size - 1]);
-    free(function_call_stack.arr[function_call_stack.size - 1]);
-    callFunctionCleanUpCommon();
-    longjmp(LoopContinue, 1);
+    loop_jump = LOOP_JUMP_CONTINUE;
 #else
-    longjmp(LoopContinueDecision, 1);
+    continueLoop();
+    stop_ast_evaluation = true;
 #endif
 }
 
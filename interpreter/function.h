@@ -43,15 +43,32 @@ typedef struct FunctionCall FunctionCall;
 #include "../utilities/language.h"
 #include "../utilities/helpers.h"
 #include "module.h"
+#include "profiler.h"
+#include "stats.h"
 
 extern enum Phase phase;
 enum BlockType { B_EXPRESSION, B_FUNCTION };
 
+typedef struct DecisionCase {
+    struct ASTNode* ast_node;
+    struct ASTNode* predicate;
+    unsigned relation;
+    long long constant;
+} DecisionCase;
+
+typedef struct DecisionTable {
+    DecisionCase* cases;
+    unsigned capacity;
+    unsigned size;
+    char *subject;
+} DecisionTable;
+
 typedef struct _Function {
     char *name;
     int line_no;
     struct ASTNode* node;
     struct ASTNode* decision_node;
+    struct DecisionTable* decision_table;
     struct Symbol** parameters;
     unsigned short parameter_count;
     unsigned short optional_parameter_count;
@@ -67,8 +84,28 @@ typedef struct _Function {
     char *module_context;
     char *module;
     bool is_dynamic;
+    void *dynamic_library;
+    void (*dynamic_function)();
+    bool is_native;
+    unsigned profile_id;
+    bool is_static;
 } _Function;
 
+#ifdef CHAOS_COMPILER
+// A parameter in the static function table of a compiled program, the value is the default
+// value of an optional parameter and the value type of a required one is V_VOID
+typedef struct StaticParameter {
+    char *name;
+    enum Type type;
+    enum Type secondary_type;
+    enum ValueType value_type;
+    bool b;
+    long long i;
+    long double f;
+    char *s;
+} StaticParameter;
+#endif
+
 _Function* function_cursor;
 _Function* start_function;
 _Function* end_function;
@@ -86,6 +123,9 @@ typedef struct FunctionCall {
     Symbol* end_symbol;
 #ifndef CHAOS_COMPILER
     bool dont_pop_module_stack;
+#else
+    // Whether a loop of the program is around the call, so that a break or continue decision applies
+    bool is_in_loop;
 #endif
 } FunctionCall;
 
@@ -109,9 +149,6 @@ char *decision_buffer;
 
 string_array function_names_buffer;
 
-jmp_buf LoopBreakDecision;
-jmp_buf LoopContinueDecision;
-
 #ifdef CHAOS_COMPILER
 void startFunction(char *name, enum Type type, enum Type secondary_type, char* context, char* module_context, char* module, bool is_dynamic);
 #else
@@ -119,6 +156,9 @@ void startFunction(char *name, enum Type type, enum Type secondary_type);
 #endif
 
 void endFunction();
+#ifdef CHAOS_COMPILER
+void registerStaticFunctions(_Function* functions, unsigned function_count, const StaticParameter* parameters);
+#endif
 void freeFunctionParametersMode();
 void resetFunctionParametersMode();
 _Function* getFunction(char *name, char *module);
@@ -151,6 +191,8 @@ void addFunctionCallParameterString(char *s);
 void addFunctionCallParameterSymbol(char *name);
 void addFunctionCallParameterList(enum Type type);
 void returnSymbol(char *name);
+void returnTemporarySymbol(Symbol* symbol);
+void _returnSymbol(Symbol* symbol);
 void printFunctionReturn(FunctionCall* function_call, char *end, bool pretty, bool escaped);
 void createCloneFromFunctionReturn(char *clone_name, enum Type type, FunctionCall* function_call, enum Type extra_type);
 void updateSymbolByClonningFunctionReturn(char *clone_name, FunctionCall* function_call);
@@ -169,6 +211,12 @@ bool block(enum BlockType type);
 void addBooleanDecision();
 void addDefaultDecision();
 void executeDecision(FunctionCall* function);
+DecisionTable* compileDecision(struct ASTNode* decision_node);
+void addDecisionCase(DecisionTable* decision_table, struct ASTNode* ast_node);
+#ifndef CHAOS_COMPILER
+struct ASTNode* selectDecision(DecisionTable* decision_table, char *module);
+#endif
+void freeDecisionTable(DecisionTable* decision_table);
 void addFunctionNameToFunctionNamesBuffer(char *name);
 void freeFunctionNamesBuffer();
 bool isInFunctionNamesBuffer(char *name);
@@ -177,6 +225,7 @@ void setScopeless(Symbol* symbol);
 void pushExecutedFunctionStack(FunctionCall* function_call);
 void popExecutedFunctionStack();
 void freeFunctionReturn(FunctionCall* function_call);
+void chainFunctionReturn(FunctionCall* function_call);
 void decisionBreakLoop();
 void decisionContinueLoop();
 void updateDecisionSymbolChainScope();
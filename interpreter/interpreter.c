@@ -23,12 +23,15 @@
 #include <math.h>
 
 #include "interpreter.h"
+#include "loop.h"
 
 extern bool decision_execution_mode;
 extern bool disable_complex_mode;
 extern unsigned long long nested_loop_counter;
 
+enum Phase phase = INIT_PROGRAM;
 int kaos_lineno = 0;
+unsigned long long stats_ast_nodes[__KAOS_AST_NODE_TYPE_COUNT__];
 
 #ifndef CHAOS_COMPILER
 void interpret(char *module, enum Phase phase_arg, bool is_interactive, bool unsafe) {
@@ -38,6 +41,8 @@ void interpret(char *module, enum Phase phase_arg) {
     ASTNode* ast_node = ast_root_node;
 
 #ifndef CHAOS_COMPILER
+    unsigned long long stats_time;
+
     if (is_interactive) {
         if (ast_interactive_cursor != NULL) {
             ast_node = ast_interactive_cursor->next;
@@ -54,19 +59,28 @@ void interpret(char *module, enum Phase phase_arg) {
             register_functions(ast_node, module);
 #ifndef CHAOS_COMPILER
             if (!unsafe) {
+                stats_time = profileClock();
                 if (is_interactive) {
                     if (end_function != NULL)
                         preemptive_check();
                 } else {
                     preemptive_check();
                 }
+                kaos_stats.preemptive_time += profileClock() - stats_time;
             }
 #endif
             phase = PROGRAM;
             break;
         case PROGRAM:
             phase = PROGRAM;
+#ifndef CHAOS_COMPILER
+            kaos_stats.execution_start = profileClock();
+#endif
             eval_node(ast_node, module);
+#ifndef CHAOS_COMPILER
+            kaos_stats.execution_time += profileClock() - kaos_stats.execution_start;
+            kaos_stats.execution_start = 0;
+#endif
             break;
         default:
             break;
@@ -77,16 +91,25 @@ void interpret(char *module, enum Phase phase_arg) {
         register_functions(ast_node, module);
 #ifndef CHAOS_COMPILER
         if (!unsafe) {
+            stats_time = profileClock();
             if (is_interactive) {
                 if (end_function != NULL)
                     preemptive_check();
             } else {
                 preemptive_check();
             }
+            kaos_stats.preemptive_time += profileClock() - stats_time;
         }
 #endif
         phase = PROGRAM;
+#ifndef CHAOS_COMPILER
+        kaos_stats.execution_start = profileClock();
+#endif
         eval_node(ast_node, module);
+#ifndef CHAOS_COMPILER
+        kaos_stats.execution_time += profileClock() - kaos_stats.execution_start;
+        kaos_stats.execution_start = 0;
+#endif
     }
 
     ast_interactive_cursor = ast_node_cursor;
@@ -286,6 +309,8 @@ register_functions_label:
             break;
         case AST_DECISION_DEFINE:
             decision_mode->decision_node = ast_node->right;
+            freeDecisionTable(decision_mode->decision_table);
+            decision_mode->decision_table = compileDecision(ast_node->right);
             decision_mode = NULL;
             break;
         default:
@@ -294,6 +319,8 @@ register_functions_label:
 
     if (ast_node->node_type >= AST_DEFINE_FUNCTION_BOOL && ast_node->node_type <= AST_DEFINE_FUNCTION_VOID && function_mode != NULL) {
         function_mode->node = ast_node;
+        // A repeated import registers the same node again, it must still be transpiled
+        ast_node->dont_transpile = false;
         decision_mode = function_mode;
         function_mode = NULL;
     }
@@ -303,9 +330,22 @@ register_functions_label:
 }
 
 ASTNode* eval_node(ASTNode* ast_node, char *module) {
+    unsigned eval_stack_base = eval_stack.size;
+    EvalFrame* frame;
+    ASTNode* child;
+    Symbol* symbol;
+    FunctionCall* function_call;
+    long double l_value;
+    long double r_value;
+    long long exit_code;
+    char *_module;
+#ifndef CHAOS_COMPILER
+    struct Loop* loop;
+#endif
+
 eval_node_label:
     if (ast_node == NULL || stop_ast_evaluation) {
-        return ast_node;
+        goto eval_node_return;
     }
 
     if (strcmp(ast_node->module, module) != 0) {
@@ -324,19 +364,23 @@ eval_node_label:
             goto eval_node_label;
         }
 
-    if (ast_node->depend != NULL) {
-        eval_node(ast_node->depend, module);
-    }
-
-    if (ast_node->right != NULL) {
-        eval_node(ast_node->right, module);
-    }
-
-    if (ast_node->left != NULL) {
-        eval_node(ast_node->left, module);
+    if (ast_node->depend != NULL || ast_node->right != NULL || ast_node->left != NULL) {
+        pushEvalStack(EVAL_FRAME_CHILDREN, ast_node, module);
+        goto eval_node_children;
     }
 
+eval_node_execute:
     kaos_lineno = ast_node->lineno;
+    stats_ast_nodes[ast_node->node_type]++;
+#ifndef CHAOS_COMPILER
+    if (profile_enabled)
+        profileLine(ast_node);
+#endif
+    function_call = NULL;
+    _module = NULL;
+#ifndef CHAOS_COMPILER
+    loop = NULL;
+#endif
 
     if (debug_enabled)
         printf(
@@ -350,16 +394,39 @@ eval_node_label:
 
     if (ast_node->node_type == AST_END) {
 #ifndef CHAOS_COMPILER
-        ASTNode* ast_node_prev = eval_node_after_function_call(ast_node);
-        if (ast_node_prev != NULL) {
-            ast_node = ast_node_prev->next;
-            module = ast_node_prev->module;
-            goto eval_node_label;
-        } else {
-#endif
-            return ast_node;
-#ifndef CHAOS_COMPILER
+        if (function_call_stack.size == 0 || (loop_end_ast_node != NULL && loop_end_ast_node == ast_node))
+            goto eval_node_return;
+
+        function_call = function_call_stack.arr[function_call_stack.size - 1];
+
+        if (debug_enabled)
+            printf(
+                "(Execute[AFC])\tASTNode: {id: %llu, node_type: %s, module: %s, string_size: %zu, lineno: %d}\n",
+                function_call->trigger->id,
+                getAstNodeTypeName(function_call->trigger->node_type),
+                function_call->trigger->module,
+                function_call->trigger->strings_size,
+                function_call->trigger->lineno
+            );
+
+        if (function_call->function->decision_table != NULL) {
+            frame = pushEvalStack(EVAL_FRAME_DECISION, ast_node, module);
+            frame->function_call = function_call;
+            module = function_call->function->module_context;
+            ast_node = selectDecision(function_call->function->decision_table, module);
+            if (ast_node == NULL)
+                goto eval_node_return;
+
+            // The predicate of the selected case already holds, only its call parameters are left
+            frame = pushEvalStack(EVAL_FRAME_CHILDREN, ast_node, module);
+            if (ast_node->node_type < AST_DECISION_MAKE_DEFAULT)
+                frame->stage = 2;
+            goto eval_node_children;
         }
+
+        goto eval_node_after_function_call_label;
+#else
+        goto eval_node_return;
 #endif
     }
 
@@ -367,33 +434,30 @@ eval_node_label:
     switch (ast_node->node_type)
     {
         case AST_START_TIMES_DO:
-            return startTimesDo(ast_node->right->value.i, false, ast_node);
+            loop = startTimesDo(ast_node->right->value.i, false, ast_node);
             break;
         case AST_START_TIMES_DO_INFINITE:
-            return startTimesDo(0, true, ast_node);
+            loop = startTimesDo(0, true, ast_node);
             break;
         case AST_START_TIMES_DO_VAR:
-            return startTimesDo(getSymbolValueInt(ast_node->strings[0]), false, ast_node);
+            loop = startTimesDo(getSymbolValueInt(ast_node->strings[0]), false, ast_node);
             break;
         case AST_START_FOREACH:
-            return startForeach(ast_node->strings[0], ast_node->strings[1], ast_node);
+            loop = startForeach(ast_node->strings[0], ast_node->strings[1], ast_node);
             break;
         case AST_START_FOREACH_DICT:
-            return startForeachDict(ast_node->strings[0], ast_node->strings[1], ast_node->strings[2], ast_node);
+            loop = startForeachDict(ast_node->strings[0], ast_node->strings[1], ast_node->strings[2], ast_node);
             break;
         default:
             break;
     }
-#endif
-
 
-    Symbol* symbol;
-    FunctionCall* function_call = NULL;
-    long double l_value;
-    long double r_value;
-    long long exit_code;
-    char *_module = NULL;
-    char *out = NULL;
+    if (loop != NULL) {
+        frame = pushEvalStack(EVAL_FRAME_LOOP, ast_node, module);
+        frame->loop = loop;
+        goto eval_node_loop_next;
+    }
+#endif
 
     switch (ast_node->node_type)
     {
@@ -822,15 +886,13 @@ eval_node_label:
             printSymbolValueEndWithNewLine(getComplexElementThroughLeftRightBracketStack(ast_node->strings[0], 0), false, true);
             break;
         case AST_PRINT_EXPRESSION:
-            printf("%lld\n", ast_node->right->value.i);
+            outputInt(ast_node->right->value.i, "\n");
             break;
         case AST_PRINT_MIXED_EXPRESSION:
-            printf("%Lg\n", ast_node->right->value.f);
+            outputFloat(ast_node->right->value.f, "\n");
             break;
         case AST_PRINT_STRING:
-            out = escape_the_sequences_in_string_literal(ast_node->value.s);
-            printf("%s\n", out);
-            free(out);
+            outputEscapedString(ast_node->value.s, "\n");
             break;
         case AST_PRINT_INTERACTIVE_VAR:
 #ifndef CHAOS_COMPILER
@@ -842,13 +904,13 @@ eval_node_label:
 #ifndef CHAOS_COMPILER
             if (is_interactive)
                 if (ast_node->right->node_type < AST_VAR_EXPRESSION_INCREMENT || ast_node->right->node_type > AST_VAR_EXPRESSION_ASSIGN_INCREMENT)
-                    printf("%lld\n", ast_node->right->value.i);
+                    outputInt(ast_node->right->value.i, "\n");
 #endif
             break;
         case AST_PRINT_INTERACTIVE_MIXED_EXPRESSION:
 #ifndef CHAOS_COMPILER
             if (is_interactive)
-                printf("%Lg\n", ast_node->right->value.f);
+                outputFloat(ast_node->right->value.f, "\n");
 #endif
             break;
         case AST_ECHO_VAR:
@@ -858,15 +920,13 @@ eval_node_label:
             printSymbolValueEndWith(getComplexElementThroughLeftRightBracketStack(ast_node->strings[0], 0), "", false, true);
             break;
         case AST_ECHO_EXPRESSION:
-            printf("%lld", ast_node->right->value.i);
+            outputInt(ast_node->right->value.i, "");
             break;
         case AST_ECHO_MIXED_EXPRESSION:
-            printf("%Lg", ast_node->right->value.f);
+            outputFloat(ast_node->right->value.f, "");
             break;
         case AST_ECHO_STRING:
-            out = escape_the_sequences_in_string_literal(ast_node->value.s);
-            printf("%s", out);
-            free(out);
+            outputEscapedString(ast_node->value.s, "");
             break;
         case AST_PRETTY_PRINT_VAR:
             printSymbolValueEndWithNewLine(getSymbol(ast_node->strings[0]), true, true);
@@ -1466,6 +1526,7 @@ eval_node_label:
                 resetFunctionParametersMode();
             }
             break;
+#ifndef CHAOS_COMPILER
         case AST_DECISION_MAKE_BOOLEAN_BREAK:
             if (nested_loop_counter > 0 && ast_node->right->value.b) {
                 decisionBreakLoop();
@@ -1476,6 +1537,7 @@ eval_node_label:
                 decisionContinueLoop();
             }
             break;
+#endif
         case AST_DECISION_MAKE_BOOLEAN_RETURN:
             if (ast_node->right->value.b) {
                 returnSymbol(ast_node->strings[0]);
@@ -1506,6 +1568,7 @@ eval_node_label:
                 resetFunctionParametersMode();
             }
             break;
+#ifndef CHAOS_COMPILER
         case AST_DECISION_MAKE_DEFAULT_BREAK:
             if (nested_loop_counter > 0 && function_call_stack.arr[function_call_stack.size - 1] != NULL) {
                 decisionBreakLoop();
@@ -1516,6 +1579,7 @@ eval_node_label:
                 decisionContinueLoop();
             }
             break;
+#endif
         case AST_DECISION_MAKE_DEFAULT_RETURN:
             if (function_call_stack.arr[function_call_stack.size - 1] != NULL) {
                 returnSymbol(ast_node->strings[0]);
@@ -1523,11 +1587,6 @@ eval_node_label:
                 callFunctionCleanUpSymbols(function_call_stack.arr[function_call_stack.size - 1]);
             }
             break;
-        case AST_JSON_PARSER:
-            reverseComplexMode();
-            symbol = finishComplexMode(NULL, K_ANY);
-            returnVariable(symbol);
-            break;
         default:
             break;
     }
@@ -1536,19 +1595,120 @@ eval_node_label:
         ast_node = ast_node->next;
         goto eval_node_label;
     }
-    return ast_node;
+
+eval_node_return:
+    // Resume the continuation that is waiting for the node sequence that has just finished
+    if (eval_stack.size == eval_stack_base)
+        return ast_node;
+
+    frame = &eval_stack.arr[eval_stack.size - 1];
+    switch (frame->type)
+    {
+        case EVAL_FRAME_CHILDREN:
+            goto eval_node_children;
+#ifndef CHAOS_COMPILER
+        case EVAL_FRAME_LOOP:
+            goto eval_node_loop_next;
+        case EVAL_FRAME_DECISION:
+            function_call = frame->function_call;
+            popEvalStack();
+            stop_ast_evaluation = false;
+            goto eval_node_after_function_call_label;
+#endif
+        default:
+            popEvalStack();
+            goto eval_node_return;
+    }
+
+eval_node_children:
+    // Evaluate the depend, right and left children in order, then execute the node itself
+    frame = &eval_stack.arr[eval_stack.size - 1];
+    while (frame->stage < 3) {
+        switch (frame->stage++)
+        {
+            case 0:
+                child = frame->ast_node->depend;
+                break;
+            case 1:
+                child = frame->ast_node->right;
+                break;
+            default:
+                child = frame->ast_node->left;
+                break;
+        }
+        if (child != NULL) {
+            ast_node = child;
+            module = frame->module;
+            goto eval_node_label;
+        }
+    }
+    ast_node = frame->ast_node;
+    module = frame->module;
+    popEvalStack();
+    goto eval_node_execute;
+
+#ifndef CHAOS_COMPILER
+eval_node_loop_next:
+    frame = &eval_stack.arr[eval_stack.size - 1];
+    if (nextLoopIteration(frame->loop)) {
+        ast_node = frame->loop->ast_node->next;
+        module = frame->loop->ast_node->module;
+        goto eval_node_label;
+    }
+
+eval_node_loop_end:
+    frame = &eval_stack.arr[eval_stack.size - 1];
+    module = frame->loop->ast_node->module;
+    ast_node = endLoop(frame->loop)->next;
+    frame->loop = NULL;
+    popEvalStack();
+    goto eval_node_label;
+
+eval_node_after_function_call_label:
+    ast_node = eval_node_after_function_call(function_call);
+    if (loop_jump != LOOP_JUMP_NONE)
+        goto eval_node_loop_jump;
+    module = ast_node->module;
+    ast_node = ast_node->next;
+    goto eval_node_label;
+
+eval_node_loop_jump:
+    // A decision asked for break or continue, unwind to the innermost loop
+    while (eval_stack.size > eval_stack_base && eval_stack.arr[eval_stack.size - 1].type != EVAL_FRAME_LOOP)
+        popEvalStack();
+
+    if (eval_stack.size == eval_stack_base) {
+        loop_jump = LOOP_JUMP_NONE;
+        return NULL;
+    }
+
+    if (loop_jump == LOOP_JUMP_BREAK) {
+        loop_jump = LOOP_JUMP_NONE;
+        goto eval_node_loop_end;
+    }
+    loop_jump = LOOP_JUMP_NONE;
+    goto eval_node_loop_next;
+#endif
 }
 
 ASTNode* walk_until_end(ASTNode* ast_node, char *module) {
+    unsigned long long depth = 0;
 walk_until_end_label:
     if (ast_node == NULL) {
         return ast_node;
     }
 
-    if (strcmp(ast_node->module, module) != 0) return walk_until_end(ast_node->next, module);
+    if (strcmp(ast_node->module, module) != 0) {
+        ast_node = ast_node->next;
+        goto walk_until_end_label;
+    }
 
     if (ast_node->node_type == AST_END) {
-        return ast_node;
+        if (depth == 0)
+            return ast_node;
+        depth--;
+    } else if (ast_node->node_type >= AST_START_TIMES_DO && ast_node->node_type <= AST_START_FOREACH_DICT) {
+        depth++;
     }
 
     if (phase != PREPARSE) {
@@ -1559,25 +1719,14 @@ walk_until_end_label:
 }
 
 #ifndef CHAOS_COMPILER
-ASTNode* eval_node_after_function_call(ASTNode* end_node) {
-    if (function_call_stack.size == 0 || (loop_end_ast_node != NULL && loop_end_ast_node == end_node))
-        return NULL;
-
-    FunctionCall* function_call = function_call_stack.arr[function_call_stack.size - 1];
+ASTNode* eval_node_after_function_call(FunctionCall* function_call) {
     ASTNode* ast_node = function_call->trigger;
 
-    if (debug_enabled)
-        printf(
-            "(Execute[AFC])\tASTNode: {id: %llu, node_type: %s, module: %s, string_size: %zu, lineno: %d}\n",
-            ast_node->id,
-            getAstNodeTypeName(ast_node->node_type),
-            ast_node->module,
-            ast_node->strings_size,
-            ast_node->lineno
-        );
-
     callFunctionCleanUp(function_call);
 
+    if (loop_jump != LOOP_JUMP_NONE)
+        return NULL;
+
     char *_module = NULL;
     switch (ast_node->node_type)
     {
@@ -1649,11 +1798,11 @@ ASTNode* eval_node_after_function_call(ASTNode* end_node) {
 #endif
             break;
         case AST_DECISION_MAKE_BOOLEAN:
-            freeFunctionReturn(function_call);
+            chainFunctionReturn(function_call);
             stop_ast_evaluation = true;
             break;
         case AST_DECISION_MAKE_DEFAULT:
-            freeFunctionReturn(function_call);
+            chainFunctionReturn(function_call);
             stop_ast_evaluation = true;
             break;
         default:
@@ -1666,3 +1815,41 @@ ASTNode* eval_node_after_function_call(ASTNode* end_node) {
     return ast_node;
 }
 #endif
+
+EvalFrame* pushEvalStack(enum EvalFrameType type, ASTNode* ast_node, char *module) {
+    if (eval_stack.capacity == 0) {
+        eval_stack.arr = (EvalFrame*)malloc((eval_stack.capacity = 64) * sizeof(EvalFrame));
+    } else if (eval_stack.capacity == eval_stack.size) {
+        eval_stack.arr = (EvalFrame*)realloc(eval_stack.arr, (eval_stack.capacity *= 2) * sizeof(EvalFrame));
+    }
+
+    EvalFrame* frame = &eval_stack.arr[eval_stack.size++];
+    frame->type = type;
+    frame->stage = 0;
+    frame->ast_node = ast_node;
+    frame->module = module;
+    frame->loop = NULL;
+    frame->function_call = NULL;
+    return frame;
+}
+
+void popEvalStack() {
+    eval_stack.size--;
+}
+
+void freeEvalStack() {
+#ifndef CHAOS_COMPILER
+    for (unsigned i = 0; i < eval_stack.size; i++) {
+        if (eval_stack.arr[i].type == EVAL_FRAME_LOOP)
+            free(eval_stack.arr[i].loop);
+    }
+    nested_loop_counter = 0;
+    loop_end_ast_node = NULL;
+    loop_jump = LOOP_JUMP_NONE;
+#endif
+
+    free(eval_stack.arr);
+    eval_stack.arr = NULL;
+    eval_stack.capacity = 0;
+    eval_stack.size = 0;
+}
@@ -36,24 +36,45 @@
 extern unsigned long long nested_loop_counter;
 extern ASTNode* loop_end_ast_node;
 
+enum LoopJump { LOOP_JUMP_NONE, LOOP_JUMP_BREAK, LOOP_JUMP_CONTINUE };
+extern enum LoopJump loop_jump;
+
+enum EvalFrameType { EVAL_FRAME_CHILDREN, EVAL_FRAME_LOOP, EVAL_FRAME_DECISION };
+
+typedef struct EvalFrame {
+    enum EvalFrameType type;
+    unsigned short stage;
+    struct ASTNode* ast_node;
+    char *module;
+    struct Loop* loop;
+    struct FunctionCall* function_call;
+} EvalFrame;
+
+typedef struct eval_frame_array {
+    EvalFrame* arr;
+    unsigned capacity, size;
+} eval_frame_array;
+
+eval_frame_array eval_stack;
+
 #ifndef CHAOS_COMPILER
 void interpret(char *module, enum Phase phase_arg, bool is_interactive, bool unsafe);
 #else
 void interpret(char *module, enum Phase phase_arg);
 #endif
 
-ASTNode* startTimesDo(long long iter, bool is_infinite, ASTNode* ast_node);
-ASTNode* startForeach(char *list_name, char *element_name, ASTNode* ast_node);
-ASTNode* startForeachDict(char *list_name, char *element_key, char *element_value, ASTNode* ast_node);
 bool is_node_function_related(ASTNode* ast_node);
 ASTNode* register_functions(ASTNode* ast_node, char *module);
 ASTNode* eval_node(ASTNode* ast_node, char *module) __attribute__ ((hot));
 ASTNode* walk_until_end(ASTNode* ast_node, char *module);
 void breakLoop();
 void continueLoop();
+EvalFrame* pushEvalStack(enum EvalFrameType type, ASTNode* ast_node, char *module);
+void popEvalStack();
+void freeEvalStack();
 
 #ifndef CHAOS_COMPILER
-ASTNode* eval_node_after_function_call(ASTNode* end_node);
+ASTNode* eval_node_after_function_call(FunctionCall* function_call);
 #endif
 
 #endif
@@ -0,0 +1,236 @@
+/*
+ * Description: JSON parser of the Chaos Programming Language's source
+ *
+ * Copyright (c) 2019-2020 Chaos Language Development Authority <info@chaos-lang.org>
+ *
+ * License: GNU General Public License v3.0
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors: M. Mert Yildiran <me@mertyildiran.com>
+ */
+
+
+#include "json.h"
+
+static void throwJsonError(JsonParser* parser) {
+    throw_error(E_INVALID_JSON, NULL, NULL, 0, (unsigned long long) (parser->cursor - parser->json));
+}
+
+static void skipJsonWhitespace(JsonParser* parser) {
+    while (*parser->cursor == ' ' || *parser->cursor == '\t' || *parser->cursor == '\n' || *parser->cursor == '\r')
+        parser->cursor++;
+}
+
+static void pushJsonChild(Symbol* symbol) {
+    if (json_children.capacity == json_children.size) {
+        json_children.capacity = json_children.capacity == 0 ? 64 : json_children.capacity * 2;
+        json_children.arr = realloc(json_children.arr, json_children.capacity * sizeof(Symbol*));
+        if (json_children.arr == NULL)
+            throw_error(E_MEMORY_ALLOCATION_FOR_LIST_FAILED, NULL);
+    }
+    json_children.arr[json_children.size++] = symbol;
+}
+
+// Strings are kept as they are written, escape sequences are not decoded just like the lexer does
+static char* parseJsonString(JsonParser* parser) {
+    char *delimiters = *parser->cursor == '"' ? "\"\\" : "'\\";
+    char *start = ++parser->cursor;
+
+    for (;;) {
+        parser->cursor += strcspn(parser->cursor, delimiters);
+        if (*parser->cursor == '\0')
+            throwJsonError(parser);
+        if (*parser->cursor != '\\')
+            break;
+        if (*(parser->cursor + 1) == '\0')
+            throwJsonError(parser);
+        parser->cursor += 2;
+    }
+
+    size_t length = parser->cursor - start;
+    char *s = malloc(length + 1);
+    memcpy(s, start, length);
+    s[length] = '\0';
+    parser->cursor++;
+    return s;
+}
+
+static Symbol* parseJsonNumber(JsonParser* parser) {
+    char *start = parser->cursor;
+    bool is_float = false;
+
+    if (*parser->cursor == '-')
+        parser->cursor++;
+    if (*parser->cursor < '0' || *parser->cursor > '9')
+        throwJsonError(parser);
+    while (*parser->cursor >= '0' && *parser->cursor <= '9')
+        parser->cursor++;
+    if (*parser->cursor == '.' && *(parser->cursor + 1) >= '0' && *(parser->cursor + 1) <= '9') {
+        is_float = true;
+        parser->cursor++;
+        while (*parser->cursor >= '0' && *parser->cursor <= '9')
+            parser->cursor++;
+    }
+    if (*parser->cursor == 'e' || *parser->cursor == 'E')
+        is_float = true;
+
+    union Value value;
+    if (is_float) {
+        value.f = strtold(start, &parser->cursor);
+        return addSymbolToScope(scopeless, K_NUMBER, value, V_FLOAT);
+    }
+    value.i = strtoll(start, NULL, 10);
+    return addSymbolToScope(scopeless, K_NUMBER, value, V_INT);
+}
+
+// Every open dict or list is a frame on a heap stack, so deeply nested input cannot exhaust the C stack
+static void pushJsonFrame(JsonParser* parser, char *key) {
+    if (json_frames.capacity == json_frames.size) {
+        json_frames.capacity = json_frames.capacity == 0 ? 16 : json_frames.capacity * 2;
+        json_frames.arr = realloc(json_frames.arr, json_frames.capacity * sizeof(JsonFrame));
+        if (json_frames.arr == NULL)
+            throw_error(E_MEMORY_ALLOCATION_FOR_LIST_FAILED, NULL);
+    }
+
+    union Value value;
+    value.i = 0;
+    Symbol* complex = addSymbolToScope(scopeless, *parser->cursor == '{' ? K_DICT : K_LIST, value, V_VOID);
+    complex->secondary_type = K_ANY;
+
+    // Children are collected on a shared stack so that each complex allocates its array only once
+    JsonFrame* frame = &json_frames.arr[json_frames.size++];
+    frame->complex = complex;
+    frame->key = key;
+    frame->base = json_children.size;
+    parser->cursor++;
+}
+
+static Symbol* popJsonFrame(char **key) {
+    JsonFrame* frame = &json_frames.arr[--json_frames.size];
+    Symbol* complex = frame->complex;
+
+    unsigned long count = json_children.size - frame->base;
+    if (count > 0) {
+        complex->children = malloc(count * sizeof(Symbol*));
+        if (complex->children == NULL)
+            throw_error(E_MEMORY_ALLOCATION_FOR_LIST_FAILED, NULL);
+        memcpy(complex->children, &json_children.arr[frame->base], count * sizeof(Symbol*));
+        complex->children_count = count;
+    }
+    json_children.size = frame->base;
+    *key = frame->key;
+    return complex;
+}
+
+static Symbol* parseJsonScalar(JsonParser* parser) {
+    union Value value;
+
+    switch (*parser->cursor)
+    {
+        case '"':
+        case '\'':
+            value.s = parseJsonString(parser);
+            return addSymbolToScope(scopeless, K_STRING, value, V_STRING);
+        case 't':
+            if (strncmp(parser->cursor, "true", 4) != 0)
+                throwJsonError(parser);
+            parser->cursor += 4;
+            value.b = true;
+            return addSymbolToScope(scopeless, K_BOOL, value, V_BOOL);
+        case 'f':
+            if (strncmp(parser->cursor, "false", 5) != 0)
+                throwJsonError(parser);
+            parser->cursor += 5;
+            value.b = false;
+            return addSymbolToScope(scopeless, K_BOOL, value, V_BOOL);
+        default:
+            return parseJsonNumber(parser);
+    }
+}
+
+static char getJsonFrameEnd() {
+    return json_frames.arr[json_frames.size - 1].complex->type == K_DICT ? '}' : ']';
+}
+
+Symbol* parseJsonToSymbol(char *json) {
+    JsonParser parser;
+    parser.json = json;
+    parser.cursor = json;
+    json_children.size = 0;
+    json_frames.size = 0;
+
+    skipJsonWhitespace(&parser);
+    if (*parser.cursor != '{' && *parser.cursor != '[')
+        throwJsonError(&parser);
+    pushJsonFrame(&parser, NULL);
+
+    Symbol* symbol = NULL;
+    char *key = NULL;
+    while (json_frames.size > 0) {
+        skipJsonWhitespace(&parser);
+        if (*parser.cursor == getJsonFrameEnd()) {
+            parser.cursor++;
+            symbol = popJsonFrame(&key);
+            if (json_frames.size == 0)
+                break;
+        } else {
+            key = NULL;
+            if (json_frames.arr[json_frames.size - 1].complex->type == K_DICT) {
+                if (*parser.cursor != '"' && *parser.cursor != '\'')
+                    throwJsonError(&parser);
+                key = parseJsonString(&parser);
+                skipJsonWhitespace(&parser);
+                if (*parser.cursor != ':') {
+                    free(key);
+                    throwJsonError(&parser);
+                }
+                parser.cursor++;
+                skipJsonWhitespace(&parser);
+            }
+
+            if (*parser.cursor == '{' || *parser.cursor == '[') {
+                pushJsonFrame(&parser, key);
+                continue;
+            }
+            symbol = parseJsonScalar(&parser);
+        }
+
+        symbol->key = key;
+        pushJsonChild(symbol);
+
+        skipJsonWhitespace(&parser);
+        if (*parser.cursor == ',') {
+            parser.cursor++;
+        } else if (*parser.cursor != getJsonFrameEnd()) {
+            throwJsonError(&parser);
+        }
+    }
+
+    skipJsonWhitespace(&parser);
+    if (*parser.cursor != '\0')
+        throwJsonError(&parser);
+
+    return symbol;
+}
+
+void freeJsonParser() {
+    free(json_children.arr);
+    json_children.arr = NULL;
+    json_children.capacity = 0;
+    json_children.size = 0;
+    free(json_frames.arr);
+    json_frames.arr = NULL;
+    json_frames.capacity = 0;
+    json_frames.size = 0;
+}
@@ -0,0 +1,63 @@
+/*
+ * Description: JSON parser of the Chaos Programming Language's source
+ *
+ * Copyright (c) 2019-2020 Chaos Language Development Authority <info@chaos-lang.org>
+ *
+ * License: GNU General Public License v3.0
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors: M. Mert Yildiran <me@mertyildiran.com>
+ */
+
+
+#ifndef KAOS_JSON_H
+#define KAOS_JSON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "function.h"
+#include "symbol.h"
+#include "errors.h"
+
+typedef struct json_symbol_stack {
+    Symbol** arr;
+    unsigned long capacity, size;
+} json_symbol_stack;
+
+json_symbol_stack json_children;
+
+typedef struct JsonFrame {
+    Symbol* complex;
+    char *key;
+    unsigned long base;
+} JsonFrame;
+
+typedef struct json_frame_stack {
+    JsonFrame* arr;
+    unsigned long capacity, size;
+} json_frame_stack;
+
+json_frame_stack json_frames;
+
+typedef struct JsonParser {
+    char *json;
+    char *cursor;
+} JsonParser;
+
+Symbol* parseJsonToSymbol(char *json);
+void freeJsonParser();
+
+#endif
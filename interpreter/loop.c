@@ -21,6 +21,7 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "loop.h"
@@ -28,130 +29,111 @@
 #include "../interpreter/interpreter.h"
 
 unsigned long long nested_loop_counter = 0;
-bool interactive_shell_loop_error_absorbed = false;
-bool is_loop_breaked = false;
 ASTNode* loop_end_ast_node = NULL;
-extern int yyparse();
+enum LoopJump loop_jump = LOOP_JUMP_NONE;
+
+Loop* startLoop(enum LoopType type, ASTNode* ast_node) {
+    Loop* loop = (struct Loop*)calloc(1, sizeof(Loop));
+    loop->type = type;
+    loop->ast_node = ast_node;
+    loop->end_node = walk_until_end(ast_node->next, ast_node->module);
+    loop->previous_end_node = loop_end_ast_node;
+    loop_end_ast_node = loop->end_node;
+    nested_loop_counter++;
+    return loop;
+}
 
-ASTNode* startTimesDo(long long iter, bool is_infinite, ASTNode* ast_node) {
+Loop* startTimesDo(long long iter, bool is_infinite, ASTNode* ast_node) {
     if (iter < 0) {
         throw_error(E_NEGATIVE_ITERATION_COUNT, NULL, NULL, iter);
     }
-    ASTNode* next_node = walk_until_end(ast_node->next, ast_node->module);
-    loop_end_ast_node = next_node;
-
-#ifndef CHAOS_COMPILER
-    if (is_interactive)
-        if (setjmp(InteractiveShellLoopErrorAbsorber))
-            interactive_shell_loop_error_absorbed = true;
-#endif
-
-    nested_loop_counter++;
-    if (!interactive_shell_loop_error_absorbed && !is_loop_breaked) {
-        if (is_infinite) {
-            while (true) {
-                if (setjmp(LoopBreak))
-                    break;
-                if (setjmp(LoopContinue))
-                    continue;
-                next_node = eval_node(ast_node->next, ast_node->module);
-            }
-        } else {
-            for (unsigned long long i = 0; i < (unsigned) iter; i++) {
-                if (setjmp(LoopBreak))
-                    break;
-                if (setjmp(LoopContinue))
-                    continue;
-                next_node = eval_node(ast_node->next, ast_node->module);
-            }
-        }
-    }
-    nested_loop_counter--;
 
-    return eval_node(next_node->next, ast_node->module);
+    Loop* loop = startLoop(TIMESDO, ast_node);
+    loop->iter = (unsigned long long) iter;
+    loop->is_infinite = is_infinite;
+    return loop;
 }
 
-ASTNode* startForeach(char *list_name, char *element_name, ASTNode* ast_node) {
-    ASTNode* next_node = walk_until_end(ast_node->next, ast_node->module);
-    loop_end_ast_node = next_node;
-
+Loop* startForeach(char *list_name, char *element_name, ASTNode* ast_node) {
     Symbol* list = getSymbol(list_name);
     if (list->type != K_LIST)
         throw_error(E_NOT_A_LIST, list_name);
 
-#ifndef CHAOS_COMPILER
-    if (is_interactive)
-        if (setjmp(InteractiveShellLoopErrorAbsorber))
-            interactive_shell_loop_error_absorbed = true;
-#endif
-
-    nested_loop_counter++;
-    if (!interactive_shell_loop_error_absorbed && !is_loop_breaked) {
-        for (unsigned long i = 0; i < list->children_count; i++) {
-            Symbol* child = list->children[i];
-            Symbol* clone_symbol = createCloneFromSymbol(element_name, child->type, child, child->secondary_type);
-            if (setjmp(LoopBreak)) {
-                removeSymbol(clone_symbol);
-                break;
-            }
-            if (setjmp(LoopContinue)) {
-                removeSymbol(clone_symbol);
-                continue;
-            }
-            next_node = eval_node(ast_node->next, ast_node->module);
-            removeSymbol(clone_symbol);
-        }
-    }
-    nested_loop_counter--;
-
-    return eval_node(next_node->next, ast_node->module);
+    Loop* loop = startLoop(FOREACH, ast_node);
+    loop->list = list_name;
+    loop->complex = list;
+    loop->element.name = element_name;
+    return loop;
 }
 
-ASTNode* startForeachDict(char *dict_name, char *element_key, char *element_value, ASTNode* ast_node) {
-    ASTNode* next_node = walk_until_end(ast_node->next, ast_node->module);
-    loop_end_ast_node = next_node;
-
+Loop* startForeachDict(char *dict_name, char *element_key, char *element_value, ASTNode* ast_node) {
     Symbol* dict = getSymbol(dict_name);
     if (dict->type != K_DICT)
         throw_error(E_NOT_A_DICT, dict_name);
 
-#ifndef CHAOS_COMPILER
-    if (is_interactive)
-        if (setjmp(InteractiveShellLoopErrorAbsorber))
-            interactive_shell_loop_error_absorbed = true;
-#endif
+    Loop* loop = startLoop(FOREACH_DICT, ast_node);
+    loop->list = dict_name;
+    loop->complex = dict;
+    loop->element.key = element_key;
+    loop->element.value = element_value;
+    return loop;
+}
 
-    nested_loop_counter++;
-    if (!interactive_shell_loop_error_absorbed && !is_loop_breaked) {
-        for (unsigned long i = 0; i < dict->children_count; i++) {
-            Symbol* child = dict->children[i];
-
-            addSymbolString(element_key, child->key);
-            Symbol* clone_symbol = createCloneFromSymbol(element_value, child->type, child, child->secondary_type);
-            if (setjmp(LoopBreak)) {
-                removeSymbol(clone_symbol);
-                removeSymbolByName(element_key);
-                break;
-            }
-            if (setjmp(LoopContinue)) {
-                removeSymbol(clone_symbol);
-                removeSymbolByName(element_key);
-                continue;
-            }
-            next_node = eval_node(ast_node->next, ast_node->module);
-            removeSymbol(clone_symbol);
-            removeSymbolByName(element_key);
-        }
+bool nextLoopIteration(Loop* loop) {
+    endLoopIteration(loop);
+
+    Symbol* child;
+    switch (loop->type)
+    {
+        case TIMESDO:
+            if (!loop->is_infinite && loop->i >= loop->iter)
+                return false;
+            break;
+        case FOREACH:
+            if (loop->i >= loop->complex->children_count)
+                return false;
+            child = loop->complex->children[loop->i];
+            loop->element_symbol = createCloneFromSymbol(loop->element.name, child->type, child, child->secondary_type);
+            break;
+        case FOREACH_DICT:
+            if (loop->i >= loop->complex->children_count)
+                return false;
+            child = loop->complex->children[loop->i];
+            addSymbolString(loop->element.key, child->key);
+            loop->element_symbol = createCloneFromSymbol(loop->element.value, child->type, child, child->secondary_type);
+            break;
+        default:
+            return false;
     }
-    nested_loop_counter--;
 
-    return eval_node(next_node->next, ast_node->module);
+    loop->i++;
+    return true;
+}
+
+void endLoopIteration(Loop* loop) {
+    if (loop->element_symbol == NULL)
+        return;
+
+    removeSymbol(loop->element_symbol);
+    loop->element_symbol = NULL;
+    if (loop->type == FOREACH_DICT)
+        removeSymbolByName(loop->element.key);
+}
+
+ASTNode* endLoop(Loop* loop) {
+    endLoopIteration(loop);
+
+    ASTNode* end_node = loop->end_node;
+    loop_end_ast_node = loop->previous_end_node;
+    nested_loop_counter--;
+    free(loop);
+    return end_node;
 }
 
 void breakLoop() {
-    longjmp(LoopBreak, 1);
+    loop_jump = LOOP_JUMP_BREAK;
 }
 
 void continueLoop() {
-    longjmp(LoopContinue, 1);
+    loop_jump = LOOP_JUMP_CONTINUE;
 }
@@ -39,14 +39,19 @@ typedef struct {
     char *value;
 } LoopElement;
 
-typedef struct {
+typedef struct Loop {
     enum LoopType type;
     unsigned long long iter;
+    unsigned long long i;
     bool is_infinite;
     unsigned nested_counter;
     char *list;
     LoopElement element;
+    Symbol* complex;
+    Symbol* element_symbol;
     struct ASTNode* ast_node;
+    struct ASTNode* end_node;
+    struct ASTNode* previous_end_node;
 } Loop;
 
 Loop* loop_mode;
@@ -54,14 +59,15 @@ bool loop_execution_mode;
 
 jmp_buf InteractiveShellLoopErrorAbsorber;
 
-jmp_buf LoopBreak;
-jmp_buf LoopContinue;
-
 ASTNode* loop_end_ast_node;
 
-ASTNode* startTimesDo(long long iter, bool is_infinite, ASTNode* ast_node);
-ASTNode* startForeach(char *list_name, char *element_name, ASTNode* ast_node);
-ASTNode* startForeachDict(char *dict_name, char *element_key, char *element_value, ASTNode* ast_node);
+Loop* startLoop(enum LoopType type, ASTNode* ast_node);
+Loop* startTimesDo(long long iter, bool is_infinite, ASTNode* ast_node);
+Loop* startForeach(char *list_name, char *element_name, ASTNode* ast_node);
+Loop* startForeachDict(char *dict_name, char *element_key, char *element_value, ASTNode* ast_node);
+bool nextLoopIteration(Loop* loop);
+void endLoopIteration(Loop* loop);
+ASTNode* endLoop(Loop* loop);
 void breakLoop();
 void continueLoop();
 
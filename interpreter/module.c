@@ -60,11 +60,36 @@ void moduleImportParse(char *module_path) {
         callRegisterInDynamicLibrary(module_path);
     } else {
 #ifndef CHAOS_COMPILER
-        parseTheModuleContent(module_path);
+        if (is_in_array(&parsed_modules, module_path)) {
+            registerParsedModule(module_path);
+        } else {
+            parseTheModuleContent(module_path);
+            append_to_array(&parsed_modules, module_path);
+        }
 #endif
     }
 }
 
+#ifndef CHAOS_COMPILER
+// The AST of a module that is already parsed stays in the tree, keyed by its path.
+// Registering its functions again for the new alias and context is all that
+// a repeated import needs, the preemptive check has already covered the module.
+void registerParsedModule(char *module_path) {
+    phase = PREPARSE;
+    register_functions(ast_root_node, module_path);
+    phase = PROGRAM;
+}
+
+void freeParsedModules() {
+    for (unsigned i = 0; i < parsed_modules.size; i++) {
+        free(parsed_modules.arr[i]);
+    }
+    if (parsed_modules.size > 0) free(parsed_modules.arr);
+    parsed_modules.capacity = 0;
+    parsed_modules.size = 0;
+}
+#endif
+
 char* resolveModulePath(char *module_name, bool directly_import) {
 #ifndef CHAOS_COMPILER
     if (is_interactive)
@@ -36,9 +36,14 @@ string_array modules_buffer;
 extern char *program_file_path;
 extern char *program_file_dir;
 extern char *program_code;
+extern source_file program_source;
 string_array module_path_stack;
 string_array module_stack;
 
+#ifndef CHAOS_COMPILER
+string_array parsed_modules;
+#endif
+
 extern unsigned short module_parsing;
 
 void initMainContext();
@@ -46,6 +51,10 @@ void appendModuleToModuleBuffer(char *name);
 void prependModuleToModuleBuffer(char *name);
 void handleModuleImport(char *module_name, bool directly_import);
 void moduleImportParse(char *module_path);
+#ifndef CHAOS_COMPILER
+void registerParsedModule(char *module_path);
+void freeParsedModules();
+#endif
 char* resolveModulePath(char *module_name, bool directly_import);
 void moduleImportCleanUp(char *module_path);
 void freeModulesBuffer();
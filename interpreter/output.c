@@ -0,0 +1,81 @@
+/*
+ * Description: Output module of the Chaos Programming Language's source
+ *
+ * Copyright (c) 2019-2020 Chaos Language Development Authority <info@chaos-lang.org>
+ *
+ * License: GNU General Public License v3.0
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors: M. Mert Yildiran <me@mertyildiran.com>
+ */
+
+#include "output.h"
+#include "../utilities/helpers.h"
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static char output_buffer[__KAOS_OUTPUT_BUFFER_SIZE__];
+
+// The standard output is written through one large buffer. A terminal still
+// gets every line as soon as it is complete, anything else (a file or a pipe)
+// only when the buffer is full, at an error, or at exit.
+void initOutput(bool unbuffered) {
+    if (unbuffered) {
+        setvbuf(stdout, NULL, _IONBF, 0);
+        return;
+    }
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+    // _IOLBF means full buffering on Windows, so the console is left as it is
+    if (_isatty(_fileno(stdout)))
+        return;
+    setvbuf(stdout, output_buffer, _IOFBF, sizeof(output_buffer));
+#else
+    setvbuf(stdout, output_buffer, isatty(fileno(stdout)) ? _IOLBF : _IOFBF, sizeof(output_buffer));
+#endif
+}
+
+void flushOutput() {
+    fflush(stdout);
+}
+
+void outputBool(bool b, char *end) {
+    fputs(b ? "true" : "false", stdout);
+    fputs(end, stdout);
+}
+
+void outputInt(long long i, char *end) {
+    string_builder sb;
+    string_builder_init_stream(&sb, stdout);
+    string_builder_append_int(&sb, i);
+    string_builder_append(&sb, end);
+}
+
+void outputFloat(long double f, char *end) {
+    string_builder sb;
+    string_builder_init_stream(&sb, stdout);
+    string_builder_append_float(&sb, f);
+    string_builder_append(&sb, end);
+}
+
+void outputEscapedString(char *s, char *end) {
+    string_builder sb;
+    string_builder_init_stream(&sb, stdout);
+    string_builder_append_escaped(&sb, s);
+    string_builder_append(&sb, end);
+}
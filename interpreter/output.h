@@ -0,0 +1,38 @@
+/*
+ * Description: Output module of the Chaos Programming Language's source
+ *
+ * Copyright (c) 2019-2020 Chaos Language Development Authority <info@chaos-lang.org>
+ *
+ * License: GNU General Public License v3.0
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors: M. Mert Yildiran <me@mertyildiran.com>
+ */
+
+#ifndef KAOS_OUTPUT_H
+#define KAOS_OUTPUT_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#define __KAOS_OUTPUT_BUFFER_SIZE__ 65536
+
+void initOutput(bool unbuffered);
+void flushOutput();
+void outputBool(bool b, char *end);
+void outputInt(long long i, char *end);
+void outputFloat(long double f, char *end);
+void outputEscapedString(char *s, char *end);
+
+#endif
@@ -0,0 +1,549 @@
+/*
+ * Description: Profiler module of the Chaos Programming Language's source
+ *
+ * Copyright (c) 2019-2020 Chaos Language Development Authority <info@chaos-lang.org>
+ *
+ * License: GNU General Public License v3.0
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors: M. Mert Yildiran <me@mertyildiran.com>
+ */
+
+#include "profiler.h"
+#include "function.h"
+#include "../ast/ast.h"
+
+#include <signal.h>
+
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+#include <windows.h>
+#else
+#include <time.h>
+#include <sys/time.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+unsigned long long profileClock() {
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (unsigned long long)((long double) counter.QuadPart * 1000000000.0 / frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long) ts.tv_sec * 1000000000ULL + (unsigned long long) ts.tv_nsec;
+#endif
+}
+
+#ifndef CHAOS_COMPILER
+
+ProfileFunction* profile_functions = NULL;
+unsigned profile_functions_size = 0;
+unsigned profile_functions_capacity = 0;
+
+ProfileFrame* profile_frames = NULL;
+unsigned profile_frames_size = 0;
+unsigned profile_frames_capacity = 0;
+
+profile_counter_table profile_line_samples;
+profile_counter_table profile_folded_stacks;
+
+unsigned long long profile_start_time = 0;
+
+// Set by the timer signal, consumed by the next evaluated AST node.
+// Without a profiling timer (Windows) every evaluated node is counted as a sample.
+#if defined(_WIN32) || defined(_WIN64) || defined(__CYGWIN__)
+volatile sig_atomic_t profile_sample_pending = 1;
+#else
+volatile sig_atomic_t profile_sample_pending = 0;
+#endif
+
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
+static void profileSignalHandler(int signum) {
+    (void) signum;
+    profile_sample_pending = 1;
+}
+
+static void setProfileTimer(long interval) {
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = interval;
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_PROF, &timer, NULL);
+}
+#endif
+
+void startProfiler() {
+    profile_enabled = true;
+    profile_start_time = profileClock();
+
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = profileSignalHandler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, NULL);
+    setProfileTimer(__KAOS_PROFILE_SAMPLE_INTERVAL_USEC__);
+#endif
+}
+
+static char* getProfileFunctionName(_Function* function) {
+    char *name;
+    if (function->module != NULL && strcmp(function->module, "") != 0) {
+        name = malloc(strlen(function->module) + strlen(function->name) + 2);
+        sprintf(name, "%s.%s", function->module, function->name);
+    } else {
+        name = malloc(strlen(function->name) + 1);
+        strcpy(name, function->name);
+    }
+    return name;
+}
+
+void profileFunctionEnter(_Function* function) {
+    if (function->profile_id == 0) {
+        if (profile_functions_capacity == profile_functions_size) {
+            profile_functions_capacity = profile_functions_capacity == 0 ? 16 : profile_functions_capacity * 2;
+            profile_functions = realloc(profile_functions, profile_functions_capacity * sizeof(ProfileFunction));
+        }
+        ProfileFunction* entry = &profile_functions[profile_functions_size++];
+        entry->name = getProfileFunctionName(function);
+        entry->calls = 0;
+        entry->inclusive = 0;
+        entry->exclusive = 0;
+        entry->active = 0;
+        function->profile_id = profile_functions_size;
+    }
+
+    if (profile_frames_capacity == profile_frames_size) {
+        profile_frames_capacity = profile_frames_capacity == 0 ? 16 : profile_frames_capacity * 2;
+        profile_frames = realloc(profile_frames, profile_frames_capacity * sizeof(ProfileFrame));
+    }
+
+    ProfileFrame* frame = &profile_frames[profile_frames_size++];
+    frame->id = function->profile_id - 1;
+    frame->children = 0;
+
+    profile_functions[frame->id].calls++;
+    profile_functions[frame->id].active++;
+
+    frame->start = profileClock();
+}
+
+void profileFunctionExit() {
+    if (profile_frames_size == 0)
+        return;
+
+    ProfileFrame* frame = &profile_frames[--profile_frames_size];
+    ProfileFunction* entry = &profile_functions[frame->id];
+    unsigned long long elapsed = profileClock() - frame->start;
+
+    entry->exclusive += elapsed - frame->children;
+    // Count the time of a recursive function only once, at its outermost call
+    if (--entry->active == 0)
+        entry->inclusive += elapsed;
+
+    if (profile_frames_size > 0)
+        profile_frames[profile_frames_size - 1].children += elapsed;
+}
+
+static unsigned long long hashProfileKey(char *key) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (unsigned char *c = (unsigned char *) key; *c; c++) {
+        hash ^= *c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void incrementProfileCounter(profile_counter_table* table, char *key) {
+    if (table->size * 2 >= table->capacity) {
+        unsigned long long old_capacity = table->capacity;
+        ProfileCounter* old_arr = table->arr;
+        table->capacity = old_capacity == 0 ? 64 : old_capacity * 2;
+        table->arr = calloc(table->capacity, sizeof(ProfileCounter));
+        for (unsigned long long i = 0; i < old_capacity; i++) {
+            if (old_arr[i].key == NULL)
+                continue;
+            unsigned long long j = hashProfileKey(old_arr[i].key) & (table->capacity - 1);
+            while (table->arr[j].key != NULL)
+                j = (j + 1) & (table->capacity - 1);
+            table->arr[j] = old_arr[i];
+        }
+        free(old_arr);
+    }
+
+    unsigned long long i = hashProfileKey(key) & (table->capacity - 1);
+    while (table->arr[i].key != NULL) {
+        if (strcmp(table->arr[i].key, key) == 0) {
+            table->arr[i].count++;
+            return;
+        }
+        i = (i + 1) & (table->capacity - 1);
+    }
+
+    table->arr[i].key = malloc(strlen(key) + 1);
+    strcpy(table->arr[i].key, key);
+    table->arr[i].count = 1;
+    table->size++;
+}
+
+void profileLine(ASTNode* ast_node) {
+    if (!profile_sample_pending)
+        return;
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
+    profile_sample_pending = 0;
+#endif
+
+    char *line = malloc(strlen(ast_node->module) + 24);
+    sprintf(line, "%s:%d", ast_node->module, ast_node->lineno);
+    incrementProfileCounter(&profile_line_samples, line);
+    free(line);
+
+    size_t length = strlen("main") + 1;
+    for (unsigned i = 0; i < profile_frames_size; i++)
+        length += strlen(profile_functions[profile_frames[i].id].name) + 1;
+
+    char *stack = malloc(length);
+    strcpy(stack, "main");
+    for (unsigned i = 0; i < profile_frames_size; i++) {
+        strcat(stack, ";");
+        strcat(stack, profile_functions[profile_frames[i].id].name);
+    }
+    incrementProfileCounter(&profile_folded_stacks, stack);
+    free(stack);
+}
+
+static int compareProfileFunctions(const void *a, const void *b) {
+    const ProfileFunction* x = *(const ProfileFunction**) a;
+    const ProfileFunction* y = *(const ProfileFunction**) b;
+    if (x->exclusive == y->exclusive)
+        return 0;
+    return x->exclusive < y->exclusive ? 1 : -1;
+}
+
+static int compareProfileCounters(const void *a, const void *b) {
+    const ProfileCounter* x = (const ProfileCounter*) a;
+    const ProfileCounter* y = (const ProfileCounter*) b;
+    if (x->count == y->count)
+        return strcmp(x->key, y->key);
+    return x->count < y->count ? 1 : -1;
+}
+
+static void compactProfileCounters(profile_counter_table* table) {
+    unsigned long long j = 0;
+    for (unsigned long long i = 0; i < table->capacity; i++) {
+        if (table->arr[i].key != NULL)
+            table->arr[j++] = table->arr[i];
+    }
+    // Nothing was sampled when the table was never allocated
+    if (j > 0)
+        qsort(table->arr, j, sizeof(ProfileCounter), compareProfileCounters);
+}
+
+static void freeProfileCounters(profile_counter_table* table) {
+    for (unsigned long long i = 0; i < table->size; i++)
+        free(table->arr[i].key);
+    free(table->arr);
+    table->arr = NULL;
+    table->capacity = 0;
+    table->size = 0;
+}
+
+void reportProfile() {
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
+    setProfileTimer(0);
+#endif
+
+    // Frames left open by `exit` or an error are closed at the moment of the report
+    while (profile_frames_size > 0)
+        profileFunctionExit();
+
+    unsigned long long total = profileClock() - profile_start_time;
+
+    ProfileFunction** sorted = malloc((profile_functions_size + 1) * sizeof(ProfileFunction*));
+    for (unsigned i = 0; i < profile_functions_size; i++)
+        sorted[i] = &profile_functions[i];
+    qsort(sorted, profile_functions_size, sizeof(ProfileFunction*), compareProfileFunctions);
+
+    compactProfileCounters(&profile_line_samples);
+    compactProfileCounters(&profile_folded_stacks);
+
+    fprintf(stderr, "\nProfile (total: %.3f ms)\n\n", total / 1e6);
+    fprintf(stderr, "%12s %16s %16s  %s\n", "calls", "inclusive (ms)", "exclusive (ms)", "function");
+    for (unsigned i = 0; i < profile_functions_size; i++) {
+        fprintf(
+            stderr,
+            "%12llu %16.3f %16.3f  %s\n",
+            sorted[i]->calls,
+            sorted[i]->inclusive / 1e6,
+            sorted[i]->exclusive / 1e6,
+            sorted[i]->name
+        );
+    }
+
+    fprintf(stderr, "\n%12s  %s\n", "samples", "line");
+    for (unsigned long long i = 0; i < profile_line_samples.size; i++)
+        fprintf(stderr, "%12llu  %s\n", profile_line_samples.arr[i].count, profile_line_samples.arr[i].key);
+
+    FILE *folded = fopen(__KAOS_PROFILE_FOLDED_FILE__, "w");
+    if (folded != NULL) {
+        for (unsigned long long i = 0; i < profile_folded_stacks.size; i++)
+            fprintf(folded, "%s %llu\n", profile_folded_stacks.arr[i].key, profile_folded_stacks.arr[i].count);
+        fclose(folded);
+        fprintf(stderr, "\nFolded stacks are written to: %s\n", __KAOS_PROFILE_FOLDED_FILE__);
+    }
+
+    free(sorted);
+    for (unsigned i = 0; i < profile_functions_size; i++)
+        free(profile_functions[i].name);
+    free(profile_functions);
+    profile_functions = NULL;
+    profile_functions_size = 0;
+    profile_functions_capacity = 0;
+    free(profile_frames);
+    profile_frames = NULL;
+    profile_frames_capacity = 0;
+    freeProfileCounters(&profile_line_samples);
+    freeProfileCounters(&profile_folded_stacks);
+
+    profile_enabled = false;
+}
+
+#else
+
+InstrumentSite** instrument_sites = NULL;
+unsigned instrument_sites_size = 0;
+unsigned instrument_sites_capacity = 0;
+
+InstrumentFrame* instrument_frames = NULL;
+unsigned instrument_frames_size = 0;
+unsigned instrument_frames_capacity = 0;
+
+// The root of the calling context tree stands for the main program
+InstrumentNode instrument_root;
+InstrumentNode* instrument_node = &instrument_root;
+unsigned long long instrument_root_children = 0;
+
+unsigned long long instrument_start_cycles = 0;
+unsigned long long instrument_start_time = 0;
+
+// Set by SIGUSR1, consumed by the next entry to or exit from an instrumented function
+volatile sig_atomic_t instrument_dump_pending = 0;
+
+// Timestamp counter of the CPU, or the monotonic clock in nanoseconds where there is none
+unsigned long long instrumentCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    unsigned long long cycles;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(cycles));
+    return cycles;
+#else
+    return profileClock();
+#endif
+}
+
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
+static void instrumentSignalHandler(int signum) {
+    (void) signum;
+    instrument_dump_pending = 1;
+}
+#endif
+
+void startInstrumentation() {
+    profile_enabled = true;
+    instrument_start_time = profileClock();
+    instrument_start_cycles = instrumentCycles();
+
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = instrumentSignalHandler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGUSR1, &action, NULL);
+#endif
+}
+
+static int compareInstrumentSites(const void *a, const void *b) {
+    const InstrumentSite* x = *(const InstrumentSite**) a;
+    const InstrumentSite* y = *(const InstrumentSite**) b;
+    if (x->exclusive == y->exclusive)
+        return 0;
+    return x->exclusive < y->exclusive ? 1 : -1;
+}
+
+static void writeInstrumentedStacks(FILE *folded, InstrumentNode* node, char *stack) {
+    for (InstrumentNode* child = node->child; child != NULL; child = child->sibling) {
+        InstrumentSite* site = child->site;
+        char *child_stack = malloc(strlen(stack) + strlen(site->name) + strlen(site->module) + 32);
+        sprintf(child_stack, "%s;%s (%s:%d)", stack, site->name, site->module, site->lineno);
+        if (child->exclusive > 0)
+            fprintf(folded, "%s %llu\n", child_stack, child->exclusive);
+        writeInstrumentedStacks(folded, child, child_stack);
+        free(child_stack);
+    }
+}
+
+// Prints the counters of the finished calls and writes their stacks, weighted by cycles, in the folded format
+static void writeInstrumentation() {
+    unsigned long long total = instrumentCycles() - instrument_start_cycles;
+    unsigned long long total_time = profileClock() - instrument_start_time;
+
+    InstrumentSite** sorted = malloc((instrument_sites_size + 1) * sizeof(InstrumentSite*));
+    for (unsigned i = 0; i < instrument_sites_size; i++)
+        sorted[i] = instrument_sites[i];
+    qsort(sorted, instrument_sites_size, sizeof(InstrumentSite*), compareInstrumentSites);
+
+    fprintf(stderr, "\nInstrumentation (total: %.3f ms, %llu cycles)\n\n", total_time / 1e6, total);
+    fprintf(stderr, "%12s %20s %20s  %s\n", "calls", "inclusive (cycles)", "exclusive (cycles)", "function");
+    for (unsigned i = 0; i < instrument_sites_size; i++) {
+        fprintf(
+            stderr,
+            "%12llu %20llu %20llu  %s (%s:%d)\n",
+            sorted[i]->calls,
+            sorted[i]->inclusive,
+            sorted[i]->exclusive,
+            sorted[i]->name,
+            sorted[i]->module,
+            sorted[i]->lineno
+        );
+    }
+    free(sorted);
+
+    FILE *folded = fopen(__KAOS_PROFILE_FOLDED_FILE__, "w");
+    if (folded != NULL) {
+        if (total > instrument_root_children)
+            fprintf(folded, "main %llu\n", total - instrument_root_children);
+        writeInstrumentedStacks(folded, &instrument_root, "main");
+        fclose(folded);
+        fprintf(stderr, "\nFolded stacks are written to: %s\n", __KAOS_PROFILE_FOLDED_FILE__);
+    }
+}
+
+void instrumentEnter(InstrumentSite* site) {
+    if (instrument_dump_pending) {
+        instrument_dump_pending = 0;
+        writeInstrumentation();
+    }
+
+    if (!site->is_registered) {
+        if (instrument_sites_capacity == instrument_sites_size) {
+            instrument_sites_capacity = instrument_sites_capacity == 0 ? 16 : instrument_sites_capacity * 2;
+            instrument_sites = realloc(instrument_sites, instrument_sites_capacity * sizeof(InstrumentSite*));
+        }
+        instrument_sites[instrument_sites_size++] = site;
+        site->is_registered = true;
+    }
+
+    InstrumentNode* node = instrument_node->child;
+    while (node != NULL && node->site != site)
+        node = node->sibling;
+    if (node == NULL) {
+        node = calloc(1, sizeof(InstrumentNode));
+        node->site = site;
+        node->parent = instrument_node;
+        node->sibling = instrument_node->child;
+        instrument_node->child = node;
+    }
+    node->calls++;
+    site->calls++;
+    site->active++;
+    instrument_node = node;
+
+    if (instrument_frames_capacity == instrument_frames_size) {
+        instrument_frames_capacity = instrument_frames_capacity == 0 ? 16 : instrument_frames_capacity * 2;
+        instrument_frames = realloc(instrument_frames, instrument_frames_capacity * sizeof(InstrumentFrame));
+    }
+
+    InstrumentFrame* frame = &instrument_frames[instrument_frames_size++];
+    frame->node = node;
+    frame->children = 0;
+    frame->start = instrumentCycles();
+}
+
+static void popInstrumentFrame(unsigned long long now) {
+    InstrumentFrame* frame = &instrument_frames[--instrument_frames_size];
+    InstrumentSite* site = frame->node->site;
+    unsigned long long elapsed = now - frame->start;
+
+    frame->node->exclusive += elapsed - frame->children;
+    site->exclusive += elapsed - frame->children;
+    // Count the time of a recursive function only once, at its outermost call
+    if (--site->active == 0)
+        site->inclusive += elapsed;
+
+    if (instrument_frames_size > 0)
+        instrument_frames[instrument_frames_size - 1].children += elapsed;
+    else
+        instrument_root_children += elapsed;
+    instrument_node = frame->node->parent;
+}
+
+void instrumentExit(InstrumentSite* site) {
+    unsigned long long now = instrumentCycles();
+
+    // A decision that breaks or continues a loop jumps out of its function without an exit,
+    // so the frames above the innermost one of the site are closed together with it
+    unsigned i = instrument_frames_size;
+    while (i > 0 && instrument_frames[i - 1].node->site != site)
+        i--;
+    while (i > 0 && instrument_frames_size >= i)
+        popInstrumentFrame(now);
+
+    if (instrument_dump_pending) {
+        instrument_dump_pending = 0;
+        writeInstrumentation();
+    }
+}
+
+static void freeInstrumentNodes(InstrumentNode* node) {
+    InstrumentNode* child = node->child;
+    while (child != NULL) {
+        InstrumentNode* sibling = child->sibling;
+        freeInstrumentNodes(child);
+        free(child);
+        child = sibling;
+    }
+    node->child = NULL;
+}
+
+void reportInstrumentation() {
+    // Frames left open by `exit` or an error are closed at the moment of the report
+    unsigned long long now = instrumentCycles();
+    while (instrument_frames_size > 0)
+        popInstrumentFrame(now);
+
+    writeInstrumentation();
+
+    freeInstrumentNodes(&instrument_root);
+    instrument_node = &instrument_root;
+    free(instrument_frames);
+    instrument_frames = NULL;
+    instrument_frames_capacity = 0;
+    free(instrument_sites);
+    instrument_sites = NULL;
+    instrument_sites_size = 0;
+    instrument_sites_capacity = 0;
+
+    profile_enabled = false;
+}
+
+#endif
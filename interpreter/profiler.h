@@ -0,0 +1,107 @@
+/*
+ * Description: Profiler module of the Chaos Programming Language's source
+ *
+ * Copyright (c) 2019-2020 Chaos Language Development Authority <info@chaos-lang.org>
+ *
+ * License: GNU General Public License v3.0
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors: M. Mert Yildiran <me@mertyildiran.com>
+ */
+
+#ifndef KAOS_PROFILER_H
+#define KAOS_PROFILER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#define __KAOS_PROFILE_FOLDED_FILE__ "chaos-profile.folded"
+#define __KAOS_PROFILE_SAMPLE_INTERVAL_USEC__ 1000
+
+struct _Function;
+struct ASTNode;
+
+bool profile_enabled;
+
+unsigned long long profileClock();
+
+#ifndef CHAOS_COMPILER
+typedef struct ProfileFunction {
+    char *name;
+    unsigned long long calls;
+    unsigned long long inclusive;
+    unsigned long long exclusive;
+    unsigned long long active;
+} ProfileFunction;
+
+typedef struct ProfileFrame {
+    unsigned id;
+    unsigned long long start;
+    unsigned long long children;
+} ProfileFrame;
+
+typedef struct ProfileCounter {
+    char *key;
+    unsigned long long count;
+} ProfileCounter;
+
+typedef struct profile_counter_table {
+    ProfileCounter* arr;
+    unsigned long long capacity, size;
+} profile_counter_table;
+
+void startProfiler();
+void profileFunctionEnter(struct _Function* function);
+void profileFunctionExit();
+void profileLine(struct ASTNode* ast_node);
+void reportProfile();
+#else
+// A function of a program compiled with `--instrument`, defined statically next to its C function
+typedef struct InstrumentSite {
+    const char *name;
+    const char *module;
+    int lineno;
+    bool is_registered;
+    unsigned long long calls;
+    unsigned long long inclusive;
+    unsigned long long exclusive;
+    unsigned long long active;
+} InstrumentSite;
+
+// A node of the calling context tree, one for each distinct stack of the instrumented functions
+typedef struct InstrumentNode {
+    InstrumentSite* site;
+    struct InstrumentNode* parent;
+    struct InstrumentNode* child;
+    struct InstrumentNode* sibling;
+    unsigned long long calls;
+    unsigned long long exclusive;
+} InstrumentNode;
+
+typedef struct InstrumentFrame {
+    InstrumentNode* node;
+    unsigned long long start;
+    unsigned long long children;
+} InstrumentFrame;
+
+unsigned long long instrumentCycles();
+void startInstrumentation();
+void instrumentEnter(InstrumentSite* site);
+void instrumentExit(InstrumentSite* site);
+void reportInstrumentation();
+#endif
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Description: Runtime statistics module of the Chaos Programming Language's source
+ *
+ * Copyright (c) 2019-2020 Chaos Language Development Authority <info@chaos-lang.org>
+ *
+ * License: GNU General Public License v3.0
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors: M. Mert Yildiran <me@mertyildiran.com>
+ */
+
+#include "stats.h"
+#include "function.h"
+#include "../ast/ast.h"
+
+#ifndef CHAOS_COMPILER
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define __KAOS_STATS_HEAP__
+#endif
+
+static unsigned long long getHeapInUse() {
+#ifdef __KAOS_STATS_HEAP__
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+static void reportStatsText(unsigned long long heap) {
+    fprintf(stderr, "\nStatistics\n\n");
+    fprintf(stderr, "%-28s %16.3f\n", "parse (ms)", kaos_stats.parse_time / 1e6);
+    fprintf(stderr, "%-28s %16.3f\n", "preemptive check (ms)", kaos_stats.preemptive_time / 1e6);
+    fprintf(stderr, "%-28s %16.3f\n", "execution (ms)", kaos_stats.execution_time / 1e6);
+    fprintf(stderr, "%-28s %16llu\n", "symbols created", kaos_stats.symbols_created);
+    fprintf(stderr, "%-28s %16llu\n", "symbols freed", kaos_stats.symbols_freed);
+    fprintf(stderr, "%-28s %16llu\n", "peak live symbols", kaos_stats.symbols_peak);
+    fprintf(stderr, "%-28s %16llu\n", "complex deep copies", kaos_stats.deep_copies);
+    fprintf(stderr, "%-28s %16llu\n", "function calls", kaos_stats.function_calls);
+    fprintf(stderr, "%-28s %16llu\n", "dynamic library calls", kaos_stats.dynamic_library_calls);
+#ifdef __KAOS_STATS_HEAP__
+    fprintf(stderr, "%-28s %16llu\n", "heap in use at exit (bytes)", heap);
+#endif
+
+    fprintf(stderr, "\n%16s  %s\n", "executed", "AST node type");
+    for (unsigned i = 0; i < __KAOS_AST_NODE_TYPE_COUNT__; i++) {
+        if (stats_ast_nodes[i] == 0)
+            continue;
+        fprintf(stderr, "%16llu  %s\n", stats_ast_nodes[i], getAstNodeTypeName(i));
+    }
+}
+
+static void reportStatsJson(unsigned long long heap) {
+    fprintf(stderr, "{\n");
+    fprintf(stderr, "  \"parse_ns\": %llu,\n", kaos_stats.parse_time);
+    fprintf(stderr, "  \"preemptive_check_ns\": %llu,\n", kaos_stats.preemptive_time);
+    fprintf(stderr, "  \"execution_ns\": %llu,\n", kaos_stats.execution_time);
+    fprintf(stderr, "  \"symbols_created\": %llu,\n", kaos_stats.symbols_created);
+    fprintf(stderr, "  \"symbols_freed\": %llu,\n", kaos_stats.symbols_freed);
+    fprintf(stderr, "  \"symbols_peak\": %llu,\n", kaos_stats.symbols_peak);
+    fprintf(stderr, "  \"deep_copies\": %llu,\n", kaos_stats.deep_copies);
+    fprintf(stderr, "  \"function_calls\": %llu,\n", kaos_stats.function_calls);
+    fprintf(stderr, "  \"dynamic_library_calls\": %llu,\n", kaos_stats.dynamic_library_calls);
+#ifdef __KAOS_STATS_HEAP__
+    fprintf(stderr, "  \"heap_in_use_bytes\": %llu,\n", heap);
+#endif
+    fprintf(stderr, "  \"ast_nodes\": {");
+    bool first = true;
+    for (unsigned i = 0; i < __KAOS_AST_NODE_TYPE_COUNT__; i++) {
+        if (stats_ast_nodes[i] == 0)
+            continue;
+        fprintf(stderr, "%s\n    \"%s\": %llu", first ? "" : ",", getAstNodeTypeName(i), stats_ast_nodes[i]);
+        first = false;
+    }
+    fprintf(stderr, first ? "}\n" : "\n  }\n");
+    fprintf(stderr, "}\n");
+}
+
+void reportStats() {
+    unsigned long long heap = getHeapInUse();
+
+    // The program is still executing when it is ended by `exit` or an error
+    if (kaos_stats.execution_start != 0) {
+        kaos_stats.execution_time += profileClock() - kaos_stats.execution_start;
+        kaos_stats.execution_start = 0;
+    }
+
+    if (stats_format == STATS_JSON)
+        reportStatsJson(heap);
+    else
+        reportStatsText(heap);
+
+    stats_format = STATS_DISABLED;
+}
+
+#endif
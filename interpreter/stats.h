@@ -0,0 +1,54 @@
+/*
+ * Description: Runtime statistics module of the Chaos Programming Language's source
+ *
+ * Copyright (c) 2019-2020 Chaos Language Development Authority <info@chaos-lang.org>
+ *
+ * License: GNU General Public License v3.0
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors: M. Mert Yildiran <me@mertyildiran.com>
+ */
+
+#ifndef KAOS_STATS_H
+#define KAOS_STATS_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+enum StatsFormat { STATS_DISABLED, STATS_TEXT, STATS_JSON };
+
+typedef struct KaosStats {
+    unsigned long long symbols_created;
+    unsigned long long symbols_freed;
+    unsigned long long symbols_peak;
+    unsigned long long deep_copies;
+    unsigned long long function_calls;
+    unsigned long long dynamic_library_calls;
+    unsigned long long parse_time;
+    unsigned long long preemptive_time;
+    unsigned long long execution_time;
+    unsigned long long execution_start;
+} KaosStats;
+
+KaosStats kaos_stats;
+enum StatsFormat stats_format;
+
+// Indexed by enum ASTNodeType, sized by __KAOS_AST_NODE_TYPE_COUNT__
+extern unsigned long long stats_ast_nodes[];
+
+#ifndef CHAOS_COMPILER
+void reportStats();
+#endif
+
+#endif
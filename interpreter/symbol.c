@@ -76,6 +76,17 @@ Symbol* addSymbol(char *name, enum Type type, union Value value, enum ValueType
     symbol->scope = isComplexMode() ? scopeless : getCurrentScope();
     symbol->role = DEFAULT;
 
+    linkSymbolToScope(symbol);
+
+    addSymbolToComplex(symbol);
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__) && !defined(CHAOS_COMPILER)
+    add_suggestion(name);
+#endif
+
+    return symbol;
+}
+
+void linkSymbolToScope(Symbol* symbol) {
     if (symbol->scope->start_symbol == NULL) {
         symbol->scope->start_symbol = symbol;
         symbol->scope->end_symbol = symbol;
@@ -86,12 +97,8 @@ Symbol* addSymbol(char *name, enum Type type, union Value value, enum ValueType
         symbol->scope->end_symbol->next = NULL;
     }
 
-    addSymbolToComplex(symbol);
-#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__) && !defined(CHAOS_COMPILER)
-    add_suggestion(name);
-#endif
-
-    return symbol;
+    if (++kaos_stats.symbols_created - kaos_stats.symbols_freed > kaos_stats.symbols_peak)
+        kaos_stats.symbols_peak = kaos_stats.symbols_created - kaos_stats.symbols_freed;
 }
 
 Symbol* updateSymbol(char *name, enum Type type, union Value value, enum ValueType value_type) {
@@ -146,6 +153,7 @@ void freeSymbol(Symbol* symbol) {
     free(symbol->name);
     free(symbol->secondary_name);
     free(symbol);
+    kaos_stats.symbols_freed++;
 }
 
 Symbol* findSymbol(char *name) {
@@ -206,6 +214,8 @@ Symbol* deepCopySymbol(Symbol* symbol, enum Type type, char *key) {
 }
 
 Symbol* deepCopyComplex(char *name, Symbol* symbol) {
+    kaos_stats.deep_copies++;
+
     if (symbol->type == K_LIST) {
         addSymbolList(NULL);
     } else if (symbol->type == K_DICT) {
@@ -328,6 +338,22 @@ long long _getSymbolValueInt(Symbol* symbol) {
     return 0;
 }
 
+KaosNumber getSymbolValueNumber(char *name) {
+    Symbol* symbol = getSymbol(name);
+    return _getSymbolValueNumber(symbol);
+}
+
+KaosNumber _getSymbolValueNumber(Symbol* symbol) {
+    KaosNumber number = {0, 0.0, false};
+    if (symbol->value_type == V_FLOAT) {
+        number.f = symbol->value.f;
+        number.is_float = true;
+    } else {
+        number.i = _getSymbolValueInt(symbol);
+    }
+    return number;
+}
+
 char* getSymbolValueString_NullIfNotString(Symbol* symbol) {
     if (symbol->value_type != V_STRING) {
         return NULL;
@@ -363,181 +389,166 @@ long long getSymbolValueInt_ZeroIfNotInt(Symbol* symbol) {
 }
 
 void printSymbolValue(Symbol* symbol, bool is_complex, bool pretty, bool escaped, unsigned long iter) {
-    char *encoded = NULL;
-    encoded = encodeSymbolValueToString(symbol, is_complex, pretty, escaped, iter, encoded, false);
-    printf("%s", encoded);
-    free(encoded);
+    string_builder sb;
+    string_builder_init_stream(&sb, stdout);
+    encodeSymbolValue(symbol, is_complex, pretty, escaped, iter, &sb, false);
 }
 
 char* encodeSymbolValueToString(Symbol* symbol, bool is_complex, bool pretty, bool escaped, unsigned long iter, char *encoded, bool double_quotes) {
+    string_builder sb;
+    string_builder_init(&sb);
+    if (encoded != NULL) {
+        string_builder_append(&sb, encoded);
+        free(encoded);
+    }
+    encodeSymbolValue(symbol, is_complex, pretty, escaped, iter, &sb, double_quotes);
+    return string_builder_finish(&sb);
+}
+
+static void encodeSymbolValueIndent(string_builder* sb, unsigned long iter) {
+    for (unsigned long j = 0; j < iter; j++) {
+        string_builder_append_length(sb, __KAOS_TAB__, strlen(__KAOS_TAB__));
+    }
+}
+
+static void encodeSymbolValueQuoted(string_builder* sb, char *s, bool double_quotes) {
+    char *quote = double_quotes ? "\"" : "'";
+    string_builder_append_length(sb, quote, 1);
+    string_builder_append(sb, s);
+    string_builder_append_length(sb, quote, 1);
+}
+
+void encodeSymbolValue(Symbol* symbol, bool is_complex, bool pretty, bool escaped, unsigned long iter, string_builder* sb, bool double_quotes) {
     switch (symbol->type)
     {
         case K_BOOL:
             switch (symbol->value_type)
             {
                 case V_BOOL:
-                    encoded = strcat_ext(encoded, symbol->value.b ? "true" : "false");
+                    string_builder_append(sb, symbol->value.b ? "true" : "false");
                     break;
                 case V_VOID:
-                    encoded = strcat_ext(encoded, "N/A");
+                    string_builder_append(sb, "N/A");
                     break;
                 default:
                     throw_error(E_UNEXPECTED_VALUE_TYPE, symbol->name, NULL, 0, symbol->value_type);
                     break;
             }
-            return encoded;
+            return;
         case K_NUMBER:
             switch (symbol->value_type)
             {
                 case V_INT:
-                    encoded = snprintf_concat_int(encoded, "%lld", symbol->value.i);
+                    string_builder_append_int(sb, symbol->value.i);
                     break;
                 case V_FLOAT:
-                    encoded = snprintf_concat_float(encoded, "%Lg", symbol->value.f);
+                    string_builder_append_float(sb, symbol->value.f);
                     break;
                 case V_VOID:
-                    encoded = strcat_ext(encoded, "N/A");
+                    string_builder_append(sb, "N/A");
                     break;
                 default:
                     throw_error(E_UNEXPECTED_VALUE_TYPE, symbol->name, NULL, 0, symbol->value_type);
                     break;
             }
-            return encoded;
+            return;
         case K_STRING:
             if (symbol->value_type == V_VOID) {
-                return strcat_ext(encoded, "N/A");
+                string_builder_append(sb, "N/A");
+                return;
             }
             if (is_complex) {
-                if (double_quotes) {
-                    encoded = snprintf_concat_string(encoded, "\"%s\"", symbol->value.s);
-                } else {
-                    encoded = snprintf_concat_string(encoded, "'%s'", symbol->value.s);
-                }
+                encodeSymbolValueQuoted(sb, symbol->value.s, double_quotes);
             } else {
                 if (escaped) {
-                    char* out = escape_the_sequences_in_string_literal(symbol->value.s);
-                    encoded = strcat_ext(encoded, out);
-                    free(out);
+                    string_builder_append_escaped(sb, symbol->value.s);
                 } else {
-                    encoded = strcat_ext(encoded, symbol->value.s);
+                    string_builder_append(sb, symbol->value.s);
                 }
             }
-            return encoded;
+            return;
         case K_LIST:
-            iter++;
-            encoded = strcat_ext(encoded, "[");
-            if (pretty) {
-                encoded = strcat_ext(encoded, "\n");
-            }
-            for (unsigned long i = 0; i < symbol->children_count; i++) {
-                if (pretty) {
-                    for (unsigned long j = 0; j < iter; j++) {
-                        encoded = strcat_ext(encoded, __KAOS_TAB__);
-                    }
-                }
-                encoded = encodeSymbolValueToString(symbol->children[i], true, pretty, escaped, iter, encoded, double_quotes);
-                if (i + 1 != symbol->children_count) {
-                    if (pretty) {
-                        encoded = strcat_ext(encoded, ",\n");
-                    } else {
-                        encoded = strcat_ext(encoded, ", ");
-                    }
-                }
-            }
-            if (pretty) {
-                encoded = strcat_ext(encoded, "\n");
-            }
-            if (pretty) {
-                for (unsigned long j = 0; j < (iter - 1); j++) {
-                    encoded = strcat_ext(encoded, __KAOS_TAB__);
-                }
-            }
-            encoded = strcat_ext(encoded, "]");
-            return encoded;
         case K_DICT:
             iter++;
-            encoded = strcat_ext(encoded, "{");
+            string_builder_append_length(sb, symbol->type == K_LIST ? "[" : "{", 1);
             if (pretty) {
-                encoded = strcat_ext(encoded, "\n");
+                string_builder_append_length(sb, "\n", 1);
             }
             for (unsigned long i = 0; i < symbol->children_count; i++) {
                 if (pretty) {
-                    for (unsigned long j = 0; j < iter; j++) {
-                        encoded = strcat_ext(encoded, __KAOS_TAB__);
-                    }
+                    encodeSymbolValueIndent(sb, iter);
                 }
                 Symbol* child = symbol->children[i];
-                if (double_quotes) {
-                    encoded = snprintf_concat_string(encoded, "\"%s\": ", child->key);
-                } else {
-                    encoded = snprintf_concat_string(encoded, "'%s': ", child->key);
+                if (symbol->type == K_DICT) {
+                    encodeSymbolValueQuoted(sb, child->key, double_quotes);
+                    string_builder_append_length(sb, ": ", 2);
                 }
-                encoded = encodeSymbolValueToString(child, true, pretty, escaped, iter, encoded, double_quotes);
+                encodeSymbolValue(child, true, pretty, escaped, iter, sb, double_quotes);
                 if (i + 1 != symbol->children_count) {
-                    if (pretty) {
-                        encoded = strcat_ext(encoded, ",\n");
-                    } else {
-                        encoded = strcat_ext(encoded, ", ");
-                    }
+                    string_builder_append_length(sb, pretty ? ",\n" : ", ", 2);
                 }
             }
             if (pretty) {
-                encoded = strcat_ext(encoded, "\n");
-            }
-            if (pretty) {
-                for (unsigned long j = 0; j < (iter - 1); j++) {
-                    encoded = strcat_ext(encoded, __KAOS_TAB__);
-                }
+                string_builder_append_length(sb, "\n", 1);
+                encodeSymbolValueIndent(sb, iter - 1);
             }
-            encoded = strcat_ext(encoded, "}");
-            return encoded;
+            string_builder_append_length(sb, symbol->type == K_LIST ? "]" : "}", 1);
+            return;
         case K_ANY:
             switch (symbol->value_type)
             {
                 case V_STRING:
-                    encoded = strcat_ext(encoded, symbol->value.s);
+                    string_builder_append(sb, symbol->value.s);
                     break;
                 case V_INT:
-                    encoded = snprintf_concat_int(encoded, "%lld", symbol->value.i);
+                    string_builder_append_int(sb, symbol->value.i);
                     break;
                 case V_FLOAT:
-                    encoded = snprintf_concat_float(encoded, "%Lg", symbol->value.f);
+                    string_builder_append_float(sb, symbol->value.f);
                     break;
                 case V_BOOL:
-                    encoded = strcat_ext(encoded, symbol->value.b ? "true" : "false");
+                    string_builder_append(sb, symbol->value.b ? "true" : "false");
                     break;
                 case V_VOID:
-                    encoded = strcat_ext(encoded, "N/A");
+                    string_builder_append(sb, "N/A");
                     break;
                 default:
                     throw_error(E_UNEXPECTED_VALUE_TYPE, symbol->name, NULL, 0, symbol->value_type);
                     break;
             }
-            return encoded;
+            return;
         default:
             throw_error(E_UNKNOWN_VARIABLE_TYPE, getTypeName(symbol->type), symbol->name);
             break;
     }
-    return encoded;
 }
 
 void printSymbolValueEndWith(Symbol* symbol, char *end, bool pretty, bool escaped) {
     printSymbolValue(symbol, false, pretty, escaped, 0);
-    printf("%s", end);
+    fputs(end, stdout);
 }
 
 void printSymbolValueEndWithNewLine(Symbol* symbol, bool pretty, bool escaped) {
     printSymbolValueEndWith(symbol, "\n", pretty, escaped);
 }
 
+void printNumber(KaosNumber number, char *end) {
+    if (number.is_float) {
+        outputFloat(number.f, end);
+    } else {
+        outputInt(number.i, end);
+    }
+}
+
 bool isDefined(char *name) {
+    // Nameless symbols, like the parameters of the functions, never collide
+    if (name == NULL)
+        return false;
+
     FunctionCall* scope = getCurrentScope();
     symbol_cursor = scope->start_symbol;
     while (symbol_cursor != NULL) {
-        if (
-            symbol_cursor->name != NULL &&
-            name != NULL && strcmp(symbol_cursor->name, name) == 0
-        ) {
+        if (symbol_cursor->name != NULL && strcmp(symbol_cursor->name, name) == 0) {
             return true;
         }
         symbol_cursor = symbol_cursor->next;
@@ -563,6 +574,10 @@ void addSymbolToComplex(Symbol* symbol) {
 }
 
 void printSymbolTable() {
+    // One builder is reused for every symbol's value
+    string_builder sb;
+    string_builder_init(&sb);
+
     for (unsigned i = 0; i < function_call_stack.size + 1; i++) {
         Symbol *symbol;
         if (i == 0) {
@@ -575,8 +590,8 @@ void printSymbolTable() {
 
         printf("\t[start] =>\n");
         while(symbol != NULL) {
-            char *encoded = NULL;
-            encoded = encodeSymbolValueToString(symbol, false, false, true, 0, encoded, false);
+            sb.size = 0;
+            encodeSymbolValue(symbol, false, false, true, 0, &sb, false);
             FunctionCall* scope = symbol->scope;
             printf(
                 "\t\t{id: %llu, name: %s, 2nd_name: %s, key: %s, scope: %s, type: %u, 2nd_type: %u, value_type: %u, role: %u, param_of: %s, value: %s} =>\n",
@@ -590,13 +605,14 @@ void printSymbolTable() {
                 symbol->value_type,
                 symbol->role,
                 symbol->param_of != NULL ? symbol->param_of->name : "",
-                encoded
+                sb.size == 0 ? "" : sb.arr
             );
             symbol = symbol->next;
-            free(encoded);
         }
         printf("\t[end]\n");
     }
+
+    free(sb.arr);
 }
 
 Symbol* addSymbolBool(char *name, bool b) {
@@ -635,6 +651,12 @@ void updateSymbolFloat(char *name, long double f) {
     updateSymbol(name, K_NUMBER, value, V_FLOAT);
 }
 
+Symbol* addSymbolNumber(char *name, KaosNumber number) {
+    if (number.is_float)
+        return addSymbolFloat(name, number.f);
+    return addSymbolInt(name, number.i);
+}
+
 Symbol* addSymbolString(char *name, char *s) {
     union Value value;
     value.s = malloc(1 + strlen(s));
@@ -656,6 +678,36 @@ void addSymbolList(char *name) {
     pushComplexModeStack(complex_mode);
 }
 
+Symbol* addSymbolListWithCapacity(char *name, unsigned long capacity) {
+    union Value value;
+    value.i = 0;
+    Symbol* list = addSymbol(name, K_LIST, value, V_VOID);
+    if (capacity > 0) {
+        list->children = malloc(capacity * sizeof(Symbol*));
+        if (list->children == NULL)
+            throw_error(E_MEMORY_ALLOCATION_FOR_LIST_FAILED, name);
+    }
+    return list;
+}
+
+Symbol* addSymbolToScope(FunctionCall* scope, enum Type type, union Value value, enum ValueType value_type) {
+    Symbol* symbol = (struct Symbol*)calloc(1, sizeof(Symbol));
+    symbol->id = symbol_id_counter++;
+    symbol->type = type;
+    symbol->value = value;
+    symbol->value_type = value_type;
+    symbol->scope = scope;
+    symbol->role = DEFAULT;
+    linkSymbolToScope(symbol);
+    return symbol;
+}
+
+Symbol* appendComplexChild(Symbol* complex, enum Type type, union Value value, enum ValueType value_type) {
+    Symbol* symbol = addSymbolToScope(scopeless, type, value, value_type);
+    complex->children[complex->children_count++] = symbol;
+    return symbol;
+}
+
 Symbol* createCloneFromSymbolByName(char *clone_name, enum Type type, char *name, enum Type extra_type) {
     Symbol* symbol = getSymbol(name);
     Symbol* clone_symbol = createCloneFromSymbol(clone_name, type, symbol, extra_type);
@@ -745,6 +797,74 @@ Symbol* updateSymbolByClonning(char *clone_name, Symbol* symbol) {
     return clone_symbol;
 }
 
+Symbol* createSymbolByMoving(char *name, enum Type type, Symbol* symbol, enum Type extra_type) {
+    if (symbol->type == K_ANY && type != K_ANY) {
+        Symbol* clone_symbol = createCloneFromSymbol(name, type, symbol, extra_type);
+        removeSymbol(symbol);
+        return clone_symbol;
+    }
+
+    if (type != K_ANY &&
+        symbol->type != type
+    ) {
+        throw_error(E_ILLEGAL_VARIABLE_TYPE_FOR_VARIABLE, getTypeName(type), name);
+    }
+
+    if (findSymbol(name) != NULL) {
+        throw_error(E_VARIABLE_ALREADY_DEFINED, name);
+    }
+
+    if (symbol->type == K_LIST || symbol->type == K_DICT) {
+        if (symbol->secondary_type != extra_type) {
+            throw_error(E_ILLEGAL_VARIABLE_TYPE_FOR_VARIABLE, getTypeName(extra_type), name);
+        }
+    } else if (type == K_ANY) {
+        symbol->type = K_ANY;
+    }
+
+    free(symbol->name);
+    symbol->name = malloc(1 + strlen(name));
+    strcpy(symbol->name, name);
+    // Re-linking within the same scope would move the symbol after its own elements
+    if (symbol->scope != getCurrentScope())
+        changeSymbolScope(symbol, getCurrentScope());
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__) && !defined(CHAOS_COMPILER)
+    add_suggestion(name);
+#endif
+    return symbol;
+}
+
+Symbol* updateSymbolByMoving(char *name, Symbol* symbol) {
+    Symbol* target_symbol = getSymbol(name);
+
+    if ((symbol->type == K_ANY && target_symbol->type != K_ANY) ||
+        (target_symbol->type == K_ANY && (symbol->type == K_LIST || symbol->type == K_DICT))
+    ) {
+        Symbol* clone_symbol = updateSymbolByClonning(name, symbol);
+        removeSymbol(symbol);
+        return clone_symbol;
+    }
+
+    if (target_symbol->type != K_ANY &&
+        target_symbol->type != symbol->type
+    ) {
+        append_to_array_without_malloc(&free_string_stack, name);
+        throw_error(E_ILLEGAL_VARIABLE_TYPE_FOR_VARIABLE, getTypeName(symbol->type), name);
+    }
+
+    if (target_symbol->type == K_ANY)
+        symbol->type = K_ANY;
+
+    free(symbol->name);
+    symbol->name = malloc(1 + strlen(name));
+    strcpy(symbol->name, name);
+    if (symbol->scope != getCurrentScope())
+        changeSymbolScope(symbol, getCurrentScope());
+
+    removeSymbol(target_symbol);
+    return symbol;
+}
+
 Symbol* updateSymbolByClonningName(char *clone_name, char *name) {
     Symbol* symbol = getSymbol(name);
     updateSymbolByClonning(clone_name, symbol);
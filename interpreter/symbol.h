@@ -33,6 +33,7 @@ typedef struct Symbol Symbol;
 #include "../enums.h"
 #include "errors.h"
 #include "../utilities/helpers.h"
+#include "output.h"
 
 #if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
 #   include "../utilities/shell.h"
@@ -64,6 +65,13 @@ typedef struct Symbol {
     struct _Function* param_of;
 } Symbol;
 
+// A number of the compiled code that can hold either an integer or a float until run time
+typedef struct KaosNumber {
+    long long i;
+    long double f;
+    bool is_float;
+} KaosNumber;
+
 Symbol* symbol_cursor;
 
 typedef struct symbol_array {
@@ -85,6 +93,8 @@ Symbol* variable_complex_element;
 unsigned long long variable_complex_element_symbol_id;
 
 Symbol* addSymbol(char *name, enum Type type, union Value value, enum ValueType value_type);
+void linkSymbolToScope(Symbol* symbol);
+Symbol* addSymbolToScope(struct FunctionCall* scope, enum Type type, union Value value, enum ValueType value_type);
 Symbol* updateSymbol(char *name, enum Type type, union Value value, enum ValueType value_type);
 void removeSymbolByName(char *name);
 void removeSymbol(Symbol* symbol);
@@ -102,12 +112,16 @@ bool getSymbolValueBool(char *name);
 bool _getSymbolValueBool(Symbol* symbol);
 long long getSymbolValueInt(char *name);
 long long _getSymbolValueInt(Symbol* symbol);
+KaosNumber getSymbolValueNumber(char *name);
+KaosNumber _getSymbolValueNumber(Symbol* symbol);
 char* getSymbolValueString_NullIfNotString(Symbol* symbol);
 long long getSymbolValueInt_ZeroIfNotInt(Symbol* symbol);
 void printSymbolValue(Symbol* symbol, bool is_complex, bool pretty, bool escaped, unsigned long iter);
 void printSymbolValueEndWith(Symbol* symbol, char *end, bool pretty, bool escaped);
 void printSymbolValueEndWithNewLine(Symbol* symbol, bool pretty, bool escaped);
+void printNumber(KaosNumber number, char *end);
 char* encodeSymbolValueToString(Symbol* symbol, bool is_complex, bool pretty, bool escaped, unsigned long iter, char *encoded, bool double_quotes);
+void encodeSymbolValue(Symbol* symbol, bool is_complex, bool pretty, bool escaped, unsigned long iter, string_builder* sb, bool double_quotes);
 bool isDefined(char *name);
 void addSymbolToComplex(Symbol* symbol);
 void printSymbolTable();
@@ -117,13 +131,18 @@ Symbol* addSymbolInt(char *name, long long i);
 void updateSymbolInt(char *name, long long i);
 Symbol* addSymbolFloat(char *name, long double f);
 void updateSymbolFloat(char *name, long double f);
+Symbol* addSymbolNumber(char *name, KaosNumber number);
 Symbol* addSymbolString(char *name, char *s);
 void updateSymbolString(char *name, char *s);
 void addSymbolList(char *name);
+Symbol* addSymbolListWithCapacity(char *name, unsigned long capacity);
+Symbol* appendComplexChild(Symbol* complex, enum Type type, union Value value, enum ValueType value_type);
 Symbol* createCloneFromSymbolByName(char *clone_name, enum Type type, char *name, enum Type extra_type);
 Symbol* createCloneFromComplexElement(char *clone_name, enum Type type, char *name, enum Type extra_type);
 Symbol* createCloneFromSymbol(char *clone_name, enum Type type, Symbol* symbol, enum Type extra_type);
 Symbol* updateSymbolByClonning(char *clone_name, Symbol* symbol);
+Symbol* createSymbolByMoving(char *name, enum Type type, Symbol* symbol, enum Type extra_type);
+Symbol* updateSymbolByMoving(char *name, Symbol* symbol);
 Symbol* updateSymbolByClonningName(char *clone_name, char *name);
 Symbol* updateSymbolByClonningComplexElement(char *clone_name, char *name);
 enum Type isComplexIllegal(enum Type type);
@@ -32,8 +32,9 @@
 
 extern bool inject_mode;
 
-void injectCode(char *code, enum Phase phase_arg);
-void switchBuffer(char *code, enum Phase phase_arg);
+// The code is scanned in place, so it has to end with two NUL characters like the code of a source_file
+void injectCode(char *code, size_t length, enum Phase phase_arg);
+void switchBuffer(char *code, size_t length, enum Phase phase_arg);
 
 #ifndef CHAOS_COMPILER
 void yyrestart_interactive();
@@ -3,10 +3,10 @@ setlocal EnableDelayedExpansion
 
 IF [%1]==[] (
     SET compiler=gcc
-    SET extra_flags=-D__USE_MINGW_ANSI_STDIO -Werror -Wall -pedantic -Wl,--stack,4294967296
+    SET extra_flags=-D__USE_MINGW_ANSI_STDIO -Werror -Wall -pedantic
 ) ELSE IF [%1]==[dev] (
     SET compiler=gcc
-    SET extra_flags=-D__USE_MINGW_ANSI_STDIO -Werror -Wall -pedantic -Wl,--stack,4294967296 -ggdb
+    SET extra_flags=-D__USE_MINGW_ANSI_STDIO -Werror -Wall -pedantic -ggdb
 ) ELSE IF [%1]==[clang] (
     SET compiler=clang
 ) ELSE IF [%1]==[clang-dev] (
@@ -40,6 +40,16 @@ static struct option long_options[] =
     {"extra", required_argument, NULL, 'e'},
     {"keep", no_argument, NULL, 'k'},
     {"unsafe", no_argument, NULL, 'u'},
+    {"profile", no_argument, NULL, 'p'},
+    {"stats", optional_argument, NULL, 's'},
+    {"unbuffered", no_argument, NULL, 'U'},
+    {"no-cache", no_argument, NULL, 'C'},
+    {"optimize", required_argument, NULL, 'O'},
+    {"lto", no_argument, NULL, 'L'},
+    {"pgo", optional_argument, NULL, 'P'},
+    {"jobs", required_argument, NULL, 'j'},
+    {"instrument", no_argument, NULL, 'I'},
+    {"dump-optimized-ast", no_argument, NULL, 'A'},
     {NULL, 0, NULL, 0}
 };
 
@@ -51,10 +61,19 @@ int initParser(int argc, char** argv) {
     char *bin_file = NULL;
     bool keep = false;
     bool unsafe = false;
+    bool profile = false;
+    bool unbuffered = false;
     char *extra_flags = NULL;
+    unsigned short optimization_level = __KAOS_DEFAULT_OPTIMIZATION_LEVEL__;
+    bool optimization_level_set = false;
+    bool lto = false;
+    char *pgo_args = NULL;
+    unsigned jobs = 0;
+    bool instrument = false;
+    char *optarg_end = NULL;
 
     char opt;
-    while ((opt = getopt_long(argc, argv, "hvldc:o:e:ku", long_options, NULL)) != -1)
+    while ((opt = getopt_long(argc, argv, "hvldc:o:e:kups::O:j:", long_options, NULL)) != -1)
     {
         switch (opt)
         {
@@ -90,6 +109,52 @@ int initParser(int argc, char** argv) {
                 unsafe = true;
                 global_unsafe = true;
                 break;
+            case 'p':
+                profile = true;
+                break;
+            case 's':
+                if (optarg == NULL || strcmp(optarg, "text") == 0) {
+                    stats_format = STATS_TEXT;
+                } else if (strcmp(optarg, "json") == 0) {
+                    stats_format = STATS_JSON;
+                } else {
+                    print_help();
+                    exit(E_INVALID_OPTION);
+                }
+                break;
+            case 'U':
+                unbuffered = true;
+                break;
+            case 'C':
+                ast_cache_disabled = true;
+                break;
+            case 'O':
+                if (strlen(optarg) != 1 || optarg[0] < '0' || optarg[0] > '0' + __KAOS_MAX_OPTIMIZATION_LEVEL__) {
+                    print_help();
+                    exit(E_INVALID_OPTION);
+                }
+                optimization_level = optarg[0] - '0';
+                optimization_level_set = true;
+                break;
+            case 'L':
+                lto = true;
+                break;
+            case 'P':
+                pgo_args = optarg != NULL ? optarg : "";
+                break;
+            case 'j':
+                jobs = strtoul(optarg, &optarg_end, 10);
+                if (*optarg_end != '\0' || jobs < 1) {
+                    print_help();
+                    exit(E_INVALID_OPTION);
+                }
+                break;
+            case 'I':
+                instrument = true;
+                break;
+            case 'A':
+                dump_optimized_ast = true;
+                break;
             case '?':
                 switch (optopt)
                 {
@@ -111,7 +176,7 @@ int initParser(int argc, char** argv) {
         }
     }
 
-    if (bin_file != NULL && !compiler_mode)
+    if ((bin_file != NULL || optimization_level_set || lto || pgo_args != NULL || jobs > 0 || instrument) && !compiler_mode)
         throwMissingCompileOption();
 
     if (fp == NULL) {
@@ -129,6 +194,12 @@ int initParser(int argc, char** argv) {
 
     is_interactive = (fp != stdin) ? false : true;
 
+    if (is_interactive || debug_enabled)
+        ast_cache_disabled = true;
+
+    if (!is_interactive || unbuffered)
+        initOutput(unbuffered);
+
     if (!is_interactive) {
         program_file_path = malloc(strlen(program_file) + 1);
         strcpy(program_file_path, program_file);
@@ -174,16 +245,16 @@ int initParser(int argc, char** argv) {
         greet();
         phase = INIT_PROGRAM;
     } else {
-        program_code = fileGetContents(program_file_path);
-        size_t program_length = strlen(program_code);
-        program_code = (char*)realloc(program_code, program_length + 2);
-        program_code[program_length] = '\n';
-        program_code[program_length + 1] = '\0';
-        switchBuffer(program_code, INIT_PROGRAM);
+        openSourceFile(&program_source, program_file_path);
+        program_code = program_source.code;
+        switchBuffer(program_code, program_source.length, INIT_PROGRAM);
     }
 
     initMainFunction();
 
+    if (profile && !compiler_mode)
+        startProfiler();
+
     main_interpreted_module = NULL;
 
     do {
@@ -197,10 +268,21 @@ int initParser(int argc, char** argv) {
 #   endif
         main_interpreted_module = malloc(1 + strlen(module_path_stack.arr[module_path_stack.size - 1]));
         strcpy(main_interpreted_module, module_path_stack.arr[module_path_stack.size - 1]);
-        yyparse();
+        unsigned long long parse_start = profileClock();
+        if (!loadASTCache(program_code, program_source.length)) {
+            startASTCacheRecording();
+            yyparse();
+            saveASTCache(program_code, program_source.length);
+        }
+        kaos_stats.parse_time += profileClock() - parse_start;
         if (!is_interactive) {
-            if (compiler_mode) {
-                compile(main_interpreted_module, INIT_PREPARSE, bin_file, extra_flags, keep, unsafe);
+            optimizeAST(main_interpreted_module);
+            if (dump_optimized_ast) {
+                // Registering the functions parses and optimizes the imported modules too
+                interpret(main_interpreted_module, PREPARSE, false, true);
+                dumpAST(ast_root_node);
+            } else if (compiler_mode) {
+                compile(main_interpreted_module, INIT_PREPARSE, bin_file, extra_flags, keep, unsafe, optimization_level, lto, pgo_args, jobs, instrument);
             } else {
                 interpret(main_interpreted_module, INIT_PREPARSE, false, unsafe);
             }
@@ -215,6 +297,18 @@ int initParser(int argc, char** argv) {
 #endif
 
 void freeEverything() {
+    flushOutput();
+
+#ifndef CHAOS_COMPILER
+    if (profile_enabled)
+        reportProfile();
+    if (stats_format != STATS_DISABLED)
+        reportStats();
+#else
+    if (profile_enabled)
+        reportInstrumentation();
+#endif
+
     freeAllSymbols();
     free(scopeless->function);
     free(scopeless);
@@ -226,18 +320,24 @@ void freeEverything() {
     if (strlen(decision_buffer) > 0) free(decision_buffer);
     freeModulePathStack();
     freeModuleStack();
+#ifndef CHAOS_COMPILER
+    freeParsedModules();
+    freeASTCache();
+#endif
     freeComplexModeStack();
     freeLeftRightBracketStack();
     freeFreeStringStack();
     freeNestedComplexModeStack();
+    freeJsonParser();
     free(function_call_stack.arr);
+    freeEvalStack();
     free(program_file_path);
 
 #ifndef CHAOS_COMPILER
     yylex_destroy();
 
     if (!is_interactive) {
-        free(program_code);
+        closeSourceFile(&program_source);
         if (fp_opened)
             fclose(fp);
         free(program_file_dir);
@@ -260,6 +360,7 @@ void freeEverything() {
 #endif
 }
 
+#ifndef CHAOS_COMPILER
 void yyerror(const char* s) {
     if (phase == PREPARSE) return;
 
@@ -267,7 +368,6 @@ void yyerror(const char* s) {
     yyerror_msg(error_name, getCurrentModule(), yytext);
     free(error_name);
 
-#ifndef CHAOS_COMPILER
     if (is_interactive) {
         loop_mode = NULL;
         function_mode = NULL;
@@ -284,15 +384,11 @@ void yyerror(const char* s) {
         initMainContext();
         yyparse();
     } else {
-#endif
         freeEverything();
         exit(E_SYNTAX_ERROR);
-#ifndef CHAOS_COMPILER
     }
-#endif
 }
 
-#ifndef CHAOS_COMPILER
 void absorbError() {
     ast_interactive_cursor = ast_node_cursor;
 
@@ -332,6 +428,7 @@ void absorbError() {
         }
         free(function_call);
     }
+    freeEvalStack();
 
     if (main_interpreted_module != NULL) {
         free(main_interpreted_module);
@@ -33,9 +33,12 @@
 #endif
 
 #include "../interpreter/loop.h"
+#include "../interpreter/json.h"
 
 #ifndef CHAOS_COMPILER
 #include "../compiler/compiler.h"
+#include "../ast/cache.h"
+#include "../ast/optimizer.h"
 #endif
 
 extern int yyparse();
@@ -53,6 +56,7 @@ FILE* tmp_stdin;
 char *program_file_path;
 char *program_file_dir;
 char *program_code;
+source_file program_source;
 char *main_interpreted_module;
 jmp_buf InteractiveShellErrorAbsorber;
 
@@ -60,9 +64,9 @@ bool global_unsafe;
 
 int initParser(int argc, char** argv);
 void freeEverything();
-void yyerror(const char* s);
 
 #ifndef CHAOS_COMPILER
+void yyerror(const char* s);
 void absorbError();
 void throwCompilerInteractiveError();
 void throwMissingOutputName();
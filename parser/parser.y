@@ -57,7 +57,7 @@ extern bool is_complex_parsing;
     ASTNode* ast_node_type;
 }
 
-%token START_PROGRAM START_PREPARSE START_JSON_PARSE
+%token START_PROGRAM START_PREPARSE
 %token<bval> T_TRUE T_FALSE
 %token<ival> T_INT T_TIMES_DO_INT
 %token<fval> T_FLOAT
@@ -112,7 +112,6 @@ extern bool is_complex_parsing;
 
 meta_start:
     | START_PROGRAM parser                                                                                              { }
-    | START_JSON_PARSE json_parser                                                                                      { }
 ;
 
 function:
@@ -946,10 +945,6 @@ quit:
     | T_VAR T_NEWLINE                                                                                                   { char *strings[] = {$1};             ASTNode* ast_node = addASTNode(AST_EXIT_VAR, yylineno, strings, 1);                                                       ASTNodeNext(ast_node); }
 ;
 
-json_parser:
-    | json_parser dictionarystart                                                                                       {                                     ASTNode* ast_node = addASTNodeAssign(AST_JSON_PARSER, yylineno, NULL, 0, $2);                                             ASTNodeNext(ast_node);        is_complex_parsing = false; }
-;
-
 %%
 
 #ifndef CHAOS_COMPILER
@@ -32,6 +32,7 @@ Symbol* preemptive_addSymbol(char *name, enum Type type, enum ValueType value_ty
 
     Symbol* symbol;
     symbol = (struct Symbol*)calloc(1, sizeof(Symbol));
+    kaos_stats.symbols_created++;
 
     if (name != NULL) {
         symbol->name = malloc(1 + strlen(name));
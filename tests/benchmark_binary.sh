@@ -0,0 +1,21 @@
+#!/bin/bash
+# Reports the size and the startup time of a compiled hello world program
+# Usage: ./tests/benchmark_binary.sh [path to chaos] [number of runs]
+
+CHAOS=${1:-chaos}
+RUNS=${2:-1000}
+DIR=$(mktemp -d)
+
+echo "print 'hello world'" > "$DIR/hello.kaos"
+(cd "$DIR" && "$CHAOS" -c hello.kaos -o hello > /dev/null) || exit 1
+BIN=$DIR/build/hello
+
+echo "Binary size: $(wc -c < "$BIN") bytes"
+size "$BIN"
+echo "Dynamic dependencies:"
+ldd "$BIN" 2>/dev/null | awk '{print "    " $1}'
+
+echo "Running the binary ${RUNS} times"
+time (for ((i = 0; i < RUNS; i++)); do "$BIN" > /dev/null; done)
+
+rm -rf "$DIR"
@@ -0,0 +1,25 @@
+#!/bin/bash
+# Times kaos.parseJson on generated JSON documents of 1MB, 10MB and 100MB
+# Usage: ./tests/extensions/benchmark_json.sh [path to chaos]
+
+CHAOS=${1:-chaos}
+DIR=$(dirname "$0")
+JSON=$DIR/benchmark.json
+
+for size in 1 10 100; do
+    awk -v size=$((size * 1024 * 1024)) 'BEGIN {
+        printf "{\"items\": ["
+        length_ = 11
+        for (i = 0; length_ < size; i++) {
+            item = sprintf("%s{\"id\": %d, \"name\": \"item %d\", \"price\": %d.25, \"active\": %s, \"tags\": [\"a\", \"b\", \"c\"]}", i > 0 ? ", " : "", i, i, i % 1000, i % 2 ? "true" : "false")
+            printf "%s", item
+            length_ += length(item)
+        }
+        printf "]}\n"
+    }' > "$JSON"
+
+    echo "Parsing a JSON document of ${size}MB"
+    time "$CHAOS" "$DIR/benchmark_json.kaos" || exit 1
+done
+
+rm -f "$JSON"
@@ -1,3 +1,4 @@
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -35,6 +36,24 @@ int KAOS_EXPORT Kaos_add()
     return 0;
 }
 
+char *add_native_params_name[] = {
+    "x",
+    "y"
+};
+unsigned add_native_params_type[] = {
+    K_NUMBER,
+    K_NUMBER
+};
+unsigned short add_native_params_length = (unsigned short) sizeof(add_native_params_type) / sizeof(unsigned);
+KaosValue KAOS_EXPORT Kaos_add_native(KaosValue args[], unsigned short args_length)
+{
+    KaosValue result;
+    result.f = 0;
+    for (unsigned short i = 0; i < args_length; i++)
+        result.f += args[i].f;
+    return result;
+}
+
 char *log_params_name[] = {
     "message"
 };
@@ -130,6 +149,100 @@ int KAOS_EXPORT Kaos_optional_test()
     return 0;
 }
 
+char *sum_params_name[] = {
+    "numbers"
+};
+unsigned sum_params_type[] = {
+    K_LIST
+};
+unsigned sum_params_secondary_type[] = {
+    K_NUMBER
+};
+unsigned short sum_params_length = (unsigned short) sizeof(sum_params_type) / sizeof(unsigned);
+int KAOS_EXPORT Kaos_sum()
+{
+    KaosHandle numbers = kaos.getParameterHandle(0);
+    unsigned long length = kaos.getHandleLength(numbers);
+    long double sum = 0;
+    for (unsigned long i = 0; i < length; i++) {
+        sum += kaos.getHandleFloat(kaos.getListElementHandle(numbers, i));
+    }
+    kaos.returnVariableFloat(sum);
+    return 0;
+}
+
+char *parse_json_params_name[] = {
+    "json"
+};
+unsigned parse_json_params_type[] = {
+    K_STRING
+};
+unsigned parse_json_params_secondary_type[] = {
+    K_ANY
+};
+unsigned short parse_json_params_length = (unsigned short) sizeof(parse_json_params_type) / sizeof(unsigned);
+int KAOS_EXPORT Kaos_parse_json()
+{
+    char* json = kaos.getVariableString(parse_json_params_name[0]);
+    kaos.parseJson(json);
+    free(json);
+    return 0;
+}
+
+char *parse_json_file_params_name[] = {
+    "path"
+};
+unsigned parse_json_file_params_type[] = {
+    K_STRING
+};
+unsigned parse_json_file_params_secondary_type[] = {
+    K_ANY
+};
+unsigned short parse_json_file_params_length = (unsigned short) sizeof(parse_json_file_params_type) / sizeof(unsigned);
+int KAOS_EXPORT Kaos_parse_json_file()
+{
+    char* path = kaos.getVariableString(parse_json_file_params_name[0]);
+    FILE *fp = fopen(path, "rb");
+    free(path);
+    if (fp == NULL) {
+        kaos.raiseError("Unable to open the JSON file");
+        return 0;
+    }
+    fseek(fp, 0, SEEK_END);
+    long length = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char *json = malloc(length + 1);
+    json[fread(json, 1, length, fp)] = '\0';
+    fclose(fp);
+    kaos.parseJson(json);
+    free(json);
+    return 0;
+}
+
+char *doubled_params_name[] = {
+    "numbers"
+};
+unsigned doubled_params_type[] = {
+    K_LIST
+};
+unsigned doubled_params_secondary_type[] = {
+    K_NUMBER
+};
+unsigned short doubled_params_length = (unsigned short) sizeof(doubled_params_type) / sizeof(unsigned);
+int KAOS_EXPORT Kaos_doubled()
+{
+    KaosHandle numbers = kaos.getParameterHandle(0);
+    unsigned long length = kaos.getHandleLength(numbers);
+    long long *buffer = malloc(length * sizeof(long long));
+    length = kaos.copyListToIntBuffer(numbers, buffer, length);
+    for (unsigned long i = 0; i < length; i++) {
+        buffer[i] *= 2;
+    }
+    kaos.returnListFromIntBuffer(buffer, length, K_NUMBER);
+    free(buffer);
+    return 0;
+}
+
 int KAOS_EXPORT KaosRegister(struct Kaos _kaos)
 {
     kaos = _kaos;
@@ -139,6 +252,11 @@ int KAOS_EXPORT KaosRegister(struct Kaos _kaos)
     kaos.defineFunction("complex", K_VOID, K_ANY, complex_params_name, complex_params_type, complex_params_secondary_type, complex_params_length, NULL, 0);
     kaos.defineFunction("array", K_LIST, K_ANY, array_params_name, array_params_type, array_params_secondary_type, array_params_length, NULL, 0);
     kaos.defineFunction("dictionary", K_DICT, K_ANY, dictionary_params_name, dictionary_params_type, dictionary_params_secondary_type, dictionary_params_length, NULL, 0);
+    kaos.defineFunction("sum", K_NUMBER, K_ANY, sum_params_name, sum_params_type, sum_params_secondary_type, sum_params_length, NULL, 0);
+    kaos.defineFunction("parse_json", K_DICT, K_ANY, parse_json_params_name, parse_json_params_type, parse_json_params_secondary_type, parse_json_params_length, NULL, 0);
+    kaos.defineFunction("parse_json_file", K_DICT, K_ANY, parse_json_file_params_name, parse_json_file_params_type, parse_json_file_params_secondary_type, parse_json_file_params_length, NULL, 0);
+    kaos.defineFunction("doubled", K_LIST, K_NUMBER, doubled_params_name, doubled_params_type, doubled_params_secondary_type, doubled_params_length, NULL, 0);
+    kaos.defineNativeFunction("add_native", K_NUMBER, add_native_params_name, add_native_params_type, add_native_params_length);
 
 
     // Functions with optional parameters
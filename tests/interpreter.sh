@@ -77,6 +77,29 @@ for filepath in $(find $DIR -maxdepth 1 -name '*.kaos'); do
     cd ..
 done
 
+# The second run of each program is built from the AST cache the first run has written
+cache_dir=$(mktemp -d)
+
+for filepath in $(find $DIR -maxdepth 1 -name '*.kaos'); do
+    filename=$(basename $filepath)
+    testname="${filename%.*}"
+
+    echo "(interpreter) Cached test: ${testname}"
+
+    first=$(CHAOS_CACHE_DIR=$cache_dir chaos tests/$filename 2>&1)
+    second=$(CHAOS_CACHE_DIR=$cache_dir chaos tests/$filename 2>&1)
+    if [ "$first" == "$second" ]
+    then
+        echo "OK"
+    else
+        diff <(echo "$first") <(echo "$second")
+        echo "Fail"
+        failed=true
+    fi
+done
+
+rm -rf $cache_dir
+
 if [ "$SHELL" = true ] ; then
     $DIR/shell/interpreter.sh
 fi
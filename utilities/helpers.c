@@ -22,6 +22,13 @@
 
 #include "helpers.h"
 
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 char *longlong_to_string(long long value, char *result, unsigned short base) {
     if (base < 2 || base > 36) { *result = '\0'; return result; }
 
@@ -108,6 +115,90 @@ char *fileGetContents(char *file_path) {
 }
 #endif
 
+static void padSourceFile(source_file *source, size_t length) {
+    source->code[length] = '\n';
+    source->code[length + 1] = '\0';
+    source->code[length + 2] = '\0';
+    source->length = length + 1;
+}
+
+void openSourceFile(source_file *source, char *file_path) {
+    source->code = NULL;
+    source->length = 0;
+    source->size = 0;
+    source->is_mapped = false;
+
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
+    int fd = open(file_path, O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        size_t page_size = (size_t) sysconf(_SC_PAGESIZE);
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            size_t length = (size_t) st.st_size;
+            // The bytes past the end of the file up to the page boundary are zero filled and private to this mapping
+            if (length % page_size != 0 && page_size - length % page_size >= 3) {
+                char *map = mmap(NULL, length + 3, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if (map != MAP_FAILED) {
+                    source->code = map;
+                    source->size = length + 3;
+                    source->is_mapped = true;
+                    padSourceFile(source, length);
+                    close(fd);
+                    return;
+                }
+            }
+        }
+        close(fd);
+    }
+    FILE * f = fopen(file_path, "rb");
+#else
+    FILE * f = fopen(file_path, "r");
+#endif
+
+    if (f == NULL) {
+        append_to_array_without_malloc(&free_string_stack, file_path);
+        throw_error(E_MODULE_IS_EMPTY_OR_NOT_EXISTS_ON_PATH, file_path);
+        return;
+    }
+
+    fseek(f, 0, SEEK_END);
+    long length = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (length < 0)
+        length = 0;
+
+    source->size = (size_t) length + 3;
+    source->code = malloc(source->size);
+    size_t read_length = fread(source->code, 1, (size_t) length, f);
+    if (read_length != (size_t) length && ferror(f)) {
+        fclose(f);
+        free(source->code);
+        source->code = NULL;
+        append_to_array_without_malloc(&free_string_stack, file_path);
+        throw_error(E_MODULE_IS_EMPTY_OR_NOT_EXISTS_ON_PATH, file_path);
+        return;
+    }
+    fclose(f);
+    padSourceFile(source, read_length);
+}
+
+void closeSourceFile(source_file *source) {
+    if (source->code == NULL)
+        return;
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__CYGWIN__)
+    if (source->is_mapped) {
+        munmap(source->code, source->size);
+    } else {
+        free(source->code);
+    }
+#else
+    free(source->code);
+#endif
+    source->code = NULL;
+    source->length = 0;
+    source->size = 0;
+}
+
 char *strcat_ext(char *s1, const char *s2)
 {
     size_t n = 0;
@@ -179,6 +270,110 @@ char *snprintf_concat_string(char *s1, char *format, char *s2)
     return s1;
 }
 
+void string_builder_init(string_builder *sb) {
+    sb->arr = NULL;
+    sb->capacity = 0;
+    sb->size = 0;
+    sb->stream = NULL;
+}
+
+void string_builder_init_stream(string_builder *sb, FILE *stream) {
+    string_builder_init(sb);
+    sb->stream = stream;
+}
+
+void string_builder_append_length(string_builder *sb, const char *s, size_t length) {
+    if (sb->stream != NULL) {
+        fwrite(s, 1, length, sb->stream);
+        sb->size += length;
+        return;
+    }
+
+    if (sb->size + length + 1 > sb->capacity) {
+        size_t capacity = sb->capacity == 0 ? 64 : sb->capacity;
+        while (sb->size + length + 1 > capacity)
+            capacity *= 2;
+        sb->arr = realloc(sb->arr, capacity);
+        sb->capacity = capacity;
+    }
+
+    memcpy(sb->arr + sb->size, s, length);
+    sb->size += length;
+    sb->arr[sb->size] = '\0';
+}
+
+void string_builder_append(string_builder *sb, const char *s) {
+    string_builder_append_length(sb, s, strlen(s));
+}
+
+void string_builder_append_int(string_builder *sb, long long i) {
+    char buffer[__KAOS_ITOA_BUFFER_LENGTH__];
+    char *end = buffer + sizeof(buffer);
+    char *cursor = end;
+    unsigned long long u = i < 0 ? 0ULL - (unsigned long long) i : (unsigned long long) i;
+    do {
+        *--cursor = (char) ('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (i < 0)
+        *--cursor = '-';
+    string_builder_append_length(sb, cursor, (size_t) (end - cursor));
+}
+
+// Same output as "%Lg". Integral values below 1e6 print without an exponent
+// or a fraction under %Lg, so they take the integer path.
+void string_builder_append_float(string_builder *sb, long double f) {
+    if (f > -1e6L && f < 1e6L && f == (long double) (long long) f && !(f == 0 && signbit(f))) {
+        string_builder_append_int(sb, (long long) f);
+        return;
+    }
+    char buffer[__KAOS_ITOA_BUFFER_LENGTH__];
+    int length = snprintf(buffer, sizeof(buffer), "%Lg", f);
+    string_builder_append_length(sb, buffer, (size_t) length);
+}
+
+// Appends the string with its escape sequences resolved, in one pass and
+// without the copy that escape_the_sequences_in_string_literal makes
+void string_builder_append_escaped(string_builder *sb, const char *s) {
+    const char *start = s;
+    for (; *s != '\0'; s++) {
+        if (*s != '\\')
+            continue;
+
+        char c;
+        switch (s[1])
+        {
+            case '\\': c = '\\'; break;
+            case 'a': c = '\a'; break;
+            case 'b': c = '\b'; break;
+            case 'f': c = '\f'; break;
+            case 'n': c = '\n'; break;
+            case 'r': c = '\r'; break;
+            case 't': c = '\t'; break;
+            case 'v': c = '\v'; break;
+            case '"': c = '"'; break;
+            case '\'': c = '\''; break;
+            default: continue;
+        }
+        string_builder_append_length(sb, start, (size_t) (s - start));
+        string_builder_append_length(sb, &c, 1);
+        s++;
+        start = s + 1;
+    }
+    string_builder_append_length(sb, start, (size_t) (s - start));
+}
+
+// Hands over the collected string, an empty builder still gives an allocated empty string
+char *string_builder_finish(string_builder *sb) {
+    if (sb->arr == NULL) {
+        sb->arr = malloc(1);
+        sb->arr[0] = '\0';
+    }
+    char *s = sb->arr;
+    string_builder_init(sb);
+    return s;
+}
+
 void prepend_to_array(string_array *array, char *str) {
     array->arr = (char **)realloc(array->arr, (array->capacity += 1) * sizeof(char *));
 
@@ -28,7 +28,10 @@
 
 #define __KAOS_ITOA_BUFFER_LENGTH__ 64
 
+#include <stdio.h>
+#include <stdbool.h>
 #include <ctype.h>
+#include <math.h>
 #include <string.h>
 #include <assert.h>
 
@@ -37,6 +40,23 @@ typedef struct string_array {
     unsigned capacity, size;
 } string_array;
 
+// Growable string with length tracking. A builder that is given a stream
+// writes the appended text straight to it instead of collecting it.
+typedef struct string_builder {
+    char *arr;
+    size_t capacity, size;
+    FILE *stream;
+} string_builder;
+
+// Content of a program or module file followed by a newline and the two NUL
+// characters that let flex scan it in place. Mapped into memory when the
+// padding fits into the last page of the file, read into a buffer otherwise.
+typedef struct source_file {
+    char *code;
+    size_t length, size;
+    bool is_mapped;
+} source_file;
+
 string_array free_string_stack;
 
 #include "../interpreter/function.h"
@@ -44,10 +64,20 @@ string_array free_string_stack;
 char *longlong_to_string(long long value, char *result, unsigned short base);
 char *trim_string(char *str);
 char *fileGetContents(char *file_path);
+void openSourceFile(source_file *source, char *file_path);
+void closeSourceFile(source_file *source);
 char *strcat_ext(char *s1, const char *s2);
 char *snprintf_concat_int(char *s1, char *format, long long i);
 char *snprintf_concat_float(char *s1, char *format, long double f);
 char *snprintf_concat_string(char *s1, char *format, char *s2);
+void string_builder_init(string_builder *sb);
+void string_builder_init_stream(string_builder *sb, FILE *stream);
+void string_builder_append_length(string_builder *sb, const char *s, size_t length);
+void string_builder_append(string_builder *sb, const char *s);
+void string_builder_append_int(string_builder *sb, long long i);
+void string_builder_append_float(string_builder *sb, long double f);
+void string_builder_append_escaped(string_builder *sb, const char *s);
+char *string_builder_finish(string_builder *sb);
 void prepend_to_array(string_array *array, char *str);
 void append_to_array(string_array *array, char *str);
 void append_to_array_without_malloc(string_array *array, char *str);
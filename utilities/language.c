@@ -23,6 +23,7 @@
 #include "language.h"
 #include "helpers.h"
 
+#ifndef CHAOS_COMPILER
 extern int yylineno;
 extern FILE* tmp_stdin;
 
@@ -37,25 +38,19 @@ void yyerror_msg(char* error_name, char* current_module, char* cause) {
     char* info_msg = str_replace(info, "\n", "\\n");
 
     FILE* fp_module = NULL;
-#ifndef CHAOS_COMPILER
     if (is_interactive) {
         fseek(tmp_stdin, 0, SEEK_SET);
         fp_module = tmp_stdin;
     } else {
-#endif
         fp_module = fopen(current_module, "r");
-#ifndef CHAOS_COMPILER
     }
-#endif
     char *line = NULL;
     if (fp_module == NULL) {
         line = malloc(4);
         strcpy(line, "???");
     } else {
         line = get_nth_line(fp_module, yylineno);
-#ifndef CHAOS_COMPILER
         if (fp_module != tmp_stdin)
-#endif
             fclose(fp_module);
         if (line == NULL) {
             line = malloc(4);
@@ -107,3 +102,4 @@ void yyerror_msg(char* error_name, char* current_module, char* cause) {
     fprintf(stderr, "\n");
     fflush(stderr);
 }
+#endif
@@ -71,6 +71,8 @@
 
 #include "platform.h"
 
+#ifndef CHAOS_COMPILER
 void yyerror_msg(char* error_name, char* current_module, char* cause);
+#endif
 
 #endif
@@ -266,16 +266,116 @@ unsigned char help_txt[] = {
     0x6f, 0x72, 0x61, 0x72, 0x79, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x73, 0x29,
     0x20, 0x61, 0x66, 0x74, 0x65, 0x72, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x69,
     0x6c, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x0a, 0x20, 0x20, 0x20, 0x20,
-    0x2d, 0x75, 0x2c, 0x20, 0x2d, 0x2d, 0x75, 0x6e, 0x73, 0x61, 0x66, 0x65,
-    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x55, 0x6e, 0x73, 0x61,
-    0x66, 0x65, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x20, 0x28, 0x66, 0x61, 0x73,
-    0x74, 0x20, 0x77, 0x61, 0x72, 0x6d, 0x20, 0x75, 0x70, 0x29, 0x2e, 0x20,
-    0x44, 0x69, 0x73, 0x61, 0x62, 0x6c, 0x65, 0x73, 0x20, 0x74, 0x68, 0x65,
-    0x20, 0x70, 0x72, 0x65, 0x65, 0x6d, 0x70, 0x74, 0x69, 0x76, 0x65, 0x20,
-    0x65, 0x72, 0x72, 0x6f, 0x72, 0x20, 0x63, 0x68, 0x65, 0x63, 0x6b, 0x73,
-    0x2e, 0x0a, 0x0a
+    0x2d, 0x4f, 0x2c, 0x20, 0x2d, 0x2d, 0x6f, 0x70, 0x74, 0x69, 0x6d, 0x69,
+    0x7a, 0x65, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x4f, 0x70, 0x74, 0x69,
+    0x6d, 0x69, 0x7a, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x6c, 0x65, 0x76,
+    0x65, 0x6c, 0x20, 0x28, 0x30, 0x2d, 0x33, 0x29, 0x20, 0x6f, 0x66, 0x20,
+    0x74, 0x68, 0x65, 0x20, 0x43, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x69, 0x6c,
+    0x65, 0x72, 0x20, 0x77, 0x68, 0x69, 0x6c, 0x65, 0x20, 0x63, 0x6f, 0x6d,
+    0x70, 0x69, 0x6c, 0x69, 0x6e, 0x67, 0x2e, 0x20, 0x44, 0x65, 0x66, 0x61,
+    0x75, 0x6c, 0x74, 0x73, 0x20, 0x74, 0x6f, 0x20, 0x32, 0x2e, 0x0a, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2d, 0x2d, 0x6c, 0x74, 0x6f,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x43,
+    0x6f, 0x6d, 0x70, 0x69, 0x6c, 0x65, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20,
+    0x6c, 0x69, 0x6e, 0x6b, 0x2d, 0x74, 0x69, 0x6d, 0x65, 0x20, 0x6f, 0x70,
+    0x74, 0x69, 0x6d, 0x69, 0x7a, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20,
+    0x74, 0x6f, 0x67, 0x65, 0x74, 0x68, 0x65, 0x72, 0x20, 0x77, 0x69, 0x74,
+    0x68, 0x20, 0x74, 0x68, 0x65, 0x20, 0x72, 0x75, 0x6e, 0x74, 0x69, 0x6d,
+    0x65, 0x2e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2d,
+    0x2d, 0x70, 0x67, 0x6f, 0x5b, 0x3d, 0x41, 0x52, 0x47, 0x53, 0x5d, 0x20,
+    0x20, 0x20, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x69, 0x6c, 0x65, 0x20, 0x77,
+    0x69, 0x74, 0x68, 0x20, 0x70, 0x72, 0x6f, 0x66, 0x69, 0x6c, 0x65, 0x2d,
+    0x67, 0x75, 0x69, 0x64, 0x65, 0x64, 0x20, 0x6f, 0x70, 0x74, 0x69, 0x6d,
+    0x69, 0x7a, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2c, 0x20, 0x74, 0x72, 0x61,
+    0x69, 0x6e, 0x69, 0x6e, 0x67, 0x20, 0x6f, 0x6e, 0x20, 0x61, 0x20, 0x72,
+    0x75, 0x6e, 0x20, 0x77, 0x69, 0x74, 0x68, 0x20, 0x74, 0x68, 0x65, 0x20,
+    0x41, 0x52, 0x47, 0x53, 0x2e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2d, 0x6a,
+    0x2c, 0x20, 0x2d, 0x2d, 0x6a, 0x6f, 0x62, 0x73, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x4e, 0x75, 0x6d, 0x62, 0x65, 0x72,
+    0x20, 0x6f, 0x66, 0x20, 0x43, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x69, 0x6c,
+    0x65, 0x72, 0x20, 0x70, 0x72, 0x6f, 0x63, 0x65, 0x73, 0x73, 0x65, 0x73,
+    0x20, 0x74, 0x6f, 0x20, 0x72, 0x75, 0x6e, 0x20, 0x69, 0x6e, 0x20, 0x70,
+    0x61, 0x72, 0x61, 0x6c, 0x6c, 0x65, 0x6c, 0x20, 0x77, 0x68, 0x69, 0x6c,
+    0x65, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x69, 0x6c, 0x69, 0x6e, 0x67, 0x2e,
+    0x20, 0x44, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x73, 0x20, 0x74, 0x6f,
+    0x20, 0x74, 0x68, 0x65, 0x20, 0x6e, 0x75, 0x6d, 0x62, 0x65, 0x72, 0x20,
+    0x6f, 0x66, 0x20, 0x70, 0x72, 0x6f, 0x63, 0x65, 0x73, 0x73, 0x6f, 0x72,
+    0x73, 0x2e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2d,
+    0x2d, 0x69, 0x6e, 0x73, 0x74, 0x72, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x20,
+    0x20, 0x20, 0x20, 0x43, 0x6f, 0x6d, 0x70, 0x69, 0x6c, 0x65, 0x20, 0x77,
+    0x69, 0x74, 0x68, 0x20, 0x65, 0x6e, 0x74, 0x72, 0x79, 0x20, 0x61, 0x6e,
+    0x64, 0x20, 0x65, 0x78, 0x69, 0x74, 0x20, 0x68, 0x6f, 0x6f, 0x6b, 0x73,
+    0x20, 0x6f, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x20, 0x66, 0x75, 0x6e, 0x63,
+    0x74, 0x69, 0x6f, 0x6e, 0x73, 0x2e, 0x20, 0x54, 0x68, 0x65, 0x20, 0x62,
+    0x69, 0x6e, 0x61, 0x72, 0x79, 0x20, 0x70, 0x72, 0x69, 0x6e, 0x74, 0x73,
+    0x20, 0x70, 0x65, 0x72, 0x2d, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+    0x6e, 0x20, 0x63, 0x61, 0x6c, 0x6c, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x63,
+    0x79, 0x63, 0x6c, 0x65, 0x20, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x73, 0x20,
+    0x61, 0x74, 0x20, 0x65, 0x78, 0x69, 0x74, 0x20, 0x6f, 0x72, 0x20, 0x6f,
+    0x6e, 0x20, 0x53, 0x49, 0x47, 0x55, 0x53, 0x52, 0x31, 0x2c, 0x20, 0x61,
+    0x6e, 0x64, 0x20, 0x77, 0x72, 0x69, 0x74, 0x65, 0x73, 0x20, 0x66, 0x6f,
+    0x6c, 0x64, 0x65, 0x64, 0x20, 0x73, 0x74, 0x61, 0x63, 0x6b, 0x73, 0x20,
+    0x74, 0x6f, 0x20, 0x63, 0x68, 0x61, 0x6f, 0x73, 0x2d, 0x70, 0x72, 0x6f,
+    0x66, 0x69, 0x6c, 0x65, 0x2e, 0x66, 0x6f, 0x6c, 0x64, 0x65, 0x64, 0x2e,
+    0x0a, 0x20, 0x20, 0x20, 0x20, 0x2d, 0x75, 0x2c, 0x20, 0x2d, 0x2d, 0x75,
+    0x6e, 0x73, 0x61, 0x66, 0x65, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x55, 0x6e, 0x73, 0x61, 0x66, 0x65, 0x20, 0x6d, 0x6f, 0x64, 0x65,
+    0x20, 0x28, 0x66, 0x61, 0x73, 0x74, 0x20, 0x77, 0x61, 0x72, 0x6d, 0x20,
+    0x75, 0x70, 0x29, 0x2e, 0x20, 0x44, 0x69, 0x73, 0x61, 0x62, 0x6c, 0x65,
+    0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x70, 0x72, 0x65, 0x65, 0x6d, 0x70,
+    0x74, 0x69, 0x76, 0x65, 0x20, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x20, 0x63,
+    0x68, 0x65, 0x63, 0x6b, 0x73, 0x2e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x2d,
+    0x70, 0x2c, 0x20, 0x2d, 0x2d, 0x70, 0x72, 0x6f, 0x66, 0x69, 0x6c, 0x65,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x50, 0x72, 0x6f, 0x66, 0x69,
+    0x6c, 0x65, 0x20, 0x74, 0x68, 0x65, 0x20, 0x65, 0x78, 0x65, 0x63, 0x75,
+    0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x20, 0x50, 0x72, 0x69, 0x6e, 0x74, 0x73,
+    0x20, 0x70, 0x65, 0x72, 0x2d, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+    0x6e, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x70, 0x65, 0x72, 0x2d, 0x6c, 0x69,
+    0x6e, 0x65, 0x20, 0x74, 0x69, 0x6d, 0x69, 0x6e, 0x67, 0x73, 0x20, 0x61,
+    0x6e, 0x64, 0x20, 0x77, 0x72, 0x69, 0x74, 0x65, 0x73, 0x20, 0x66, 0x6f,
+    0x6c, 0x64, 0x65, 0x64, 0x20, 0x73, 0x74, 0x61, 0x63, 0x6b, 0x73, 0x20,
+    0x74, 0x6f, 0x20, 0x63, 0x68, 0x61, 0x6f, 0x73, 0x2d, 0x70, 0x72, 0x6f,
+    0x66, 0x69, 0x6c, 0x65, 0x2e, 0x66, 0x6f, 0x6c, 0x64, 0x65, 0x64, 0x2e,
+    0x0a, 0x20, 0x20, 0x20, 0x20, 0x2d, 0x73, 0x2c, 0x20, 0x2d, 0x2d, 0x73,
+    0x74, 0x61, 0x74, 0x73, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x50, 0x72, 0x69, 0x6e, 0x74, 0x20, 0x72, 0x75, 0x6e, 0x74, 0x69,
+    0x6d, 0x65, 0x20, 0x73, 0x74, 0x61, 0x74, 0x69, 0x73, 0x74, 0x69, 0x63,
+    0x73, 0x20, 0x61, 0x74, 0x20, 0x65, 0x78, 0x69, 0x74, 0x2e, 0x20, 0x55,
+    0x73, 0x65, 0x20, 0x2d, 0x2d, 0x73, 0x74, 0x61, 0x74, 0x73, 0x3d, 0x6a,
+    0x73, 0x6f, 0x6e, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x4a, 0x53, 0x4f, 0x4e,
+    0x20, 0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x2e, 0x0a, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x2d, 0x2d, 0x75, 0x6e, 0x62, 0x75, 0x66,
+    0x66, 0x65, 0x72, 0x65, 0x64, 0x20, 0x20, 0x20, 0x20, 0x57, 0x72, 0x69,
+    0x74, 0x65, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6f, 0x75, 0x74, 0x70, 0x75,
+    0x74, 0x20, 0x6f, 0x66, 0x20, 0x70, 0x72, 0x69, 0x6e, 0x74, 0x20, 0x61,
+    0x6e, 0x64, 0x20, 0x65, 0x63, 0x68, 0x6f, 0x20, 0x69, 0x6d, 0x6d, 0x65,
+    0x64, 0x69, 0x61, 0x74, 0x65, 0x6c, 0x79, 0x20, 0x69, 0x6e, 0x73, 0x74,
+    0x65, 0x61, 0x64, 0x20, 0x6f, 0x66, 0x20, 0x62, 0x75, 0x66, 0x66, 0x65,
+    0x72, 0x69, 0x6e, 0x67, 0x20, 0x69, 0x74, 0x2e, 0x0a, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x20, 0x2d, 0x2d, 0x6e, 0x6f, 0x2d, 0x63, 0x61,
+    0x63, 0x68, 0x65, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x41, 0x6c, 0x77,
+    0x61, 0x79, 0x73, 0x20, 0x70, 0x61, 0x72, 0x73, 0x65, 0x20, 0x74, 0x68,
+    0x65, 0x20, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x20, 0x69, 0x6e, 0x73,
+    0x74, 0x65, 0x61, 0x64, 0x20, 0x6f, 0x66, 0x20, 0x72, 0x65, 0x75, 0x73,
+    0x69, 0x6e, 0x67, 0x20, 0x74, 0x68, 0x65, 0x20, 0x70, 0x72, 0x65, 0x63,
+    0x6f, 0x6d, 0x70, 0x69, 0x6c, 0x65, 0x64, 0x20, 0x41, 0x53, 0x54, 0x20,
+    0x63, 0x61, 0x63, 0x68, 0x65, 0x64, 0x20, 0x69, 0x6e, 0x20, 0x7e, 0x2f,
+    0x2e, 0x63, 0x61, 0x63, 0x68, 0x65, 0x2f, 0x63, 0x68, 0x61, 0x6f, 0x73,
+    0x2e, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2d, 0x2d,
+    0x64, 0x75, 0x6d, 0x70, 0x2d, 0x6f, 0x70, 0x74, 0x69, 0x6d, 0x69, 0x7a,
+    0x65, 0x64, 0x2d, 0x61, 0x73, 0x74, 0x20, 0x20, 0x50, 0x72, 0x69, 0x6e,
+    0x74, 0x20, 0x74, 0x68, 0x65, 0x20, 0x41, 0x53, 0x54, 0x20, 0x6f, 0x66,
+    0x20, 0x74, 0x68, 0x65, 0x20, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x61, 0x6d,
+    0x20, 0x61, 0x6e, 0x64, 0x20, 0x69, 0x74, 0x73, 0x20, 0x6d, 0x6f, 0x64,
+    0x75, 0x6c, 0x65, 0x73, 0x20, 0x61, 0x66, 0x74, 0x65, 0x72, 0x20, 0x74,
+    0x68, 0x65, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x20,
+    0x66, 0x6f, 0x6c, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x61, 0x6e, 0x64, 0x20,
+    0x74, 0x68, 0x65, 0x20, 0x64, 0x65, 0x61, 0x64, 0x20, 0x63, 0x6f, 0x64,
+    0x65, 0x20, 0x65, 0x6c, 0x69, 0x6d, 0x69, 0x6e, 0x61, 0x74, 0x69, 0x6f,
+    0x6e, 0x2c, 0x20, 0x77, 0x69, 0x74, 0x68, 0x6f, 0x75, 0x74, 0x20, 0x72,
+    0x75, 0x6e, 0x6e, 0x69, 0x6e, 0x67, 0x20, 0x69, 0x74, 0x2e, 0x0a, 0x0a
 };
-unsigned int help_txt_len = 675;
+unsigned int help_txt_len = 1884;
 
 void print_help() {
     char lang[__KAOS_MSG_LINE_LENGTH__];
@@ -290,7 +390,7 @@ void print_help() {
         __TIME__
     );
     printf("%s\n\n", lang);
-    printf("%s", help_txt);
+    fwrite(help_txt, sizeof(unsigned char), help_txt_len, stdout);
 }
 
 void print_license() {
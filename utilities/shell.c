@@ -118,6 +118,7 @@ int shell_readline(char *buf) {
 
     char *line;
 
+    flushOutput();
     if (is_interactive && (loops_inside_function_counter > 0 || is_complex_parsing)) {
         line = readline(__KAOS_SHELL_INDICATOR_BLOCK__);
     } else {